@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "tokens.h"
 
@@ -59,9 +60,10 @@ inline char char_to_num(unsigned char c)
   return char2num[c];
 }
 
-inline std::string toupper(const std::string& s)
+template <typename Traits, typename Alloc>
+std::basic_string<char, Traits, Alloc> toupper(const std::basic_string<char, Traits, Alloc>& s)
 {
-  std::string res(s.size(), 0);
+  std::basic_string<char, Traits, Alloc> res(s.size(), 0, s.get_allocator());
 
   auto source = s.data();
   auto targer = (char*)res.data();
@@ -74,7 +76,8 @@ inline std::string toupper(const std::string& s)
   return res;
 }
 
-inline bool equal(const std::string& s1, const char* s2, int length)
+template <typename Traits, typename Alloc>
+bool equal(const std::basic_string<char, Traits, Alloc>& s1, const char* s2, int length)
 {
   if (length < 0 || (int)s1.size() != length) return false;
 
@@ -86,9 +89,10 @@ inline bool equal(const std::string& s1, const char* s2, int length)
   return true;
 }
 
-inline std::vector<std::string> spilt(const char* s, char separator)
+template <typename String = std::string>
+std::vector<String> spilt(const char* s, char separator)
 {
-  std::vector<std::string> result;
+  std::vector<String> result;
 
   size_t length = std::char_traits<char>::length(s);
   size_t begin = 0, end = 0;
@@ -110,6 +114,25 @@ inline std::vector<std::string> spilt(const char* s, char separator)
   return result;
 }
 
+/*
+ * @brief: the next non empty segment of path, the segments are split by separator. path is advanced
+ * past it.
+ * @ret: an empty view when there are no more segments.
+ */
+inline std::string_view next_segment(std::string_view& path, char separator) noexcept
+{
+  while (!path.empty())
+  {
+    auto end     = path.find(separator);
+    auto segment = path.substr(0, end);
+
+    path.remove_prefix(end == std::string_view::npos ? path.size() : end + 1);
+    if (!segment.empty()) return segment;
+  }
+
+  return {};
+}
+
 template <typename T>
 void concat_to(std::string& s, const T& source)
 {
@@ -0,0 +1,114 @@
+#include <formats/common/file/mapped_file.hpp>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif  // !WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif  // !NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+FORMATS_NAMESPACE_BEGIN
+
+namespace file
+{
+#ifdef _WIN32
+
+bool mapped_file::open(const std::string& path)
+{
+  close();
+
+  HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) return false;
+
+  LARGE_INTEGER size = {};
+  if (::GetFileType(file) != FILE_TYPE_DISK || !::GetFileSizeEx(file, &size) ||
+      size.QuadPart <= 0 || (unsigned long long)size.QuadPart > (size_t)-1)
+  {
+    ::CloseHandle(file);
+    return false;
+  }
+
+  // the view keeps the mapping, the mapping keeps the file
+  HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  ::CloseHandle(file);
+  if (!mapping) return false;
+
+  const void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!view)
+  {
+    ::CloseHandle(mapping);
+    return false;
+  }
+
+  data_    = static_cast<const char*>(view);
+  size_    = (size_t)size.QuadPart;
+  mapping_ = mapping;
+  return true;
+}
+
+void mapped_file::close()
+{
+  if (!data_) return void();
+
+  ::UnmapViewOfFile(data_);
+  ::CloseHandle(mapping_);
+
+  data_    = nullptr;
+  size_    = 0;
+  mapping_ = nullptr;
+}
+
+#else
+
+bool mapped_file::open(const std::string& path)
+{
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+  {
+    ::close(fd);
+    return false;
+  }
+
+  // the mapping outlives the descriptor
+  void* addr = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) return false;
+
+#ifdef MADV_SEQUENTIAL
+  ::madvise(addr, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif  // MADV_SEQUENTIAL
+
+  data_ = static_cast<const char*>(addr);
+  size_ = (size_t)st.st_size;
+  return true;
+}
+
+void mapped_file::close()
+{
+  if (!data_) return void();
+
+  ::munmap((void*)data_, size_);
+
+  data_ = nullptr;
+  size_ = 0;
+}
+
+#endif  // _WIN32
+
+}  // namespace file
+
+FORMATS_NAMESPACE_END
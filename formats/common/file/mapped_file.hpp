@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <formats/common/marco.hpp>
+
+FORMATS_NAMESPACE_BEGIN
+
+namespace file
+{
+/*
+ * mapped_file: a regular file mapped read only into memory, with sequential access hinted to the
+ * kernel. the bytes are not followed by a NUL.
+ */
+class mapped_file
+{
+public:
+  mapped_file() = default;
+  ~mapped_file() { close(); }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  /*
+   * @brief: map the file at path, the previous mapping is released.
+   * @ret: false if the file can not be mapped: it does not exist, is not a regular file (a pipe,
+   * a character device), is empty, or the mapping fails. the caller reads it as a stream then.
+   */
+  bool open(const std::string& path);
+  void close();
+
+  bool is_open() const { return data_ != nullptr; }
+
+  const char* begin() const { return data_; }
+  const char* end() const { return data_ + size_; }
+  size_t      size() const { return size_; }
+
+private:
+  const char* data_ = nullptr;
+  size_t      size_ = 0;
+
+#ifdef _WIN32
+  void* mapping_ = nullptr;
+#endif  // _WIN32
+};
+
+}  // namespace file
+
+FORMATS_NAMESPACE_END
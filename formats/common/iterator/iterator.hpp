@@ -1,114 +1,164 @@
 ﻿#pragma once
 
+#include <iterator>
 #include <string>
+#include <type_traits>
 
-#include <formats/common/iterator/iterator_adapter.hpp>
+#include <formats/common/value/array.hpp>
+#include <formats/common/value/ordered_map.hpp>
 #include <formats/common/exception.hpp>
 #include <formats/common/cctypes.hpp>
+#include <formats/common/marco.hpp>
 
 FORMATS_NAMESPACE_BEGIN
 
+/*
+ * iterator: over the elements of an array, the values of an object, or a scaler as a range of one
+ * value. it is a plain value: the owner, its container, and an index into an array or an iterator
+ * of the ordered_map of an object. so constructing, copying and converting one allocates nothing,
+ * and ++ and * are inline, with no virtual call.
+ */
 template <typename T>
 class iterator
 {
+  template <typename>
+  friend class iterator;
+
+  using non_const_type = typename std::remove_const<T>::type;
+
+  using array_type  = typename std::conditional<std::is_const<T>::value,
+                                               const typename non_const_type::array_t,
+                                               typename non_const_type::array_t>::type;
+  using object_type = typename std::conditional<std::is_const<T>::value,
+                                                const typename non_const_type::object_t,
+                                                typename non_const_type::object_t>::type;
+
 public:
-  using value_type = typename iterator_adapter<T>::value_type;
-  using pointer    = typename iterator_adapter<T>::pointer;
-  using reference  = typename iterator_adapter<T>::reference;
-  using diff_t     = typename iterator_adapter<T>::diff_t;
+  using value_type = T;
+  using pointer    = value_type*;
+  using reference  = value_type&;
+  using diff_t     = std::ptrdiff_t;
 
   using iterator_category = std::input_iterator_tag;
 
+  using array_iterator =
+      typename std::conditional<std::is_const<T>::value,
+                                typename non_const_type::array_t::const_iterator,
+                                typename non_const_type::array_t::iterator>::type;
+  using object_iterator =
+      typename std::conditional<std::is_const<T>::value,
+                                typename non_const_type::object_t::const_iterator,
+                                typename non_const_type::object_t::iterator>::type;
+
 public:
-  iterator() { iterator_adapter_.reset(); }
+  iterator() = default;
 
   iterator(pointer v)
+      : owner_(v)
   {
-    if (v->is_object())
-      iterator_adapter_ = iterator_adapter<T>::create_object(v, v->as_object().begin());
-    else if (v->is_array())
-      iterator_adapter_ = iterator_adapter<T>::create_array(v, 0);
-    else
-      iterator_adapter_ = iterator_adapter<T>::create_scaler(v, 0);
+    if ((object_ = v->if_object()))
+    {
+      kind_ = kind::object;
+      iter_ = object_->begin();
+    }
+    else if ((array_ = v->if_array())) { kind_ = kind::array; }
+    else { kind_ = kind::scaler; }
   }
 
   iterator(pointer v, diff_t pos)
+      : owner_(v)
   {
-    if (v->is_array())
-      iterator_adapter_ = iterator_adapter<T>::create_array(v, pos);
+    if ((array_ = v->if_array()))
+    {
+      kind_ = kind::array;
+      pos_  = std::min<size_t>(std::max<size_t>(pos, 0), array_->size());
+    }
     else
-      iterator_adapter_ = iterator_adapter<T>::create_scaler(v, pos);
+    {
+      kind_ = kind::scaler;
+      pos_  = std::min<size_t>(std::max<size_t>(pos, 0), 1);
+    }
   }
 
   template <typename Iter, typename std::enable_if<!std::is_integral<Iter>::value, int>::type = 0>
   iterator(pointer v, Iter pos)
-  {
-    iterator_adapter_ = iterator_adapter<T>::create_object(v, pos);
-  }
+      : owner_(v)
+      , object_(v->if_object())
+      , iter_(pos)
+      , kind_(kind::object)
+  {}
 
-  iterator(const iterator<const T>& other)
-  {
-    iterator_adapter_ = iterator_adapter<T>::create(*other.iter_adapter().get());
-  }
+  iterator(const iterator<const T>& other) { assign(other); }
 
-  iterator(const iterator<typename std::remove_const<T>::type>& other) noexcept(false)
-  {
-    iterator_adapter_ = iterator_adapter<T>::create(*other.iter_adapter().get());
-  }
+  iterator(const iterator<non_const_type>& other) { assign(other); }
 
   iterator& operator=(const iterator<const T>& other)
   {
-    iterator_adapter_ = iterator_adapter<T>::create(*other.iter_adapter().get());
+    assign(other);
     return *this;
   }
 
-  iterator& operator=(const iterator<typename std::remove_const<T>::type>& other)
+  iterator& operator=(const iterator<non_const_type>& other)
   {
-    iterator_adapter_ = iterator_adapter<T>::create(*other.iter_adapter().get());
+    assign(other);
     return *this;
   }
 
 public:
-  pointer operator->() { return iterator_adapter_.get()->operator->(); }
+  pointer operator->() { return &operator*(); }
+
+  reference operator*()
+  {
+    switch (kind_)
+    {
+      case kind::array:
+        if (pos_ < (diff_t)array_->size()) return (*array_)[pos_];
+        FORMATS_THROW(iterator_except::create("can't dereference out of range array iterator"));
+
+      case kind::object:
+        if (iter_ != object_->end()) return iter_->second;
+        FORMATS_THROW(iterator_except::create("can't dereference out of range object iterator"));
 
-  reference operator*() { return iterator_adapter_.get()->operator*(); }
+      default: return *owner_;
+    }
+  }
 
 public:
   iterator operator++(int) &
   {
     auto result = *this;
-    iterator_adapter_->forward(1);
+    forward(1);
     return result;
   }
 
   iterator operator--(int) &
   {
     auto result = *this;
-    iterator_adapter_->backward(1);
+    backward(1);
     return result;
   }
 
   iterator& operator++()
   {
-    iterator_adapter_->forward(1);
+    forward(1);
     return *this;
   }
 
   iterator& operator--()
   {
-    iterator_adapter_->backward(1);
+    backward(1);
     return *this;
   }
 
   iterator operator+=(int n)
   {
-    iterator_adapter_->forward(n);
+    forward(n);
     return *this;
   }
 
   iterator operator-=(int n)
   {
-    iterator_adapter_->backward(n);
+    backward(n);
     return *this;
   }
 
@@ -126,56 +176,155 @@ public:
     return result;
   }
 
-  bool operator==(const iterator<const T>& other) const
-  {
-    return (iter_adapter() && other.iter_adapter())
-               ? (iterator_adapter_->equal(*other.iter_adapter().get()))
-               : (!iter_adapter() && !other.iter_adapter());
-  }
+  bool operator==(const iterator<const T>& other) const { return equal(other); }
 
-  bool operator==(const iterator<typename std::remove_const<T>::type>& other) const
-  {
-    return (iter_adapter() && other.iter_adapter())
-               ? (iterator_adapter_->equal(*other.iter_adapter().get()))
-               : (!iter_adapter() && !other.iter_adapter());
-  }
+  bool operator==(const iterator<non_const_type>& other) const { return equal(other); }
 
   bool operator!=(const iterator<T>& other) const { return !(*this == other); }
 
 public:
-  typename iterator_adapter<T>::ptr iter_adapter() noexcept { return iterator_adapter_; }
-  typename iterator_adapter<T>::ptr iter_adapter() const noexcept { return iterator_adapter_; }
+  const typename non_const_type::string_t& key() const noexcept(false)
+  {
+    if (kind_ == kind::object) return iter_->first;
+
+    FORMATS_THROW(type_except::create("can't use key() with iterator", kind_name()));
+  }
 
 public:
-  const std::string& key() const noexcept(false)
+  diff_t distance_from_begin() const noexcept
   {
-    if (iterator_adapter_->is_object())
+    return kind_ == kind::object ? std::distance(object_->begin(), iter_) : pos_;
+  }
+
+  array_iterator array_iter() const noexcept(false)
+  {
+    if (kind_ == kind::array)
     {
-      return (dynamic_cast<object_iterator<T>*>(iterator_adapter_.get()))->iter()->first;
+      return pos_ < (diff_t)array_->size() ? array_->begin() + pos_ : array_->end();
     }
 
-    FORMATS_THROW(type_except::create("can't use key() with iterator",
-                                      typeid(*iterator_adapter_.get()).name()));
+    FORMATS_THROW(type_except::create("iterator incompatible with iterator", kind_name()));
   }
 
-public:
-  diff_t distance_from_begin() const noexcept { return iterator_adapter_->distance_from_begin(); }
+  T* owner() const noexcept { return owner_; }
 
-  typename array_iterator<T>::iterator array_iter() const noexcept(false)
+private:
+  enum class kind : unsigned char
+  {
+    none,  // default constructed
+    scaler,
+    array,
+    object,
+  };
+
+  void forward(int distance)
   {
-    if (iterator_adapter_->is_array())
+    switch (kind_)
     {
-      return (dynamic_cast<array_iterator<T>*>(iterator_adapter_.get()))->iter();
+      case kind::array:
+        if (pos_ < (diff_t)array_->size())
+        {
+          pos_ = std::min<diff_t>(pos_ + distance, (diff_t)array_->size());
+          return void();
+        }
+
+        FORMATS_THROW(iterator_except::create("can't seek array iterator after end"));
+
+      case kind::object:
+        if (iter_ != object_->end())
+        {
+          iter_ = (distance < std::distance(iter_, object_->end())) ? std::next(iter_, distance)
+                                                                    : object_->end();
+          return void();
+        }
+
+        FORMATS_THROW(iterator_except::create("can't seek object iterator after end"));
+
+      default: pos_ += distance; break;
     }
+  }
 
-    FORMATS_THROW(type_except::create("iterator incompatible with iterator",
-                                      typeid(*iterator_adapter_.get()).name()));
+  void backward(int distance)
+  {
+    switch (kind_)
+    {
+      case kind::array:
+        if (pos_ > 0)
+        {
+          pos_ = std::max<diff_t>(pos_ - distance, -1);
+          return void();
+        }
+
+        FORMATS_THROW(iterator_except::create("can't seek array iterator before begin"));
+
+      case kind::object:
+        if (iter_ != object_->begin())
+        {
+          iter_ = (distance <= distance_from_begin()) ? std::next(iter_, -distance)
+                                                      : object_->end();
+          return void();
+        }
+
+        FORMATS_THROW(iterator_except::create("can't seek object iterator before begin"));
+
+      default: pos_ -= distance; break;
+    }
   }
 
-  T* owner() const noexcept { return iterator_adapter_->value_ref(); }
+  template <typename U>
+  bool equal(const iterator<U>& other) const noexcept(false)
+  {
+    if (kind_ == kind::none || other.kind_ == iterator<U>::kind::none)
+      return kind_ == kind::none && other.kind_ == iterator<U>::kind::none;
+
+    if ((unsigned char)kind_ != (unsigned char)other.kind_)
+    {
+      FORMATS_THROW(type_except::create("iterator incompatible with iterator", other.kind_name()));
+    }
+
+    if (owner_ != other.owner_) return false;
+
+    switch (kind_)
+    {
+      case kind::object: return iter_ == other.iter_;
+      case kind::array: return pos_ == other.pos_;
+      default: return (pos_ == 0) == (other.pos_ == 0);
+    }
+  }
+
+  /* the const and non const iterators convert to each other */
+  template <typename U>
+  void assign(const iterator<U>& other)
+  {
+    owner_ = const_cast<pointer>(other.owner_);
+    pos_   = other.pos_;
+    kind_  = kind((unsigned char)other.kind_);
+
+    array_  = const_cast<array_type*>(other.array_);
+    object_ = const_cast<object_type*>(other.object_);
+    if (kind_ == kind::object)
+      iter_ = std::next(object_->begin(), std::distance(other.object_->begin(), other.iter_));
+  }
+
+  const char* kind_name() const noexcept
+  {
+    switch (kind_)
+    {
+      case kind::scaler: return "scaler iterator";
+      case kind::array: return "array iterator";
+      case kind::object: return "object iterator";
+      default: return "null iterator";
+    }
+  }
 
 private:
-  typename iterator_adapter<T>::ptr iterator_adapter_;
+  pointer owner_ = nullptr;
+
+  array_type*     array_  = nullptr;  // the container of owner_, if it is one
+  object_type*    object_ = nullptr;
+  diff_t          pos_    = 0;  // in an array, or 0 and 1 for the begin and the end of a scaler
+  object_iterator iter_{};      // in an object
+  kind            kind_ = kind::none;
 };
 
 FORMATS_NAMESPACE_END
\ No newline at end of file
@@ -57,4 +57,11 @@ namespace formats
 #endif  // _WIN32
 #endif  // !__cplusplus__
 
+// std::pmr, the values and documents on a memory resource
+#if defined(__has_include) && (__cplusplus__ >= 201703L)
+#if __has_include(<memory_resource>)
+#define FORMATS_HAS_MEMORY_RESOURCE
+#endif  // __has_include(<memory_resource>)
+#endif  // __has_include
+
 }  // namespace formats
\ No newline at end of file
@@ -1,8 +1,15 @@
 ﻿#include "number.hpp"
 
+#include <cfloat>
 #include <cmath>
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif  // _MSC_VER && _M_X64
 
 #include <formats/common/cctypes.hpp>
+#include <formats/common/power_of_five.hpp>
 #include <formats/third_party/double-conversion/double-conversion.h>
 #include <formats/third_party/double-conversion/strtod.h>
 
@@ -10,13 +17,225 @@ namespace dcvt = double_conversion;
 
 FORMATS_NAMESPACE_BEGIN
 
+namespace
+{
+/* binary64 */
+constexpr int mantissa_explicit_bits = 52;
+constexpr int minimum_exponent       = -1023;
+constexpr int infinite_power         = 0x7FF;
+
+/* a product may fall right between two doubles only for these powers of ten */
+constexpr int min_exponent_round_to_even = -4;
+constexpr int max_exponent_round_to_even = 23;
+
+/* the powers of ten which are exact doubles, for the exact path */
+constexpr double exact_powers_of_ten[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                          1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                          1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 uint128;
+#endif  // __SIZEOF_INT128__
+
+inline int leading_zeros(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_clzll(x);
+#else
+  int n = 0;
+  while ((x & 0x8000000000000000ULL) == 0)
+  {
+    x <<= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+/* the 128 bits product of a and b, the low word is returned */
+inline uint64_t full_multiplication(uint64_t a, uint64_t b, uint64_t& high)
+{
+#if defined(__SIZEOF_INT128__)
+  uint128 product = (uint128)a * b;
+
+  high = (uint64_t)(product >> 64);
+  return (uint64_t)product;
+#elif defined(_MSC_VER) && defined(_M_X64)
+  return _umul128(a, b, &high);
+#else
+  uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+  uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+
+  uint64_t lo_lo = a_lo * b_lo;
+  uint64_t hi_lo = a_hi * b_lo;
+  uint64_t lo_hi = a_lo * b_hi;
+  uint64_t hi_hi = a_hi * b_hi;
+
+  uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+
+  high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+  return (cross << 32) | (uint32_t)lo_lo;
+#endif
+}
+
+/*
+ * eisel-lemire: the bits of the double nearest to w * 10^q, w != 0. the product of w by the
+ * truncated 128 bits power of five is always precise enough to round when w holds all the digits
+ * of the decimal (mushtak and lemire, fast number parsing without fallback).
+ */
+uint64_t eisel_lemire(uint64_t w, int64_t q)
+{
+  if (q < __smallest_power_of_five) return 0;
+  if (q > __largest_power_of_five) return (uint64_t)infinite_power << mantissa_explicit_bits;
+
+  int lz = leading_zeros(w);
+  w <<= lz;
+
+  // 52 bits, the implicit bit, a bit to round and a bit which the product may lack
+  const uint64_t* power = __power_of_five_128 + 2 * (q - __smallest_power_of_five);
+  const uint64_t  mask  = 0xFFFFFFFFFFFFFFFFULL >> (mantissa_explicit_bits + 3);
+
+  uint64_t high = 0;
+  uint64_t low  = full_multiplication(w, power[0], high);
+
+  // the bits needed may depend on the low word of the power
+  if ((high & mask) == mask)
+  {
+    uint64_t second_high = 0;
+    full_multiplication(w, power[1], second_high);
+
+    low += second_high;
+    if (second_high > low) ++high;
+  }
+
+  int upperbit = (int)(high >> 63);
+  int shift    = upperbit + 64 - mantissa_explicit_bits - 3;
+
+  uint64_t mantissa = high >> shift;
+  int      power2   = (int)((((152170 + 65536) * q) >> 16) + 63) + upperbit - lz - minimum_exponent;
+
+  if (power2 <= 0)
+  {
+    // subnormal, or zero past 64 bits below the smallest exponent
+    if (-power2 + 1 >= 64) return 0;
+
+    mantissa >>= -power2 + 1;
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+
+    // rounding may make it normal
+    power2 = (mantissa < (1ULL << mantissa_explicit_bits)) ? 0 : 1;
+    return ((uint64_t)power2 << mantissa_explicit_bits) |
+           (mantissa & ~(1ULL << mantissa_explicit_bits));
+  }
+
+  // right between two doubles only zeros were shifted out, the tie goes to even
+  if (low <= 1 && q >= min_exponent_round_to_even && q <= max_exponent_round_to_even &&
+      (mantissa & 3) == 1 && (mantissa << shift) == high)
+    mantissa &= ~1ULL;
+
+  mantissa += (mantissa & 1);
+  mantissa >>= 1;
+
+  if (mantissa >= (2ULL << mantissa_explicit_bits))
+  {
+    mantissa = (1ULL << mantissa_explicit_bits);
+    ++power2;
+  }
+
+  mantissa &= ~(1ULL << mantissa_explicit_bits);
+  if (power2 >= infinite_power) return (uint64_t)infinite_power << mantissa_explicit_bits;
+
+  return ((uint64_t)power2 << mantissa_explicit_bits) | mantissa;
+}
+
+inline double bits_to_double(uint64_t bits)
+{
+  double d;
+  std::memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+
+/* the bignum path of double-conversion, on the text of a decimal without its sign */
+double strtod_fallback(const char* ptr, const char* end)
+{
+  std::string digits;
+  long long   exponent = 0;
+
+  if (ptr < end && (*ptr == c_minus_sign || *ptr == c_plus_sign)) ++ptr;
+
+  for (; ptr < end && isdigit(*ptr); ++ptr)
+  {
+    if (!digits.empty() || *ptr != c_number_zero) digits.push_back(*ptr);
+  }
+
+  if (ptr < end && *ptr == c_decimal_point)
+  {
+    for (++ptr; ptr < end && isdigit(*ptr); ++ptr)
+    {
+      if (!digits.empty() || *ptr != c_number_zero) digits.push_back(*ptr);
+      --exponent;
+    }
+  }
+
+  if (ptr < end && (*ptr == 'e' || *ptr == 'E'))
+  {
+    ++ptr;
+
+    bool      exp_neg   = false;
+    long long exp_value = 0;
+
+    if (ptr < end && (*ptr == c_minus_sign || *ptr == c_plus_sign))
+      exp_neg = (*ptr++ == c_minus_sign);
+
+    for (; ptr < end && isdigit(*ptr); ++ptr)
+    {
+      if (exp_value < 100000000) exp_value = exp_value * 10 + char_to_num(*ptr);
+    }
+
+    exponent += exp_neg ? -exp_value : exp_value;
+  }
+
+  if (digits.empty()) return 0.0;
+
+  // far out of the range of double either way
+  if (exponent > 100000000) exponent = 100000000;
+  if (exponent < -100000000) exponent = -100000000;
+
+  return dcvt::Strtod(dcvt::Vector<const char>(digits.data(), (int)digits.size()), (int)exponent);
+}
+
+}  // namespace
+
+double decimal_to_double(uint64_t w, int64_t q, bool truncated, const char* begin, const char* end)
+{
+  if (w == 0) return 0.0;
+
+  // w and 10^q are exact doubles, their product or quotient is rounded once
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+  if (!truncated && q >= -22 && q <= 22 && w <= (1ULL << 53))
+  {
+    double d = (double)w;
+    return (q < 0) ? d / exact_powers_of_ten[-q] : d * exact_powers_of_ten[q];
+  }
+#endif  // FLT_EVAL_METHOD
+
+  uint64_t bits = eisel_lemire(w, q);
+
+  // the dropped digits lie between w and w + 1, the double is known if both round the same
+  if (truncated && (w == UINT64_MAX || eisel_lemire(w + 1, q) != bits))
+    return strtod_fallback(begin, end);
+
+  return bits_to_double(bits);
+}
+
 template <typename T, bool fix_overflow>
-T stoi(const std::string& str, int base, int& bytes_trans)
+T stoi(const char* str, int base, int& bytes_trans)
 {
   if (base < 0 || base == 1 || base > 36) { return 0; }
 
   std::make_unsigned_t<T> ans = 0;
-  const char*             ptr = str.c_str();
+  const char*             ptr = str;
   while (*ptr == ' ')
     ptr++;
 
@@ -152,66 +371,88 @@ bool number::from_hex_string()
 
 bool number::from_dec_string()
 {
+  const char* begin = ptr_;
+
+  auto cutoff = __flowover<sizeof(unsigned long long)>::cutoff_tab[10 - 2];
+  auto cutlim = __flowover<sizeof(unsigned long long)>::cutlim_tab[10 - 2];
+
+  // the value is integer * 10^exponent. the digits past 64 bits are dropped, they only scale it
+  long long exponent  = 0;
+  bool      dropped   = false;
+  bool      truncated = false;  // a digit dropped is not zero
+
   char c = -1;
 
+  while (end_ - ptr_ >= 8 && integer <= __eight_digits_cutoff)
+  {
+    uint64_t block = read_eight_bytes(ptr_);
+    if (!is_eight_digits(block)) break;
+
+    integer = integer * 100000000 + parse_eight_digits(block);
+    ptr_ += 8;
+  }
+
   while (ptr_ < end_ && isdigit(*ptr_))
   {
     c = char_to_num(*ptr_);
 
-    auto cutoff = __flowover<sizeof(unsigned long long)>::cutoff_tab[10 - 2];
-    auto cutlim = __flowover<sizeof(unsigned long long)>::cutlim_tab[10 - 2];
-
-    if (!is_fraction && (integer > cutoff || (integer == cutoff && c > cutlim)))
+    if (dropped || integer > cutoff || (integer == cutoff && c > cutlim))
     {
+      dropped     = true;
+      truncated   = truncated || (c != 0);
       is_fraction = true;
-      fraction    = static_cast<double>(integer);
+      ++exponent;
     }
-
-    if (!is_fraction)
-    {
+    else
       integer = (integer * 10 + c);
 
-      if (negative && integer > (decltype(integer))(std::numeric_limits<long long>::max)() + 1)
-      {
-        is_fraction = true;
-        fraction    = static_cast<double>(integer);
-      }
-    }
-    else { fraction = (fraction * 10 + c); }
-
     ++ptr_;
   }
 
+  if (negative && integer > (decltype(integer))(std::numeric_limits<long long>::max)() + 1)
+    is_fraction = true;
+
   if (ptr_ < end_ && *ptr_ == c_decimal_point)
   {
     ++ptr_;
-
-    fraction    = is_fraction ? fraction : static_cast<double>(integer);
     is_fraction = true;
 
-    long long digit_count   = 0;
-    long long fraction_part = 0;
+    while (!dropped && end_ - ptr_ >= 8 && integer <= __eight_digits_cutoff)
+    {
+      uint64_t block = read_eight_bytes(ptr_);
+      if (!is_eight_digits(block)) break;
+
+      integer = integer * 100000000 + parse_eight_digits(block);
+      exponent -= 8;
+      ptr_ += 8;
+    }
 
     while (ptr_ < end_ && isdigit(*ptr_))
     {
-      ++digit_count;
-      fraction_part = fraction_part * 10 + char_to_num(*ptr_);
+      c = char_to_num(*ptr_);
+
+      if (dropped || integer > cutoff || (integer == cutoff && c > cutlim))
+      {
+        dropped   = true;
+        truncated = truncated || (c != 0);
+      }
+      else
+      {
+        integer = (integer * 10 + c);
+        --exponent;
+      }
 
       ++ptr_;
     }
-
-    fraction += (static_cast<double>(fraction_part) * std::pow(10, -digit_count));
   }
 
   if (ptr_ < end_ && (*ptr_ == 'e' || *ptr_ == 'E'))
   {
     ++ptr_;
-
-    fraction    = is_fraction ? fraction : static_cast<double>(integer);
     is_fraction = true;
 
-    bool exp_neg  = false;
-    int  exponent = 0;
+    bool      exp_neg   = false;
+    long long exp_value = 0;
 
     if (ptr_ < end_)
     {
@@ -226,14 +467,16 @@ bool number::from_dec_string()
 
     while (ptr_ < end_ && isdigit(*ptr_))
     {
-      exponent = exponent * 10 + (*ptr_ - c_number_zero);
+      // saturated far out of the range of double
+      if (exp_value < 100000000) exp_value = exp_value * 10 + (*ptr_ - c_number_zero);
       ++ptr_;
     }
 
-    if (exp_neg) exponent = -exponent;
-    fraction *= std::pow(10, exponent);
+    exponent += exp_neg ? -exp_value : exp_value;
   }
 
+  if (is_fraction) fraction = decimal_to_double(integer, exponent, truncated, begin, ptr_);
+
   return (ptr_ == end_ && (isdigit(*(ptr_ - 1)) || *(ptr_ - 1) == c_decimal_point));
 }
 
@@ -270,6 +513,11 @@ std::string dtoa(double v)
 }
 
 std::pair<long long, bool> strtoll(const std::string& str)
+{
+  return strtoll(str.c_str());
+}
+
+std::pair<long long, bool> strtoll(const char* str)
 {
   auto processed = 0;
   auto result    = stoi<long long, false>(str, 0, processed);
@@ -278,6 +526,11 @@ std::pair<long long, bool> strtoll(const std::string& str)
 }
 
 std::pair<unsigned long long, bool> strtoull(const std::string& str)
+{
+  return strtoull(str.c_str());
+}
+
+std::pair<unsigned long long, bool> strtoull(const char* str)
 {
   auto processed = 0;
   auto result    = stoi<unsigned long long, false>(str, 0, processed);
@@ -286,6 +539,11 @@ std::pair<unsigned long long, bool> strtoull(const std::string& str)
 }
 
 std::pair<double, bool> strtod(const std::string& str)
+{
+  return strtod(str.c_str());
+}
+
+std::pair<double, bool> strtod(const char* str)
 {
   using namespace double_conversion;
 
@@ -296,7 +554,7 @@ std::pair<double, bool> strtod(const std::string& str)
   StringToDoubleConverter converter(flags, 0.0, 1.0, "infinity", "NaN");
 
   auto processed = 0;
-  auto result    = converter.StringToDouble(str.c_str(), (int)str.size(), &processed);
+  auto result    = converter.StringToDouble(str, (int)std::strlen(str), &processed);
 
   return {result, processed != 0};
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <limits>
 #include <formats/common/marco.hpp>
@@ -51,6 +53,57 @@ struct __flowover<8> {
   static constexpr auto& cutlim_tab = cutlim_tab_ull;
 };
 
+/*
+ * swar: eight ascii digits are converted at once, as the bytes of a 64 bits word. a run of digits
+ * is converted by blocks while the result can't overflow, the rest digit by digit.
+ */
+
+/* the largest integer which a block of eight more digits can't overflow */
+constexpr unsigned long long __eight_digits_cutoff = 99999999999ULL;
+
+/* the eight bytes at ptr, the first one in the low byte */
+inline uint64_t read_eight_bytes(const char* ptr)
+{
+  uint64_t val;
+  std::memcpy(&val, ptr, sizeof(val));
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  val = __builtin_bswap64(val);
+#endif  // __BYTE_ORDER__
+
+  return val;
+}
+
+/* all eight bytes are `0` to `9` */
+inline bool is_eight_digits(uint64_t val)
+{
+  return ((val & 0xF0F0F0F0F0F0F0F0ULL) |
+          (((val + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+/* the value of eight digits, the first one is the most significant */
+inline uint32_t parse_eight_digits(uint64_t val)
+{
+  const uint64_t mask = 0x000000FF000000FFULL;
+  const uint64_t mul1 = 0x000F424000000064ULL;  // 100 + (1000000 << 32)
+  const uint64_t mul2 = 0x0000271000000001ULL;  // 1 + (10000 << 32)
+
+  val -= 0x3030303030303030ULL;
+  val = (val * 10) + (val >> 8);  // pairs of digits
+  val = (((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32;
+
+  return (uint32_t)val;
+}
+
+/*
+ * @brief: the double nearest to w * 10^q, ties to even. w holds the leading significant digits of a
+ * decimal, truncated is set if some of its other digits, not all zeros, were dropped. most
+ * decimals are rounded by the eisel-lemire algorithm with a 128 bits product. those it can't
+ * decide, with more than 19 digits, are converted from their text [begin, end) by the bignum
+ * strtod of double-conversion.
+ */
+double decimal_to_double(uint64_t w, int64_t q, bool truncated, const char* begin, const char* end);
+
 // class value;
 class number
 {
@@ -79,8 +132,11 @@ private:
 };
 
 std::pair<long long, bool>          strtoll(const std::string& str);
+std::pair<long long, bool>          strtoll(const char* str);
 std::pair<unsigned long long, bool> strtoull(const std::string& str);
+std::pair<unsigned long long, bool> strtoull(const char* str);
 std::pair<double, bool>             strtod(const std::string& str);
+std::pair<double, bool>             strtod(const char* str);
 bool                                dtoa(double v, char* buffer, int& size);
 std::string                         dtoa(double v);
 
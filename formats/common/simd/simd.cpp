@@ -0,0 +1,707 @@
+#include <formats/common/simd/simd.hpp>
+
+#include <atomic>
+#include <cstring>
+
+#include <formats/common/tokens.h>
+#include <formats/common/unicode/unicode.hpp>
+
+#if !defined(FORMATS_NO_SIMD) && \
+    (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define FORMATS_SIMD_X86 1
+
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif  // _MSC_VER
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FORMATS_TARGET(set) __attribute__((target(set)))
+#else
+#define FORMATS_TARGET(set)
+#endif
+
+FORMATS_NAMESPACE_BEGIN
+
+namespace simd
+{
+namespace
+{
+isa detect_isa() noexcept
+{
+#if defined(FORMATS_SIMD_X86)
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx2")) return isa::avx2;
+  if (__builtin_cpu_supports("sse2")) return isa::sse2;
+#elif defined(_MSC_VER)
+  int info[4] = {0};
+
+  __cpuid(info, 0);
+  int max_leaf = info[0];
+
+  __cpuid(info, 1);
+  bool has_sse2    = (info[3] & (1 << 26)) != 0;
+  bool has_osxsave = (info[2] & (1 << 27)) != 0;
+  bool has_avx     = (info[2] & (1 << 28)) != 0;
+
+  // avx2 also needs the os to save the ymm registers
+  if (max_leaf >= 7 && has_osxsave && has_avx && (_xgetbv(0) & 0x06) == 0x06)
+  {
+    __cpuidex(info, 7, 0);
+    if (info[1] & (1 << 5)) return isa::avx2;
+  }
+
+  if (has_sse2) return isa::sse2;
+#endif
+#endif  // FORMATS_SIMD_X86
+
+  return isa::scalar;
+}
+
+std::atomic<isa>& active_isa() noexcept
+{
+  static std::atomic<isa> active(supported());
+  return active;
+}
+
+/*
+ * line terminators among the masked bytes. a `\r` directly followed by `\n` is a single
+ * terminator, the `\n` counts it.
+ */
+inline int count_lines(uint64_t lf, uint64_t cr, uint64_t crlf, uint64_t mask) noexcept
+{
+  return count_ones(lf & mask) + count_ones(cr & mask) - count_ones(crlf & mask);
+}
+
+const char* skip_white_space_scalar(const char* ptr, const char* end, int& lines) noexcept
+{
+  while (ptr < end)
+  {
+    unsigned char c = *ptr;
+
+    if (c == c_space || c == c_horizontal_tab || c == c_form_feed)
+    {
+      ++ptr;
+      continue;
+    }
+
+    if (c == c_line_feed)
+    {
+      ++lines;
+      ++ptr;
+      continue;
+    }
+
+    if (c == c_carriage_return && end - ptr > 1)
+    {
+      ++lines;
+      ptr += (*(ptr + 1) == c_line_feed) ? 2 : 1;
+      continue;
+    }
+
+    break;
+  }
+
+  return ptr;
+}
+
+template <bool non_ascii>
+const char* scan_string_scalar(const char* ptr, const char* end, char quote) noexcept
+{
+  while (ptr < end)
+  {
+    unsigned char c = *ptr;
+
+    if (c == (unsigned char)quote || c == c_reverse_solidus || c < 0x20) break;
+    if (non_ascii && c >= 0x80) break;
+
+    ++ptr;
+  }
+
+  return ptr;
+}
+
+/* length of the well formed utf8 sequence at ptr, 0 if it is not */
+inline int legal_sequence_length(const char* ptr, const char* end) noexcept
+{
+  int length = unicode::u8sequence_length(*ptr);
+  if (length == 1) return ((unsigned char)*ptr < 0x80) ? 1 : 0;
+
+  return (end - ptr >= length && unicode::is_legal_utf8(ptr, length)) ? length : 0;
+}
+
+bool validate_utf8_scalar(const char* ptr, const char* end) noexcept
+{
+  while (ptr < end)
+  {
+    // ascii runs are skipped a word at a time
+    uint64_t word = 0;
+    while (end - ptr >= 8)
+    {
+      std::memcpy(&word, ptr, sizeof(word));
+      if (word & 0x8080808080808080ULL) break;
+
+      ptr += 8;
+    }
+
+    if (ptr == end) break;
+
+    int length = legal_sequence_length(ptr, end);
+    if (length == 0) return false;
+
+    ptr += length;
+  }
+
+  return true;
+}
+
+void classify_json_scalar(const char* ptr, size_t blocks, block_masks* masks) noexcept
+{
+  for (size_t i = 0; i < blocks; ++i, ptr += 64)
+  {
+    block_masks& m = masks[i];
+    m              = block_masks{0, 0, 0, 0};
+
+    for (int j = 0; j < 64; ++j)
+    {
+      uint64_t bit = 1ull << j;
+
+      switch ((unsigned char)ptr[j])
+      {
+        case c_double_quotes: m.quote |= bit; break;
+        case c_reverse_solidus: m.backslash |= bit; break;
+
+        case c_object_begin:
+        case c_object_end:
+        case c_array_begin:
+        case c_array_end:
+        case c_name_separator:
+        case c_value_separator: m.op |= bit; break;
+
+        case c_space:
+        case c_horizontal_tab:
+        case c_form_feed:
+        case c_line_feed:
+        case c_carriage_return: m.space |= bit; break;
+
+        default: break;
+      }
+    }
+  }
+}
+
+#if defined(FORMATS_SIMD_X86)
+/*
+ * tables of the lookup table algorithm (Keiser & Lemire, "Validating UTF-8 In Less Than One
+ * Instruction Per Byte"). the high and low nibble of a byte and the high nibble of the byte after
+ * it each select a set of errors, the pair is illegal when an error is in all three sets.
+ */
+enum : uint8_t
+{
+  too_short      = 1 << 0,  // 11______ 0_______ or 11______ 11______
+  too_long       = 1 << 1,  // 0_______ 10______
+  overlong_3     = 1 << 2,  // 11100000 100_____
+  too_large      = 1 << 3,  // 11110100 1001____, 11110101+ 1001____ or 101_____
+  surrogate      = 1 << 4,  // 11101101 101_____
+  overlong_2     = 1 << 5,  // 1100000_ 10______
+  too_large_1000 = 1 << 6,  // 11110101+ 1000____
+  overlong_4     = 1 << 6,  // 11110000 1000____
+  two_conts      = 1 << 7,  // 10______ 10______, legal as 3rd or 4th byte
+  carry          = too_short | too_long | two_conts,
+};
+
+alignas(16) const uint8_t utf8_byte_1_high[16] = {
+    // 0_______ ascii
+    too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+    // 10______ continuation
+    two_conts, two_conts, two_conts, two_conts,
+    // 1100____ 1101____ two bytes lead
+    too_short | overlong_2, too_short,
+    // 1110____ three bytes lead
+    too_short | overlong_3 | surrogate,
+    // 1111____ four bytes lead
+    too_short | too_large | too_large_1000 | overlong_4};
+
+alignas(16) const uint8_t utf8_byte_1_low[16] = {
+    // ____0000 ____0001
+    carry | overlong_3 | overlong_2 | overlong_4, carry | overlong_2,
+    // ____001_
+    carry, carry,
+    // ____0100 ____0101 ____011_
+    carry | too_large, carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000,
+    // ____1___, ____1101 is the surrogate lead
+    carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000, carry | too_large | too_large_1000 | surrogate,
+    carry | too_large | too_large_1000, carry | too_large | too_large_1000};
+
+alignas(16) const uint8_t utf8_byte_2_high[16] = {
+    // ________ 0_______
+    too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+    // ________ 1000____
+    too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+    // ________ 1001____
+    too_long | overlong_2 | two_conts | overlong_3 | too_large,
+    // ________ 101_____
+    too_long | overlong_2 | two_conts | surrogate | too_large,
+    too_long | overlong_2 | two_conts | surrogate | too_large,
+    // ________ 11______
+    too_short, too_short, too_short, too_short};
+
+/* a lead byte in the last three positions of a block still waits for continuation bytes */
+alignas(32) const uint8_t utf8_incomplete[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,     0xFF,     0xFF,    0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,     0xFF,     0xFF,    0xFF, 0xFF,
+    0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1};
+#endif  // FORMATS_SIMD_X86
+
+#if defined(FORMATS_SIMD_X86)
+FORMATS_TARGET("sse2")
+const char* skip_white_space_sse2(const char* ptr, const char* end, int& lines) noexcept
+{
+  const __m128i space = _mm_set1_epi8(c_space);
+  const __m128i tab   = _mm_set1_epi8(c_horizontal_tab);
+  const __m128i ff    = _mm_set1_epi8(c_form_feed);
+  const __m128i lf    = _mm_set1_epi8(c_line_feed);
+  const __m128i cr    = _mm_set1_epi8(c_carriage_return);
+
+  while (end - ptr >= 16)
+  {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+
+    __m128i is_lf = _mm_cmpeq_epi8(block, lf);
+    __m128i is_cr = _mm_cmpeq_epi8(block, cr);
+    __m128i is_ws = _mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab));
+    is_ws         = _mm_or_si128(is_ws, _mm_cmpeq_epi8(block, ff));
+    is_ws         = _mm_or_si128(is_ws, _mm_or_si128(is_lf, is_cr));
+
+    uint32_t ws_mask = (uint32_t)_mm_movemask_epi8(is_ws);
+    uint32_t lf_mask = (uint32_t)_mm_movemask_epi8(is_lf);
+    uint32_t cr_mask = (uint32_t)_mm_movemask_epi8(is_cr);
+    uint32_t crlf    = cr_mask & (lf_mask >> 1);
+
+    if (ws_mask != 0xFFFF)
+    {
+      int skip = trailing_zeros(~ws_mask);
+      lines += count_lines(lf_mask, cr_mask, crlf, (1u << skip) - 1);
+
+      return ptr + skip;
+    }
+
+    if (unlikely(cr_mask & 0x8000))
+    {
+      if (end - ptr == 16)
+      {
+        lines += count_lines(lf_mask, cr_mask, crlf, 0x7FFF);
+        return ptr + 15;
+      }
+
+      if (*(ptr + 16) == c_line_feed) crlf |= 0x8000;
+    }
+
+    lines += count_lines(lf_mask, cr_mask, crlf, 0xFFFF);
+    ptr += 16;
+  }
+
+  return skip_white_space_scalar(ptr, end, lines);
+}
+
+template <bool non_ascii>
+FORMATS_TARGET("sse2")
+const char* scan_string_sse2(const char* ptr, const char* end, char quote) noexcept
+{
+  const __m128i quotes    = _mm_set1_epi8(quote);
+  const __m128i backslash = _mm_set1_epi8(c_reverse_solidus);
+  const __m128i control   = _mm_set1_epi8(non_ascii ? 0x20 : 0x1F);
+
+  while (end - ptr >= 16)
+  {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+
+    // signed compare: non-ascii bytes are negative, so one compare finds them with the controls.
+    // otherwise an unsigned one: min(c, 0x1F) == c
+    __m128i special = _mm_cmpeq_epi8(block, quotes);
+    special         = _mm_or_si128(special, _mm_cmpeq_epi8(block, backslash));
+    special         = _mm_or_si128(
+        special, non_ascii ? _mm_cmplt_epi8(block, control)
+                           : _mm_cmpeq_epi8(_mm_min_epu8(block, control), block));
+
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(special);
+    if (mask != 0) return ptr + trailing_zeros(mask);
+
+    ptr += 16;
+  }
+
+  return scan_string_scalar<non_ascii>(ptr, end, quote);
+}
+
+/*
+ * `[` `]` differ from `{` `}` in the 0x20 bit only, setting it leaves four compares for the
+ * operators.
+ */
+FORMATS_TARGET("sse2")
+void classify_json_sse2(const char* ptr, size_t blocks, block_masks* masks) noexcept
+{
+  const __m128i quote     = _mm_set1_epi8(c_double_quotes);
+  const __m128i backslash = _mm_set1_epi8(c_reverse_solidus);
+  const __m128i lower     = _mm_set1_epi8(0x20);
+  const __m128i open      = _mm_set1_epi8(c_object_begin);
+  const __m128i close     = _mm_set1_epi8(c_object_end);
+  const __m128i colon     = _mm_set1_epi8(c_name_separator);
+  const __m128i comma     = _mm_set1_epi8(c_value_separator);
+  const __m128i space     = _mm_set1_epi8(c_space);
+  const __m128i tab       = _mm_set1_epi8(c_horizontal_tab);
+  const __m128i ff        = _mm_set1_epi8(c_form_feed);
+  const __m128i lf        = _mm_set1_epi8(c_line_feed);
+  const __m128i cr        = _mm_set1_epi8(c_carriage_return);
+
+  for (size_t i = 0; i < blocks; ++i)
+  {
+    block_masks& m = masks[i];
+    m              = block_masks{0, 0, 0, 0};
+
+    for (int j = 0; j < 64; j += 16, ptr += 16)
+    {
+      __m128i block  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+      __m128i folded = _mm_or_si128(block, lower);
+
+      __m128i op = _mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close));
+      op         = _mm_or_si128(op, _mm_cmpeq_epi8(block, colon));
+      op         = _mm_or_si128(op, _mm_cmpeq_epi8(block, comma));
+
+      __m128i ws = _mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab));
+      ws         = _mm_or_si128(ws, _mm_cmpeq_epi8(block, ff));
+      ws         = _mm_or_si128(ws, _mm_cmpeq_epi8(block, lf));
+      ws         = _mm_or_si128(ws, _mm_cmpeq_epi8(block, cr));
+
+      m.quote |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, quote)) << j;
+      m.backslash |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, backslash)) << j;
+      m.op |= (uint64_t)(uint32_t)_mm_movemask_epi8(op) << j;
+      m.space |= (uint64_t)(uint32_t)_mm_movemask_epi8(ws) << j;
+    }
+  }
+}
+
+/* sse2 has no byte shuffle, only ascii blocks are skipped. the sequences are checked one by one */
+FORMATS_TARGET("sse2")
+bool validate_utf8_sse2(const char* ptr, const char* end) noexcept
+{
+  while (end - ptr >= 16)
+  {
+    __m128i  block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+    uint32_t mask  = (uint32_t)_mm_movemask_epi8(block);
+
+    if (mask == 0)
+    {
+      ptr += 16;
+      continue;
+    }
+
+    ptr += trailing_zeros(mask);
+
+    do
+    {
+      int length = legal_sequence_length(ptr, end);
+      if (length == 0) return false;
+
+      ptr += length;
+    } while (ptr < end && (unsigned char)*ptr >= 0x80);
+  }
+
+  return validate_utf8_scalar(ptr, end);
+}
+
+FORMATS_TARGET("avx2")
+const char* skip_white_space_avx2(const char* ptr, const char* end, int& lines) noexcept
+{
+  const __m256i space = _mm256_set1_epi8(c_space);
+  const __m256i tab   = _mm256_set1_epi8(c_horizontal_tab);
+  const __m256i ff    = _mm256_set1_epi8(c_form_feed);
+  const __m256i lf    = _mm256_set1_epi8(c_line_feed);
+  const __m256i cr    = _mm256_set1_epi8(c_carriage_return);
+
+  while (end - ptr >= 32)
+  {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+
+    __m256i is_lf = _mm256_cmpeq_epi8(block, lf);
+    __m256i is_cr = _mm256_cmpeq_epi8(block, cr);
+    __m256i is_ws = _mm256_or_si256(_mm256_cmpeq_epi8(block, space), _mm256_cmpeq_epi8(block, tab));
+    is_ws         = _mm256_or_si256(is_ws, _mm256_cmpeq_epi8(block, ff));
+    is_ws         = _mm256_or_si256(is_ws, _mm256_or_si256(is_lf, is_cr));
+
+    uint64_t ws_mask = (uint32_t)_mm256_movemask_epi8(is_ws);
+    uint64_t lf_mask = (uint32_t)_mm256_movemask_epi8(is_lf);
+    uint64_t cr_mask = (uint32_t)_mm256_movemask_epi8(is_cr);
+    uint64_t crlf    = cr_mask & (lf_mask >> 1);
+
+    if (ws_mask != 0xFFFFFFFF)
+    {
+      int skip = trailing_zeros(~ws_mask);
+      lines += count_lines(lf_mask, cr_mask, crlf, (1ull << skip) - 1);
+
+      return ptr + skip;
+    }
+
+    if (unlikely(cr_mask & 0x80000000))
+    {
+      if (end - ptr == 32)
+      {
+        lines += count_lines(lf_mask, cr_mask, crlf, 0x7FFFFFFF);
+        return ptr + 31;
+      }
+
+      if (*(ptr + 32) == c_line_feed) crlf |= 0x80000000;
+    }
+
+    lines += count_lines(lf_mask, cr_mask, crlf, 0xFFFFFFFF);
+    ptr += 32;
+  }
+
+  return skip_white_space_sse2(ptr, end, lines);
+}
+
+template <bool non_ascii>
+FORMATS_TARGET("avx2")
+const char* scan_string_avx2(const char* ptr, const char* end, char quote) noexcept
+{
+  const __m256i quotes    = _mm256_set1_epi8(quote);
+  const __m256i backslash = _mm256_set1_epi8(c_reverse_solidus);
+  const __m256i control   = _mm256_set1_epi8(non_ascii ? 0x20 : 0x1F);
+
+  while (end - ptr >= 32)
+  {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+
+    __m256i special = _mm256_cmpeq_epi8(block, quotes);
+    special         = _mm256_or_si256(special, _mm256_cmpeq_epi8(block, backslash));
+    special         = _mm256_or_si256(
+        special, non_ascii ? _mm256_cmpgt_epi8(control, block)
+                           : _mm256_cmpeq_epi8(_mm256_min_epu8(block, control), block));
+
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(special);
+    if (mask != 0) return ptr + trailing_zeros(mask);
+
+    ptr += 32;
+  }
+
+  return scan_string_sse2<non_ascii>(ptr, end, quote);
+}
+
+FORMATS_TARGET("avx2")
+void classify_json_avx2(const char* ptr, size_t blocks, block_masks* masks) noexcept
+{
+  const __m256i quote     = _mm256_set1_epi8(c_double_quotes);
+  const __m256i backslash = _mm256_set1_epi8(c_reverse_solidus);
+  const __m256i lower     = _mm256_set1_epi8(0x20);
+  const __m256i open      = _mm256_set1_epi8(c_object_begin);
+  const __m256i close     = _mm256_set1_epi8(c_object_end);
+  const __m256i colon     = _mm256_set1_epi8(c_name_separator);
+  const __m256i comma     = _mm256_set1_epi8(c_value_separator);
+  const __m256i space     = _mm256_set1_epi8(c_space);
+  const __m256i tab       = _mm256_set1_epi8(c_horizontal_tab);
+  const __m256i ff        = _mm256_set1_epi8(c_form_feed);
+  const __m256i lf        = _mm256_set1_epi8(c_line_feed);
+  const __m256i cr        = _mm256_set1_epi8(c_carriage_return);
+
+  for (size_t i = 0; i < blocks; ++i)
+  {
+    block_masks& m = masks[i];
+    m              = block_masks{0, 0, 0, 0};
+
+    for (int j = 0; j < 64; j += 32, ptr += 32)
+    {
+      __m256i block  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+      __m256i folded = _mm256_or_si256(block, lower);
+
+      __m256i op =
+          _mm256_or_si256(_mm256_cmpeq_epi8(folded, open), _mm256_cmpeq_epi8(folded, close));
+      op = _mm256_or_si256(op, _mm256_cmpeq_epi8(block, colon));
+      op = _mm256_or_si256(op, _mm256_cmpeq_epi8(block, comma));
+
+      __m256i ws = _mm256_or_si256(_mm256_cmpeq_epi8(block, space), _mm256_cmpeq_epi8(block, tab));
+      ws         = _mm256_or_si256(ws, _mm256_cmpeq_epi8(block, ff));
+      ws         = _mm256_or_si256(ws, _mm256_cmpeq_epi8(block, lf));
+      ws         = _mm256_or_si256(ws, _mm256_cmpeq_epi8(block, cr));
+
+      m.quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, quote)) << j;
+      m.backslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, backslash))
+                     << j;
+      m.op |= (uint64_t)(uint32_t)_mm256_movemask_epi8(op) << j;
+      m.space |= (uint64_t)(uint32_t)_mm256_movemask_epi8(ws) << j;
+    }
+  }
+}
+
+/*
+ * errors of a block. prev is the block before, the first bytes look back into it. besides the
+ * pair errors, a continuation must follow a three or four bytes lead exactly when two_conts is
+ * set, so the two are xor-ed.
+ */
+FORMATS_TARGET("avx2")
+inline __m256i utf8_errors_avx2(__m256i input, __m256i prev, __m256i byte_1_high_table,
+                                __m256i byte_1_low_table, __m256i byte_2_high_table) noexcept
+{
+  const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+
+  // the input shifted by 1, 2 and 3 bytes, the holes are filled from the block before
+  __m256i shifted = _mm256_permute2x128_si256(prev, input, 0x21);
+  __m256i prev1   = _mm256_alignr_epi8(input, shifted, 15);
+  __m256i prev2   = _mm256_alignr_epi8(input, shifted, 14);
+  __m256i prev3   = _mm256_alignr_epi8(input, shifted, 13);
+
+  __m256i byte_1_high = _mm256_shuffle_epi8(
+      byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+  __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, low_nibble));
+  __m256i byte_2_high = _mm256_shuffle_epi8(
+      byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+
+  __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+  // only 111_____ two bytes back or 1111____ three bytes back reach 0x80
+  __m256i third  = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+  __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+  __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+
+  return _mm256_xor_si256(must23, special);
+}
+
+FORMATS_TARGET("avx2")
+bool validate_utf8_avx2(const char* ptr, const char* end) noexcept
+{
+  const __m256i byte_1_high = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(utf8_byte_1_high)));
+  const __m256i byte_1_low = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(utf8_byte_1_low)));
+  const __m256i byte_2_high = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(utf8_byte_2_high)));
+  const __m256i incomplete = _mm256_load_si256(reinterpret_cast<const __m256i*>(utf8_incomplete));
+
+  __m256i error           = _mm256_setzero_si256();
+  __m256i prev            = _mm256_setzero_si256();
+  __m256i prev_incomplete = _mm256_setzero_si256();
+
+  while (ptr < end)
+  {
+    __m256i input;
+
+    if (end - ptr >= 32)
+    {
+      input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+      ptr += 32;
+    }
+    else
+    {
+      // the tail is padded with ascii, a sequence cut by end is too short
+      alignas(32) char tail[32] = {0};
+      std::memcpy(tail, ptr, end - ptr);
+
+      input = _mm256_load_si256(reinterpret_cast<const __m256i*>(tail));
+      ptr   = end;
+    }
+
+    if (_mm256_movemask_epi8(input) == 0)
+    {
+      error           = _mm256_or_si256(error, prev_incomplete);
+      prev_incomplete = _mm256_setzero_si256();
+    }
+    else
+    {
+      error = _mm256_or_si256(error, utf8_errors_avx2(input, prev, byte_1_high, byte_1_low,
+                                                      byte_2_high));
+      prev_incomplete = _mm256_subs_epu8(input, incomplete);
+    }
+
+    prev = input;
+  }
+
+  error = _mm256_or_si256(error, prev_incomplete);
+  return _mm256_testz_si256(error, error) != 0;
+}
+#endif  // FORMATS_SIMD_X86
+
+}  // namespace
+
+isa supported() noexcept
+{
+  static const isa set = detect_isa();
+  return set;
+}
+
+isa selected() noexcept
+{
+  return active_isa().load(std::memory_order_relaxed);
+}
+
+isa select(isa set) noexcept
+{
+  if (set > supported()) set = supported();
+
+  return active_isa().exchange(set);
+}
+
+const char* skip_white_space(const char* ptr, const char* end, int& lines) noexcept
+{
+  switch (selected())
+  {
+#if defined(FORMATS_SIMD_X86)
+    case isa::avx2: return skip_white_space_avx2(ptr, end, lines);
+    case isa::sse2: return skip_white_space_sse2(ptr, end, lines);
+#endif  // FORMATS_SIMD_X86
+
+    default: return skip_white_space_scalar(ptr, end, lines);
+  }
+}
+
+const char* scan_string(const char* ptr, const char* end, char quote, bool non_ascii) noexcept
+{
+  switch (selected())
+  {
+#if defined(FORMATS_SIMD_X86)
+    case isa::avx2:
+      return non_ascii ? scan_string_avx2<true>(ptr, end, quote)
+                       : scan_string_avx2<false>(ptr, end, quote);
+    case isa::sse2:
+      return non_ascii ? scan_string_sse2<true>(ptr, end, quote)
+                       : scan_string_sse2<false>(ptr, end, quote);
+#endif  // FORMATS_SIMD_X86
+
+    default:
+      return non_ascii ? scan_string_scalar<true>(ptr, end, quote)
+                       : scan_string_scalar<false>(ptr, end, quote);
+  }
+}
+
+bool validate_utf8(const char* ptr, const char* end) noexcept
+{
+  switch (selected())
+  {
+#if defined(FORMATS_SIMD_X86)
+    case isa::avx2: return validate_utf8_avx2(ptr, end);
+    case isa::sse2: return validate_utf8_sse2(ptr, end);
+#endif  // FORMATS_SIMD_X86
+
+    default: return validate_utf8_scalar(ptr, end);
+  }
+}
+
+void classify_json(const char* ptr, size_t blocks, block_masks* masks) noexcept
+{
+  switch (selected())
+  {
+#if defined(FORMATS_SIMD_X86)
+    case isa::avx2: return classify_json_avx2(ptr, blocks, masks);
+    case isa::sse2: return classify_json_sse2(ptr, blocks, masks);
+#endif  // FORMATS_SIMD_X86
+
+    default: return classify_json_scalar(ptr, blocks, masks);
+  }
+}
+
+}  // namespace simd
+
+FORMATS_NAMESPACE_END
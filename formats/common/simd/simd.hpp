@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <formats/common/marco.hpp>
+
+FORMATS_NAMESPACE_BEGIN
+
+namespace simd
+{
+/* instruction set used by the block scanners. selected at runtime */
+enum class isa : unsigned char
+{
+  scalar = 0,  // portable byte-at-a-time fallback
+  sse2,        // 16 bytes per block
+  avx2,        // 32 bytes per block
+};
+
+/*
+ * @brief: the best instruction set supported by the running cpu. detected once.
+ */
+isa supported() noexcept;
+
+/*
+ * @brief: the instruction set the scanners currently dispatch to.
+ */
+isa selected() noexcept;
+
+/*
+ * @brief: force the scanners to an instruction set, clamped to supported(). mainly for tests and
+ * benchmarks.
+ * @ret: the instruction set selected before.
+ */
+isa select(isa set) noexcept;
+
+/*
+ * @brief: skip a run of insignificant white space: space, horizontal tab, form feed, line feed and
+ * carriage return.
+ * @param[ptr]: scan begin
+ * @param[end]: scan end
+ * @param[lines]: increased by the number of line terminators skipped, `\r\n` counts once.
+ * @ret: the first byte which is not white space, or end. a `\r` at end - 1 is never skipped, the
+ * `\n` which may pair with it is not visible yet.
+ */
+const char* skip_white_space(const char* ptr, const char* end, int& lines) noexcept;
+
+/*
+ * @brief: find the end of a clean run inside a quoted string body.
+ * @param[ptr]: scan begin
+ * @param[end]: scan end
+ * @param[quote]: the quotation mark which closes the string
+ * @param[non_ascii]: stop at non-ascii bytes too. off to find the end of a span to validate as utf8
+ * @ret: the first quotation mark, reverse solidus, control character (below 0x20) or non-ascii
+ * byte, or end.
+ */
+const char* scan_string(const char* ptr, const char* end, char quote,
+                        bool non_ascii = true) noexcept;
+
+/*
+ * @brief: verify [ptr, end) is well formed utf8. see unicode::validate_utf8
+ */
+bool validate_utf8(const char* ptr, const char* end) noexcept;
+
+/* bitmasks of a 64 bytes block, bit i stands for byte i */
+struct block_masks
+{
+  uint64_t quote;      // `"`
+  uint64_t backslash;  // `\`
+  uint64_t op;         // `{` `}` `[` `]` `:` `,`
+  uint64_t space;      // white space, the same set skip_white_space skips
+};
+
+/*
+ * @brief: classify the bytes of json text by 64 bytes blocks, for the structural index.
+ * @param[ptr]: the first block. blocks * 64 bytes must be readable
+ * @param[blocks]: count of blocks
+ * @param[masks]: one result per block
+ */
+void classify_json(const char* ptr, size_t blocks, block_masks* masks) noexcept;
+
+inline int count_ones(uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(x);
+#else
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/* index of the lowest set bit. x must not be 0 */
+inline int trailing_zeros(uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#else
+  int n = 0;
+  while ((x & 1) == 0)
+  {
+    x >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+}  // namespace simd
+
+FORMATS_NAMESPACE_END
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include <string>
 #include <type_traits>
 
 #include <formats/jsoncpp/fwd.hpp>
@@ -124,11 +125,21 @@ template <typename T>
 struct is_char_array_or_pointer
     : std::integral_constant<bool, is_char_pointer<T>::value || is_char_array<T>::value> {};
 
+// std::string, or a string of chars with another allocator
+template <typename T>
+struct is_string : std::false_type {};
+
+template <typename Traits, typename Alloc>
+struct is_string<std::basic_string<char, Traits, Alloc>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_string_v = is_string<T>::value;
+
 template <typename T>
 struct is_scaler {
-  static constexpr bool value =
-      std::is_same<std::nullptr_t, T>::value || is_char_array_or_pointer<T>::value ||
-      std::is_same<std::string, T>::value || std::is_same<bool, T>::value || is_number<T>::value;
+  static constexpr bool value = std::is_same<std::nullptr_t, T>::value ||
+                                is_char_array_or_pointer<T>::value || is_string<T>::value ||
+                                std::is_same<bool, T>::value || is_number<T>::value;
 };
 
 /*********************************struct type*********************************/
@@ -164,7 +175,7 @@ template <typename Container>
 struct is_unmapped_traversable_container {
   constexpr static bool value = is_traversable_container<Container>::value &&
                                 !is_mapped_container<Container>::value &&
-                                !std::is_same<Container, std::string>::value;
+                                !is_string<Container>::value;
 };
 
 template <typename Container, typename = void>
@@ -0,0 +1,16 @@
+#include <formats/common/unicode/unicode.hpp>
+
+#include <formats/common/simd/simd.hpp>
+
+FORMATS_NAMESPACE_BEGIN
+
+namespace unicode
+{
+bool validate_utf8(const char* begin, const char* end) noexcept
+{
+  return simd::validate_utf8(begin, end);
+}
+
+}  // namespace unicode
+
+FORMATS_NAMESPACE_END
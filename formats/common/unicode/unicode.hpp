@@ -125,10 +125,25 @@ bool is_legal_utf8(u8iter source, size_t length)
       }
 
     case 1:
-      if (*source >= 0x80 && *source < 0xC2) return false;
+      if ((unsigned char)*source >= 0x80 && (unsigned char)*source < 0xC2) return false;
   }
 
-  return (*source <= 0xF4) ? true : false;
+  return ((unsigned char)*source <= 0xF4) ? true : false;
+}
+
+/*
+ * @brief: verify a whole utf8 buffer is legal. checked by blocks with the lookup table algorithm
+ * on cpus which support it, runs of ascii are skipped without decoding.
+ * @param[begin]: the buffer begin
+ * @param[end]: the buffer end
+ * @ret: false on overlong forms, surrogates, code points above U+10FFFF, stray continuation
+ * bytes or a sequence truncated by end.
+ */
+bool validate_utf8(const char* begin, const char* end) noexcept;
+
+inline bool validate_utf8(const std::string& str) noexcept
+{
+  return validate_utf8(str.data(), str.data() + str.size());
 }
 
 }  // namespace unicode
@@ -7,12 +7,13 @@
 
 FORMATS_NAMESPACE_BEGIN
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class array
 {
 public:
-  using array_type = std::vector<T>;
+  using array_type = std::vector<T, Allocator>;
 
+  using allocator_type  = typename array_type::allocator_type;
   using value_type      = typename array_type::value_type;
   using size_type       = typename array_type::size_type;
   using reference       = typename array_type::reference;
@@ -43,22 +44,37 @@ public:
 public:
   array() {}
 
+  explicit array(const allocator_type& alloc)
+      : values_(alloc)
+  {}
+
   array(const array& other)
       : values_(other.values_)
   {}
 
+  array(const array& other, const allocator_type& alloc)
+      : values_(other.values_, alloc)
+  {}
+
   array(array&& other)
       : values_(std::move(other.values_))
   {}
 
+  array(array&& other, const allocator_type& alloc)
+      : values_(std::move(other.values_), alloc)
+  {}
+
   ~array() { values_.clear(); }
 
 public:
   void assign(size_type size, const T& value) { values_.assign(size, value); }
 
+  allocator_type get_allocator() const noexcept { return values_.get_allocator(); }
+
 public:
   inline bool      empty() const noexcept { return values_.empty(); }
   inline size_type size() const noexcept { return values_.size(); }
+  inline void      reserve(size_type cnt) { values_.reserve(cnt); }
 
 public:  // Element access
   inline reference       operator[](size_type pos) { return values_[pos]; }
@@ -1,210 +1,401 @@
 #pragma once
 
-#include <unordered_map>
-#include <list>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 #include <formats/common/marco.hpp>
+#include <formats/common/type_traits.hpp>
 #include <formats/jsoncpp/fwd.hpp>
 
 FORMATS_NAMESPACE_BEGIN
 
+/*
+ * a map that iterates in insertion order. the entries are constructed in blocks of growing size,
+ * where they stay until they are erased, and the order is an array of pointers to them. a key is
+ * found by a linear scan of the entries. above index_threshold entries, an open addressing table
+ * of the positions of the entries is built, and a key is found by a probe of it instead.
+ *
+ * as with a node based map, a reference to an entry stays valid until the entry is erased, so
+ * `map["b"] = map["a"]` copies a live entry. an insertion or an erasure invalidates the iterators,
+ * which are positions in the order.
+ */
 template <typename Key,
           typename T,
-          typename Hash     = std::hash<Key>,
-          typename KeyEqual = std::equal_to<Key>>
+          typename Hash      = std::hash<Key>,
+          typename KeyEqual  = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
 class ordered_map
 {
 public:
   using value_type = std::pair<const Key, T>;
-  using link_type  = std::list<value_type>;
-  using map_type   = std::unordered_map<Key, typename link_type::iterator, Hash, KeyEqual>;
 
+  using allocator_type  = Allocator;
   using refex_wrapper   = value_type&;
   using const_reference = const value_type&;
   using pointer         = value_type*;
   using const_pointer   = const value_type*;
 
-  using hasher      = typename map_type::hasher;
-  using key_type    = typename map_type::key_type;
-  using mapped_type = typename map_type::mapped_type;
-  using key_equal   = typename map_type::key_equal;
+  using hasher      = Hash;
+  using key_type    = Key;
+  using mapped_type = T;
+  using key_equal   = KeyEqual;
 
-  using size_type       = typename link_type::size_type;
-  using difference_type = typename link_type::difference_type;
+  using size_type       = std::size_t;
+  using difference_type = std::ptrdiff_t;
 
-  using iterator               = typename link_type::iterator;
-  using const_iterator         = typename link_type::const_iterator;
-  using reverse_iterator       = typename link_type::reverse_iterator;
-  using const_reverse_iterator = typename link_type::const_reverse_iterator;
+private:
+  /* a position in the order of the entries */
+  template <typename Entry>
+  class order_iterator
+  {
+    template <typename>
+    friend class order_iterator;
+    friend class ordered_map;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = typename std::remove_const<Entry>::type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = Entry*;
+    using reference         = Entry&;
+
+    order_iterator() = default;
+
+    // an iterator converts to a const_iterator
+    template <typename Other,
+              typename std::enable_if<std::is_convertible<Other*, Entry*>::value, int>::type = 0>
+    order_iterator(const order_iterator<Other>& other)
+        : slot_(other.slot_)
+    {}
+
+    reference operator*() const { return **slot_; }
+    pointer   operator->() const { return *slot_; }
+    reference operator[](difference_type n) const { return *slot_[n]; }
+
+    order_iterator& operator++() { return ++slot_, *this; }
+    order_iterator& operator--() { return --slot_, *this; }
+    order_iterator  operator++(int) { return order_iterator(slot_++); }
+    order_iterator  operator--(int) { return order_iterator(slot_--); }
+
+    order_iterator& operator+=(difference_type n) { return slot_ += n, *this; }
+    order_iterator& operator-=(difference_type n) { return slot_ -= n, *this; }
+
+    friend order_iterator operator+(order_iterator iter, difference_type n) { return iter += n; }
+    friend order_iterator operator+(difference_type n, order_iterator iter) { return iter += n; }
+    friend order_iterator operator-(order_iterator iter, difference_type n) { return iter -= n; }
+
+    friend difference_type operator-(const order_iterator& left, const order_iterator& right)
+    {
+      return left.slot_ - right.slot_;
+    }
+
+    friend bool operator==(const order_iterator& left, const order_iterator& right)
+    {
+      return left.slot_ == right.slot_;
+    }
+    friend bool operator!=(const order_iterator& left, const order_iterator& right)
+    {
+      return left.slot_ != right.slot_;
+    }
+    friend bool operator<(const order_iterator& left, const order_iterator& right)
+    {
+      return left.slot_ < right.slot_;
+    }
+    friend bool operator>(const order_iterator& left, const order_iterator& right)
+    {
+      return left.slot_ > right.slot_;
+    }
+    friend bool operator<=(const order_iterator& left, const order_iterator& right)
+    {
+      return left.slot_ <= right.slot_;
+    }
+    friend bool operator>=(const order_iterator& left, const order_iterator& right)
+    {
+      return left.slot_ >= right.slot_;
+    }
 
-  /*using local_iterator       = typename map_type::iterator;
-  using const_local_iterator = typename map_type::const_iterator;*/
+  private:
+    explicit order_iterator(value_type* const* slot)
+        : slot_(slot)
+    {}
+
+    value_type* const* slot_ = nullptr;
+  };
+
+public:
+  using iterator               = order_iterator<value_type>;
+  using const_iterator         = order_iterator<const value_type>;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
   using insert_return_type = std::pair<iterator, bool>;
 
+  /* the entries up to which a key is found by a linear scan, with no index */
+  static constexpr size_type index_threshold = 16;
+
+private:
+  /* the storage of an entry. while it holds none, it links the next free one */
+  union node {
+    node() {}
+    ~node() {}
+
+    value_type entry;
+    node*      next;
+  };
+
+  struct block
+  {
+    node*     nodes;
+    size_type count;
+  };
+
+  template <typename U>
+  using rebind_alloc = typename std::allocator_traits<allocator_type>::template rebind_alloc<U>;
+
+  using entry_traits = std::allocator_traits<allocator_type>;
+  using node_traits  = std::allocator_traits<rebind_alloc<node>>;
+  using order_type   = std::vector<pointer, rebind_alloc<pointer>>;
+  using blocks_type  = std::vector<block, rebind_alloc<block>>;
+  using index_type   = std::vector<size_type, rebind_alloc<size_type>>;
+
+  template <typename F>
+  using transparent_t = typename F::is_transparent;
+
+  /* a key of type K is looked up as is, when both the hash and the equality are transparent */
+  template <typename K>
+  using if_transparent =
+      typename std::enable_if<detail::is_detected<transparent_t, Hash>::value &&
+                                  detail::is_detected<transparent_t, KeyEqual>::value &&
+                                  !std::is_convertible<const K&, const_iterator>::value,
+                              int>::type;
 public:
   ordered_map() {}
 
-  ordered_map(size_type bucket_count)
-      : mapped_container_(bucket_count)
+  explicit ordered_map(const allocator_type& alloc)
+      : allocator_(alloc)
+      , order_(typename order_type::allocator_type(alloc))
+      , blocks_(typename blocks_type::allocator_type(alloc))
+      , index_(typename index_type::allocator_type(alloc))
   {}
 
+  ordered_map(size_type bucket_count) { reserve(bucket_count); }
+
   ordered_map(size_type bucket_count, const hasher& hash)
-      : mapped_container_(bucket_count, hash)
-  {}
+      : hash_(hash)
+  {
+    reserve(bucket_count);
+  }
 
   template <typename Iter>
   ordered_map(Iter first, Iter last)
-      : mapped_container_(first, last)
-      , linked_container_(first, last)
-  {}
+  {
+    insert(first, last);
+  }
 
-  ordered_map(std::initializer_list<value_type> ilist)
-      : mapped_container_(ilist)
-      , linked_container_(ilist)
-  {}
+  ordered_map(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
 
   ordered_map(const ordered_map& other)
+      : ordered_map(other,
+                    std::allocator_traits<allocator_type>::select_on_container_copy_construction(
+                        other.get_allocator()))
+  {}
+
+  ordered_map(const ordered_map& other, const allocator_type& alloc)
+      : ordered_map(alloc)
   {
-    mapped_container_.reserve(other.linked_container_.size());
-    insert(other.begin(), other.end());
+    copy_entries(other);
   }
 
   ordered_map(ordered_map&& other)
-      : mapped_container_(std::move(other.mapped_container_))
-      , linked_container_(std::move(other.linked_container_))
-  {}
+      : allocator_(other.allocator_)
+      , order_(std::move(other.order_))
+      , blocks_(std::move(other.blocks_))
+      , index_(std::move(other.index_))
+      , hash_(std::move(other.hash_))
+      , equal_(std::move(other.equal_))
+  {
+    std::swap(free_, other.free_);
+    std::swap(next_, other.next_);
+    std::swap(last_, other.last_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  // the entries are moved one by one to a different allocator
+  ordered_map(ordered_map&& other, const allocator_type& alloc)
+      : ordered_map(alloc)
+  {
+    if (alloc == other.get_allocator())
+      swap(other);
+    else
+      move_entries(other);
+  }
 
   inline ordered_map& operator=(const ordered_map& other)
   {
-    mapped_container_ = other.mapped_container_;
-    linked_container_ = other.linked_container_;
+    if (this != &other)
+    {
+      clear();
+      copy_entries(other);
+    }
 
     return *this;
   }
 
   inline ordered_map& operator=(ordered_map&& other)
   {
-    mapped_container_ = other.mapped_container_;
-    linked_container_ = other.linked_container_;
+    if (this != &other)
+    {
+      clear();
 
-    other.clear();
+      if (get_allocator() == other.get_allocator())
+        swap(other);
+      else
+        move_entries(other);
+    }
 
     return *this;
   }
 
-  ~ordered_map() { clear(); }
+  ~ordered_map()
+  {
+    clear();
+
+    rebind_alloc<node> alloc(allocator_);
+    for (auto& b : blocks_) node_traits::deallocate(alloc, b.nodes, b.count);
+  }
 
 public:
   inline T& operator[](const key_type& key) noexcept
   {
-    auto iter = find(key);
+    auto pos = lookup(key);
 
-    if (iter != end()) { return iter->second; }
+    if (pos != size()) { return order_[pos]->second; }
     else
     {
-      auto ret = emplace_hint(linked_container_.end(), key, T());
+      auto ret = emplace_hint(end(), key, T());
       return ret.first->second;
     }
   }
 
   inline T& operator[](key_type&& key) noexcept
   {
-    auto iter = find(key);
+    auto pos = lookup(key);
+
+    if (pos != size()) { return order_[pos]->second; }
+    else
+    {
+      auto ret = emplace_hint(end(), std::move(key), T());
+      return ret.first->second;
+    }
+  }
+
+  template <typename K, if_transparent<K> = 0>
+  inline T& operator[](const K& key) noexcept
+  {
+    auto pos = lookup(key);
 
-    if (iter != end()) { return iter->second; }
+    if (pos != size()) { return order_[pos]->second; }
     else
     {
-      auto ret = emplace_hint(linked_container_.end(), std::move(key), T());
+      auto ret = emplace_hint(
+          end(), std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple());
       return ret.first->second;
     }
   }
 
+  allocator_type get_allocator() const noexcept { return allocator_; }
+
 public:  // Capacity
-  inline bool empty() const noexcept { return linked_container_.empty(); }
+  inline bool empty() const noexcept { return order_.empty(); }
 
-  inline size_type size() const noexcept { return linked_container_.size(); }
+  inline size_type size() const noexcept { return order_.size(); }
 
-  inline iterator find(const key_type& key) noexcept
+  /* @brief: make room for cnt entries, no insertion up to them allocates */
+  void reserve(size_type cnt)
   {
-    auto iter = mapped_container_.find(key);
-    return iter != mapped_container_.end() ? iterator(iter->second) : linked_container_.end();
+    order_.reserve(cnt);
+    if (cnt > capacity_) grow(cnt - capacity_);
   }
 
-  inline const_iterator find(const key_type& key) const noexcept
+  inline iterator find(const key_type& key) noexcept { return begin() + lookup(key); }
+
+  inline const_iterator find(const key_type& key) const noexcept { return begin() + lookup(key); }
+
+  inline bool contains(const key_type& key) const noexcept { return lookup(key) != size(); }
+
+  template <typename K, if_transparent<K> = 0>
+  inline iterator find(const K& key) noexcept
   {
-    auto iter = mapped_container_.find(key);
-    return iter != mapped_container_.end() ? const_iterator(iter->second) : linked_container_.end();
+    return begin() + lookup(key);
   }
 
-  inline bool contains(const key_type& key) const noexcept
+  template <typename K, if_transparent<K> = 0>
+  inline const_iterator find(const K& key) const noexcept
   {
-    return mapped_container_.find(key) != mapped_container_.end();
+    return begin() + lookup(key);
   }
 
-public:  // Modifiers
-  inline void clear() noexcept
+  template <typename K, if_transparent<K> = 0>
+  inline bool contains(const K& key) const noexcept
   {
-    mapped_container_.clear();
-    linked_container_.clear();
+    return lookup(key) != size();
   }
 
-  inline void swap(ordered_map& other) noexcept
+  /* @brief: find a key whose hash_function() is computed already, with no hashing */
+  template <typename K, if_transparent<K> = 0>
+  inline iterator find(const K& key, size_type hash) noexcept
   {
-    mapped_container_.swap(other.mapped_container_);
-    linked_container_.swap(other.linked_container_);
+    return begin() + lookup(key, hash);
   }
 
-  inline insert_return_type insert(const value_type& value)
+  template <typename K, if_transparent<K> = 0>
+  inline const_iterator find(const K& key, size_type hash) const noexcept
   {
-    if (mapped_container_.find(value->first) == mapped_container_.end())
-    {
-      auto iter = linked_container_.insert(end(), value);
-      mapped_container_.emplace(iter->first, iter);
+    return begin() + lookup(key, hash);
+  }
 
-      return insert_return_type{iter, true};
-    }
+  hasher hash_function() const { return hash_; }
+
+public:  // Modifiers
+  /* @brief: erase all the entries, their storage is kept for the next ones */
+  inline void clear() noexcept
+  {
+    for (auto entry : order_) release_entry(entry);
 
-    return insert_return_type{find(value->first), false};
+    order_.clear();
+    index_.clear();
   }
 
-  inline insert_return_type insert(value_type&& value)
+  inline void swap(ordered_map& other) noexcept
   {
-    if (mapped_container_.find(value.first) == mapped_container_.end())
-    {
-      auto iter = linked_container_.insert(linked_container_.end(), std::move(value));
-      mapped_container_.emplace(iter->first, iter);
+    order_.swap(other.order_);
+    blocks_.swap(other.blocks_);
+    std::swap(free_, other.free_);
+    std::swap(next_, other.next_);
+    std::swap(last_, other.last_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+    index_.swap(other.index_);
+  }
 
-      return insert_return_type{iter, true};
-    }
+  inline insert_return_type insert(const value_type& value) { return emplace(value); }
 
-    return insert_return_type{find(value.first), false};
-  }
+  inline insert_return_type insert(value_type&& value) { return emplace(std::move(value)); }
 
   inline iterator insert(const_iterator pos, const value_type& value)
   {
-    iterator iter = find(value.first);
-
-    if (mapped_container_.find(value.first) == mapped_container_.end())
-    {
-      iter = linked_container_.insert(pos, value);
-      mapped_container_.emplace(iter->first, iter);
-    }
-
-    return iter;
+    return emplace_hint(pos, value).first;
   }
 
   inline iterator insert(const_iterator pos, value_type&& value)
   {
-    iterator iter = find(value.first);
-
-    if (mapped_container_.find(value.first) == mapped_container_.end())
-    {
-      iter = linked_container_.insert(pos, std::move(value));
-      mapped_container_.emplace(iter->first, iter);
-    }
-
-    return iter;
+    return emplace_hint(pos, std::move(value)).first;
   }
 
   template <class InputIt>
@@ -225,96 +416,134 @@ public:  // Modifiers
   template <class... Args>
   inline insert_return_type emplace(Args&&... args)
   {
-    return emplace_hint(linked_container_.end(), std::forward<Args&&>(args)...);
+    return emplace_hint(end(), std::forward<Args&&>(args)...);
   }
 
+  /*
+   * @brief: construct an entry before pos, unless its key is in the map already.
+   * the entry is constructed before it is looked up, as its key is only known then. the args may
+   * refer to an entry of the map, which no insertion moves.
+   */
   template <class... Args>
   inline insert_return_type emplace_hint(const_iterator pos, Args&&... args)
   {
-    auto iter       = linked_container_.emplace(pos, std::forward<Args&&>(args)...);
-    auto insert_ret = mapped_container_.emplace(iter->first, iter);
+    auto at = static_cast<size_type>(pos - begin());
 
-    if (!insert_ret.second) { linked_container_.erase(iter); }
+    // the order has room for the entry before it is constructed, nothing throws after
+    if (order_.size() == order_.capacity())
+      order_.reserve(std::max(order_.size() * 2, size_type(4)));
 
-    return {insert_ret.first->second, insert_ret.second};
+    pointer entry = allocate_entry();
+    entry_traits::construct(allocator_, entry, std::forward<Args&&>(args)...);
+
+    auto exist = lookup(entry->first);
+    if (exist != size())
+    {
+      release_entry(entry);
+      return {begin() + exist, false};
+    }
+
+    order_.insert(order_.begin() + at, entry);
+    if (at + 1 < size())
+      rebuild_index();
+    else
+      index_entry(at);
+
+    return {begin() + at, true};
   }
 
   inline size_type erase(const key_type& key)
   {
-    auto iter = mapped_container_.find(key);
-    if (iter != mapped_container_.end())
+    auto pos = lookup(key);
+    if (pos != size())
     {
-      linked_container_.erase(iter->second);
-      mapped_container_.erase(iter);
-
+      erase(begin() + pos);
       return 1;
     }
 
     return 0;
   }
 
-  inline iterator erase(iterator pos)
+  template <typename K, if_transparent<K> = 0>
+  inline size_type erase(const K& key)
   {
-    mapped_container_.erase(pos->first);
-    return linked_container_.erase(pos);
+    auto pos = lookup(key);
+    if (pos != size())
+    {
+      erase(begin() + pos);
+      return 1;
+    }
+
+    return 0;
   }
 
+  inline iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
   inline iterator erase(const_iterator pos)
   {
-    mapped_container_.erase(pos->first);
-    return linked_container_.erase(pos);
+    auto at = static_cast<size_type>(pos - begin());
+
+    release_entry(order_[at]);
+    order_.erase(order_.begin() + at);
+    rebuild_index();
+
+    return begin() + at;
   }
 
   void merge(ordered_map& source) noexcept
   {
-    auto iter = source.begin();
-    while (iter != source.end())
+    if (this == &source) return void();
+
+    // the entries left in source keep their order
+    auto last = source.order_.begin();
+    for (auto entry : source.order_)
     {
-      if (!contains(iter->first))
+      if (!contains(entry->first))
       {
-        insert(end(), *iter);
-        iter = source.erase(iter);
+        emplace(std::move(const_cast<key_type&>(entry->first)), std::move(entry->second));
+        source.release_entry(entry);
         continue;
       }
 
-      ++iter;
+      *last++ = entry;
     }
+
+    source.order_.erase(last, source.order_.end());
+    source.rebuild_index();
   }
 
   void merge(ordered_map&& source) noexcept
   {
-    auto iter = source.begin();
-    while (iter != source.end())
-    {
-      if (!contains(iter->first))
-      {
-        insert(end(), *iter);
-        // iter = source.erase(iter);
-        // continue;
-      }
+    if (this == &source) return void();
 
-      ++iter;
+    for (auto& entry : source)
+    {
+      if (!contains(entry.first))
+        emplace(std::move(const_cast<key_type&>(entry.first)), std::move(entry.second));
     }
 
     source.clear();
   }
 
 public:  // Iterators
-  inline iterator       begin() noexcept { return linked_container_.begin(); }
-  inline const_iterator begin() const noexcept { return linked_container_.cbegin(); }
-  inline const_iterator cbegin() const noexcept { return linked_container_.cbegin(); }
+  inline iterator       begin() noexcept { return iterator(order_.data()); }
+  inline const_iterator begin() const noexcept { return const_iterator(order_.data()); }
+  inline const_iterator cbegin() const noexcept { return begin(); }
 
-  inline iterator       end() noexcept { return linked_container_.end(); }
-  inline const_iterator end() const noexcept { return linked_container_.end(); }
-  inline const_iterator cend() const noexcept { return linked_container_.end(); }
+  inline iterator       end() noexcept { return iterator(order_.data() + order_.size()); }
+  inline const_iterator end() const noexcept
+  {
+    return const_iterator(order_.data() + order_.size());
+  }
+  inline const_iterator cend() const noexcept { return end(); }
 
-  inline reverse_iterator       rbegin() noexcept { return linked_container_.rbegin(); }
-  inline const_reverse_iterator rbegin() const noexcept { return linked_container_.rbegin(); }
-  inline const_reverse_iterator crbegin() const noexcept { return linked_container_.crbegin(); }
+  inline reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+  inline const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  inline const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
 
-  inline iterator       rend() noexcept { return linked_container_.rend(); }
-  inline const_iterator rend() const noexcept { return linked_container_.rend(); }
-  inline const_iterator crend() const noexcept { return linked_container_.crend(); }
+  inline reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+  inline const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+  inline const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
 
 public:
   friend bool operator==(const ordered_map& left, const ordered_map& right) noexcept
@@ -341,8 +570,166 @@ public:
   }
 
 private:
-  map_type  mapped_container_;
-  link_type linked_container_;
+  /* @ret: the position of the entry of key, size() if there is none */
+  template <typename K>
+  size_type lookup(const K& key) const noexcept
+  {
+    return index_.empty() ? scan(key) : probe(key, hash_(key));
+  }
+
+  template <typename K>
+  size_type lookup(const K& key, size_type hash) const noexcept
+  {
+    return index_.empty() ? scan(key) : probe(key, hash);
+  }
+
+  template <typename K>
+  size_type scan(const K& key) const noexcept
+  {
+    for (size_type i = 0; i < order_.size(); ++i)
+      if (equal_(order_[i]->first, key)) return i;
+
+    return order_.size();
+  }
+
+  template <typename K>
+  size_type probe(const K& key, size_type hash) const noexcept
+  {
+    const size_type mask = index_.size() - 1;
+    for (auto slot = hash & mask; index_[slot]; slot = (slot + 1) & mask)
+    {
+      if (equal_(order_[index_[slot] - 1]->first, key)) return index_[slot] - 1;
+    }
+
+    return order_.size();
+  }
+
+  /* @brief: add the entry at pos, the last one, to the index */
+  void index_entry(size_type pos)
+  {
+    if (index_.empty() ? size() > index_threshold : size() * 2 > index_.size())
+      rebuild_index();
+    else if (!index_.empty())
+      place_index(pos);
+  }
+
+  /*
+   * @brief: index all the entries again, after their positions changed. the index has no more
+   * than half of its slots used, a slot is the position of an entry plus one, 0 for a free slot.
+   */
+  void rebuild_index()
+  {
+    index_.clear();
+    if (size() <= index_threshold) return void();
+
+    size_type slots = index_threshold * 2;
+    while (slots < size() * 2) slots *= 2;
+
+    index_.resize(slots, 0);
+    for (size_type pos = 0; pos < size(); ++pos) place_index(pos);
+  }
+
+  void place_index(size_type pos)
+  {
+    const size_type mask = index_.size() - 1;
+
+    auto slot = hash_(order_[pos]->first) & mask;
+    while (index_[slot]) slot = (slot + 1) & mask;
+
+    index_[slot] = pos + 1;
+  }
+
+  /* @brief: the storage of a new entry, an erased one or the next of the last block */
+  pointer allocate_entry()
+  {
+    if (free_)
+    {
+      node* n = free_;
+      free_   = n->next;
+      return std::addressof(n->entry);
+    }
+
+    if (next_ == last_) grow(std::max(capacity_, size_type(4)));
+    return std::addressof((next_++)->entry);
+  }
+
+  /* @brief: destroy the entry, its storage is linked to the free ones */
+  void release_entry(pointer entry) noexcept
+  {
+    entry_traits::destroy(allocator_, entry);
+
+    node* n = reinterpret_cast<node*>(entry);
+    n->next = free_;
+    free_   = n;
+  }
+
+  /* @brief: a new block of cnt entries at least, the rest of the last one is linked as free */
+  void grow(size_type cnt)
+  {
+    rebind_alloc<node> alloc(allocator_);
+
+    blocks_.reserve(blocks_.size() + 1);
+    node* nodes = node_traits::allocate(alloc, cnt);
+    blocks_.push_back({nodes, cnt});
+
+    for (; next_ != last_; ++next_)
+    {
+      next_->next = free_;
+      free_       = next_;
+    }
+
+    next_ = nodes;
+    last_ = nodes + cnt;
+    capacity_ += cnt;
+  }
+
+  void copy_entries(const ordered_map& other)
+  {
+    hash_  = other.hash_;
+    equal_ = other.equal_;
+
+    reserve(other.size());
+    for (auto source : other.order_)
+    {
+      pointer entry = allocate_entry();
+      entry_traits::construct(allocator_, entry, *source);
+      order_.push_back(entry);
+    }
+
+    index_ = other.index_;
+  }
+
+  void move_entries(ordered_map& other)
+  {
+    reserve(other.size());
+    for (auto source : other.order_)
+    {
+      pointer entry = allocate_entry();
+      entry_traits::construct(allocator_,
+                              entry,
+                              std::move(const_cast<key_type&>(source->first)),
+                              std::move(source->second));
+      order_.push_back(entry);
+    }
+
+    index_ = other.index_;
+    other.clear();
+  }
+
+private:
+  allocator_type allocator_;
+
+  order_type  order_;   // the entries, in the order of insertion
+  blocks_type blocks_;  // the storage of the entries
+
+  node*     free_     = nullptr;  // the storage of an erased entry, linked to the next one
+  node*     next_     = nullptr;  // the storage of the last block not used yet, to last_
+  node*     last_     = nullptr;
+  size_type capacity_ = 0;  // the entries of all the blocks
+
+  index_type index_;
+  hasher     hash_;
+  key_equal  equal_;
 };
 
-FORMATS_NAMESPACE_END
\ No newline at end of file
+FORMATS_NAMESPACE_END
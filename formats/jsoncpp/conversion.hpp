@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string_view>
+
 #include <formats/common/type_traits.hpp>
 #include <formats/common/reflection/reflection.hpp>
 #include <formats/jsoncpp/detail/detector.hpp>
@@ -7,59 +9,116 @@
 
 FORMATS_JSON_NAMESPACE_BEGIN
 
-template <typename T>
-void from_json(const value& js, T& t);
+template <typename T, typename Allocator>
+void from_json(const basic_value<Allocator>& js, T& t);
 
 template <typename T>
 value to_json(const T& t);
 
+template <typename Value, typename T>
+Value to_json(const T& t, const typename Value::allocator_type& alloc);
+
 namespace impl
 {
 using namespace formats;
 
+/* the custom types convert from a json::value, a value of another allocator is copied to one */
+inline const value& as_value(const value& js)
+{
+  return js;
+}
+
+template <typename Allocator>
+value as_value(const basic_value<Allocator>& js)
+{
+  return value(js);
+}
+
+/* a string of the same type is moved, of another allocator is copied */
+template <typename String>
+void assign_string(String& t, String&& s)
+{
+  t = std::move(s);
+}
+
+template <typename String, typename Other>
+void assign_string(String& t, const Other& s)
+{
+  t.assign(s.data(), s.size());
+}
+
 template <typename T, typename Enable = void>
 struct unserializer {};
 
 template <typename T>
 struct unserializer<T, typename std::enable_if<std::is_same<T, bool>::value>::type> {
-  static void from_json(const value& js, T& t) { t = js.to_bool(); }
+  template <typename Value>
+  static void from_json(const Value& js, T& t)
+  {
+    t = js.to_bool();
+  }
 };
 
 template <typename T>
-struct unserializer<T, typename std::enable_if<std::is_same<T, std::string>::value>::type> {
-  static void from_json(const value& js, T& t) { t = js.to_string(); }
+struct unserializer<T, typename std::enable_if<formats::detail::is_string_v<T>>::type> {
+  template <typename Value>
+  static void from_json(const Value& js, T& t)
+  {
+    assign_string(t, js.to_string());
+  }
 };
 
 template <typename T>
 struct unserializer<T, typename std::enable_if<formats::detail::is_signed_integer_v<T>>::type> {
-  static void from_json(const value& js, T& t) { t = static_cast<T>(js.to_int64()); }
+  template <typename Value>
+  static void from_json(const Value& js, T& t)
+  {
+    t = static_cast<T>(js.to_int64());
+  }
 };
 
 template <typename T>
 struct unserializer<T, typename std::enable_if<formats::detail::is_unsigned_integer_v<T>>::type> {
-  static void from_json(const value& js, T& t) { t = static_cast<T>(js.to_uint64()); }
+  template <typename Value>
+  static void from_json(const Value& js, T& t)
+  {
+    t = static_cast<T>(js.to_uint64());
+  }
 };
 
 template <typename T>
 struct unserializer<T, typename std::enable_if<formats::detail::is_float_v<T>>::type> {
-  static void from_json(const value& js, T& t) { t = static_cast<T>(js.to_double()); }
+  template <typename Value>
+  static void from_json(const Value& js, T& t)
+  {
+    t = static_cast<T>(js.to_double());
+  }
 };
 
 template <typename T>
 struct unserializer<T, typename std::enable_if<formats::json::has_member_from_json_v<T>>::type> {
-  static void from_json(const value& js, T& t) { t.from_json(js); }
+  template <typename Value>
+  static void from_json(const Value& js, T& t)
+  {
+    t.from_json(as_value(js));
+  }
 };
 
 template <typename T>
 struct unserializer<T, typename std::enable_if<formats::json::has_global_from_json_v<T>>::type> {
-  static void from_json(const value& js, T& t) { adl_serializer<T>::from_json(js, t); }
+  template <typename Value>
+  static void from_json(const Value& js, T& t)
+  {
+    adl_serializer<T>::from_json(as_value(js), t);
+  }
 };
 
 template <typename T>
 struct unserializer<
     T,
     typename std::enable_if<formats::detail::is_unmapped_emplace_container_v<T>>::type> {
-  static void from_json(const value& jv, T& t)
+  template <typename Value>
+  static void from_json(const Value& jv, T& t)
   {
     using value_type = typename T::value_type;
 
@@ -79,7 +138,8 @@ template <typename T>
 struct unserializer<
     T,
     typename std::enable_if<formats::detail::is_unmapped_emplace_back_container_v<T>>::type> {
-  static void from_json(const value& jv, T& t)
+  template <typename Value>
+  static void from_json(const Value& jv, T& t)
   {
     using value_type = typename T::value_type;
 
@@ -97,7 +157,8 @@ struct unserializer<
 
 template <typename T>
 struct unserializer<T, typename std::enable_if<formats::detail::is_mapped_container_v<T>>::type> {
-  static void from_json(const value& jv, T& t)
+  template <typename Value>
+  static void from_json(const Value& jv, T& t)
   {
     using value_type = typename T::mapped_type;
 
@@ -108,40 +169,65 @@ struct unserializer<T, typename std::enable_if<formats::detail::is_mapped_contai
       value_type v;
       unserializer<value_type>::from_json(entry.second, v);
 
-      t.emplace(entry.first, v);
+      t.emplace(std::string_view(entry.first), v);
     }
-  };
+  }
 };
 
 template <typename T, typename Enable = void>
 struct serializer {};
 
 template <typename T>
-struct serializer<T, typename std::enable_if<formats::detail::is_scaler<T>::value>::type> {
-  static value to_json(const T& t) { return value(t); }
+struct serializer<T,
+                  typename std::enable_if<formats::detail::is_scaler<T>::value &&
+                                          !formats::detail::is_string_v<T>>::type> {
+  template <typename Value>
+  static Value to_json(const T& t, const typename Value::allocator_type& alloc)
+  {
+    return Value(t, alloc);
+  }
+};
+
+template <typename T>
+struct serializer<T, typename std::enable_if<formats::detail::is_string_v<T>>::type> {
+  template <typename Value>
+  static Value to_json(const T& t, const typename Value::allocator_type& alloc)
+  {
+    return Value(typename Value::string_t(t.data(), t.size(), alloc), alloc);
+  }
 };
 
 template <typename T>
 struct serializer<T, typename std::enable_if<has_member_to_json_v<T>>::type> {
-  static value to_json(const T& t) { return t.to_json(); }
+  template <typename Value>
+  static Value to_json(const T& t, const typename Value::allocator_type& alloc)
+  {
+    return Value(t.to_json(), alloc);
+  }
 };
 
 template <typename T>
 struct serializer<T, typename std::enable_if<has_global_to_json_v<T>>::type> {
-  static value to_json(const T& t) { return adl_serializer<T>::to_json(t); }
+  template <typename Value>
+  static Value to_json(const T& t, const typename Value::allocator_type& alloc)
+  {
+    return Value(adl_serializer<T>::to_json(t), alloc);
+  }
 };
 
 template <typename T>
 struct serializer<
     T,
     typename std::enable_if<formats::detail::is_unmapped_traversable_container_v<T>>::type> {
-  static value to_json(const T& t)
+  template <typename Value>
+  static Value to_json(const T& t, const typename Value::allocator_type& alloc)
   {
-    json::value result = json::kind::array;
+    Value result(json::kind::array, alloc);
 
     for (const auto& element : t)
     {
-      result.emplace_back(serializer<typename T::value_type>::to_json(element));
+      result.emplace_back(
+          serializer<typename T::value_type>::template to_json<Value>(element, alloc));
     }
 
     return result;
@@ -153,14 +239,20 @@ struct serializer<T,
                   typename std::enable_if<
                       formats::detail::is_mapped_container_v<T> &&
                       std::is_constructible<std::string, typename T::key_type>::value>::type> {
-  static value to_json(const T& t)
+  template <typename Value>
+  static Value to_json(const T& t, const typename Value::allocator_type& alloc)
   {
-    json::value result = json::kind::object;
+    using mapped_type = typename T::mapped_type;
+
+    Value result(json::kind::object, alloc);
 
     for (const auto& entry : t)
     {
-      result.emplace(std::string(entry.first),
-                     serializer<typename T::mapped_type>::to_json(entry.second));
+      typename Value::string_t key(alloc);
+      key.assign(std::string(entry.first));
+
+      result.emplace(std::move(key),
+                     serializer<mapped_type>::template to_json<Value>(entry.second, alloc));
     }
 
     return result;
@@ -169,8 +261,8 @@ struct serializer<T,
 
 }  // namespace impl
 
-template <typename T>
-void from_json(const value& js, T& t)
+template <typename T, typename Allocator>
+void from_json(const basic_value<Allocator>& js, T& t)
 {
   impl::unserializer<T>::from_json(js, t);
 }
@@ -178,7 +270,17 @@ void from_json(const value& js, T& t)
 template <typename T>
 value to_json(const T& t)
 {
-  return impl::serializer<T>::to_json(t);
+  return impl::serializer<T>::template to_json<value>(t, value::allocator_type());
+}
+
+/*
+ * @brief: convert t to a json value of type Value, such as json::pmr::value. its strings, arrays
+ * and objects are allocated by alloc.
+ */
+template <typename Value, typename T>
+Value to_json(const T& t, const typename Value::allocator_type& alloc)
+{
+  return impl::serializer<T>::template to_json<Value>(t, alloc);
 }
 
 FORMATS_JSON_NAMESPACE_END
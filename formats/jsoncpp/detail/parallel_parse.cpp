@@ -0,0 +1,71 @@
+#include <formats/jsoncpp/detail/parallel_parse.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <formats/jsoncpp/detail/parser.hpp>
+#include <formats/jsoncpp/detail/structural_index.hpp>
+#include <formats/jsoncpp/detail/thread_pool.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace detail
+{
+value parse_parallel(const char* begin, const char* end, error& error, size_t threads)
+{
+  if (threads == 0) threads = thread_pool::hardware_threads();
+
+  size_t length = end - begin;
+  if (threads < 2 || length < parallel_min_length)
+    return parser().parse(begin, end, error, parse_flag::strict);
+
+  // a few chunks per thread even out the elements which take longer
+  size_t              chunk = std::max(length / (threads * 4), parallel_min_chunk);
+  std::vector<size_t> splits;
+  if (!split_array(begin, end, chunk, splits) || splits.size() < 3)
+    return parser().parse(begin, end, error, parse_flag::strict);
+
+  size_t                      count = splits.size() - 1;
+  std::vector<value::array_t> fragments(count);
+  std::unique_ptr<bool[]>     parsed(new bool[count]());
+
+  {
+    thread_pool                    pool(std::min(threads, count));
+    std::vector<std::future<void>> futures;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      futures.push_back(pool.submit([&, i] {
+        json::error ignored;
+        parsed[i] = parser().parse_elements(begin + splits[i] + 1, begin + splits[i + 1], end,
+                                            fragments[i], ignored);
+      }));
+    }
+
+    for (auto& future : futures) future.get();
+  }
+
+  // a chunk does not know its line, and its error may not be the first of the document
+  if (!std::all_of(parsed.get(), parsed.get() + count, [](bool ok) { return ok; }))
+    return parser().parse(begin, end, error, parse_flag::strict);
+
+  size_t total = 0;
+  for (auto& fragment : fragments) total += fragment.size();
+
+  value::array_t array(std::move(fragments[0]));
+  array.reserve(total);
+
+  for (size_t i = 1; i < count; ++i)
+  {
+    for (auto& element : fragments[i]) array.emplace_back(std::move(element));
+    fragments[i].clear();
+  }
+
+  return value(std::move(array));
+}
+
+}  // namespace detail
+
+FORMATS_JSON_NAMESPACE_END
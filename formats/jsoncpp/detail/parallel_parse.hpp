@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+
+#include <formats/jsoncpp/value.hpp>
+#include <formats/jsoncpp/error.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace detail
+{
+/* documents shorter than this are parsed on the calling thread, a split would cost more */
+constexpr size_t parallel_min_length = 1024 * 1024;
+
+/* the elements of a root array are parsed by chunks of this size at least */
+constexpr size_t parallel_min_chunk = 256 * 1024;
+
+/*
+ * @brief: parse a strict document whose root is an array on threads. the root is split between its
+ * elements, the chunks are parsed into fragments by a pool of threads and spliced in order.
+ * another root, a short document or a chunk which fails is parsed by parse() on the calling thread,
+ * so the value and the error, with its position, are those of parse().
+ * @param[threads]: the count of threads, 0 for one per hardware thread.
+ */
+value parse_parallel(const char* begin, const char* end, error& error, size_t threads);
+
+}  // namespace detail
+
+FORMATS_JSON_NAMESPACE_END
@@ -6,13 +6,14 @@
 #include <formats/common/cctypes.hpp>
 #include <formats/common/number.hpp>
 #include <formats/common/unicode/unicode.hpp>
+#include <formats/common/simd/simd.hpp>
 
 FORMATS_JSON_NAMESPACE_BEGIN
 
 namespace detail
 {
 // clang-format off
-#define json_parse_flag(__flag) (((unsigned long long)flag & (unsigned long long)__flag) == (unsigned long long)__flag)
+#define json_parse_flag(__flag) has_flag<Flags>(flag, __flag)
 
 
 #define parse_array_trailing_comma   json_parse_flag(parse_flag::array_trailing_comma)
@@ -40,267 +41,1010 @@ namespace detail
 #define none_error (error_.code_ == error_code::none)
 // clang-format on
 
+/* @ret: whether the kernel of Flags has the flag, any_flags tests the flag the parser is given */
+template <parse_flag Flags>
+constexpr bool has_flag(parse_flag given, parse_flag test)
+{
+  auto flags = (unsigned long long)(Flags == any_flags ? given : Flags);
+  return (flags & (unsigned long long)test) == (unsigned long long)test;
+}
+
+/* the code of four hex digits, above 0xFFFF if one of them is not a hex digit */
 unsigned long hex_code_point(const char* ptr)
 {
   unsigned long code = 0;
 
-  for (int i = 0; i < 4; ++i)
-  {
-    code = (code << 4) + char_to_num(*(ptr + i));
+  for (int i = 0; i < 4; ++i)
+  {
+    char num = char_to_num(*(ptr + i));
+    if (num < 0) return 0x10000;
+
+    code = (code << 4) + num;
+  }
+
+  return code;
+}
+
+int count_line_terminators(const char* begin, const char* end)
+{
+  int lines = 0;
+
+  for (auto ptr = begin; ptr < end; ++ptr)
+  {
+    if (*ptr == c_line_feed)
+      ++lines;
+    else if (*ptr == c_carriage_return && (ptr + 1 == end || *(ptr + 1) != c_line_feed))
+      ++lines;
+  }
+
+  return lines;
+}
+
+/*
+ * the text of a string parsed in situ. it is a span of the input while the parts appended are
+ * contiguous, as they are unless an escape changes the text. it is copied to a buffer then.
+ */
+class insitu_string
+{
+public:
+  explicit insitu_string(std::string& buffer)
+      : buffer_(buffer)
+  {}
+
+  void append(const char* s, std::size_t n)
+  {
+    if (!copied_)
+    {
+      if (!data_) data_ = s;
+      if (s == data_ + size_)
+      {
+        size_ += n;
+        return void();
+      }
+
+      copy();
+    }
+
+    buffer_.append(s, n);
+  }
+
+  void append(std::size_t n, char c)
+  {
+    copy();
+    buffer_.append(n, c);
+  }
+
+  void append(const char* s)
+  {
+    copy();
+    buffer_.append(s);
+  }
+
+  void append(const std::string& s)
+  {
+    copy();
+    buffer_.append(s);
+  }
+
+  bool             copied() const noexcept { return copied_; }
+  std::string_view view() const noexcept
+  {
+    return copied_ ? std::string_view(buffer_) : std::string_view(data_, size_);
+  }
+
+private:
+  void copy()
+  {
+    if (copied_) return void();
+
+    buffer_.assign(data_ ? data_ : "", size_);
+    copied_ = true;
+  }
+
+private:
+  std::string& buffer_;
+  const char*  data_   = nullptr;
+  std::size_t  size_   = 0;
+  bool         copied_ = false;
+};
+
+value parser::parse(const char* begin, const char* end, error& error, parse_flag flag)
+{
+  value val;
+  parse(begin, end, val, error, flag);
+
+  return val;
+}
+
+value parser::parse(const char* begin, std::size_t len, error& error, parse_flag flag)
+{
+  return (begin && len) ? parse(begin, begin + len, error, flag) : value();
+}
+
+value parser::parse(std::istream& is, error& error, parse_flag flag)
+{
+  value val;
+  parse(is, val, error, flag);
+
+  return val;
+}
+
+template <typename Allocator>
+void parser::parse(const char*             begin,
+                   const char*             end,
+                   basic_value<Allocator>& v,
+                   error&                  error,
+                   parse_flag              flag)
+{
+  if (!begin || !end || begin >= end)
+  {
+    v = nullptr;
+    return void();
+  }
+
+  // a value reused keeps its containers and strings, they are overwritten in place
+  if (!reuse_) v = nullptr;
+
+  this->begin_ = begin;
+  this->ptr_   = begin;
+  this->end_   = end;
+  this->flag   = flag;
+
+  if (!parse(v))
+  {
+    v     = kind::error;
+    error = error_;
+  }
+}
+
+template <typename Allocator>
+void parser::parse_insitu(char*                   begin,
+                          char*                   end,
+                          basic_value<Allocator>& v,
+                          error&                  error,
+                          parse_flag              flag)
+{
+  insitu_ = true;
+  parse(begin, end, v, error, flag);
+  insitu_ = false;
+}
+
+template <typename Allocator>
+void parser::parse(std::istream& is, basic_value<Allocator>& v, error& error, parse_flag flag)
+{
+  if (is.bad() || is.eof())
+  {
+    v = nullptr;
+    return void();
+  }
+
+  if (!reuse_) v = nullptr;
+
+  {
+    window_.open(is);
+
+    this->begin_ = window_.begin();
+    this->ptr_   = window_.begin();
+    this->end_   = window_.end();
+    this->flag   = flag;
+  }
+
+  if (!parse(v))
+  {
+    v     = kind::error;
+    error = error_;
+  }
+
+  window_.close();
+}
+
+value parser::parse_indexed(const char* begin, const char* end, error& error)
+{
+  if (!begin || !end || begin >= end) return value();
+
+  // offsets of the index are 32 bits, longer documents go to the one stage parser
+  if ((size_t)(end - begin) > structural_index::max_length)
+    return parse(begin, end, error, parse_flag::strict);
+
+  this->begin_ = begin;
+  this->ptr_   = begin;
+  this->end_   = end;
+  this->flag   = parse_flag::strict;
+
+  value val;
+  if (!parse_indexed(val))
+  {
+    val   = kind::error;
+    error = error_;
+  }
+
+  index_base_ = nullptr;
+  return val;
+}
+
+bool parser::index(const char* begin, const char* end, error& error)
+{
+  this->begin_ = begin;
+  this->ptr_   = begin;
+  this->end_   = end;
+  this->flag   = parse_flag::strict;
+
+  if (!begin || !end || begin >= end)
+  {
+    throw_error(error_code::missing_begin_object_array);
+    error = error_;
+    return false;
+  }
+
+  if ((end_ - ptr_ >= 3) && unicode::start_with_u8bom(ptr_, end_)) skip_multi_bytes(3);
+
+  index_base_ = ptr_;
+
+  if (!index_.build(ptr_, end_))
+  {
+    throw_error(error_code::illeagl_character, "document too long to index");
+    error = error_;
+    return false;
+  }
+
+  index_ptr_ = index_.begin();
+  index_end_ = index_.end();
+
+  if (!next_indexed() || (*ptr_ != c_object_begin && *ptr_ != c_array_begin))
+  {
+    throw_error(error_code::missing_begin_object_array);
+    error = error_;
+    return false;
+  }
+
+  return true;
+}
+
+bool parser::parse_indexed_at(const uint32_t* pos, value& v, error& error)
+{
+  error_.code_ = error_code::none;
+  error_.message_.clear();
+
+  depth_     = 0;
+  ptr_       = index_base_ + *pos;
+  index_ptr_ = pos + 1;
+  index_end_ = index_.end();
+
+  // a scalar ends right before the next structural character, or white space
+  if (!parse_indexed_value(v) || (!next_indexed() && ptr_ != end_))
+  {
+    if (none_error) throw_error(error_code::illeagl_character, "illeagl value");
+
+    v     = kind::error;
+    error = error_;
+    return false;
+  }
+
+  return true;
+}
+
+const char* parser::parse_number(const char* begin, const char* end, value& v, error& error)
+{
+  this->begin_ = begin;
+  this->ptr_   = begin;
+  this->end_   = end;
+  this->flag   = parse_flag::strict;
+
+  error_.code_ = error_code::none;
+
+  if (!parse_value_number<parse_flag::strict>(v))
+  {
+    error = error_;
+    return nullptr;
+  }
+
+  return ptr_;
+}
+
+bool parser::parse(const char* begin, const char* end, sax& handler, error& error,
+                   parse_flag flag)
+{
+  this->begin_ = begin;
+  this->ptr_   = begin;
+  this->end_   = end;
+  this->flag   = flag;
+  this->sax_   = &handler;
+
+  restart();
+
+  bool result = false;
+  if (begin && end && begin < end)
+  {
+    if (flag == parse_flag::strict)
+      result = parse_sax<parse_flag::strict>();
+    else if (flag == parse_flag::JSON5)
+      result = parse_sax<parse_flag::JSON5>();
+    else
+      result = parse_sax<any_flags>();
+  }
+
+  if (!result)
+  {
+    if (none_error) throw_error(error_code::missing_begin_object_array);
+    error = error_;
+  }
+
+  sax_ = nullptr;
+  return result;
+}
+
+bool parser::parse_elements(const char* begin, const char* stop, const char* end,
+                            value::array_t& elements, error& error)
+{
+  this->begin_ = begin;
+  this->ptr_   = begin;
+  this->end_   = end;
+  this->flag   = parse_flag::strict;
+
+  restart();
+
+  // the elements are inside the root array
+  depth_ = 1;
+
+  while (true)
+  {
+    if (!skip_space_and_comments<parse_flag::strict>() || ptr_ >= stop) break;
+    if (!parse_value<parse_flag::strict>(elements.emplace_back(nullptr))) break;
+    if (!skip_space_and_comments<parse_flag::strict>() || ptr_ > stop) break;
+
+    if (ptr_ == stop) return true;
+    if (*ptr_ != c_value_separator) break;
+
+    skip_multi_bytes(1);
+  }
+
+  if (none_error) throw_error(error_code::missing_end_array);
+  error = error_;
+
+  return false;
+}
+
+template <typename Value>
+bool parser::parse(Value& v)
+{
+  // the strict grammar and JSON5 have kernels of their own, which test no flag on the way
+  if (flag == parse_flag::strict) return parse_document<parse_flag::strict>(v);
+  if (flag == parse_flag::JSON5) return parse_document<parse_flag::JSON5>(v);
+
+  return parse_document<any_flags>(v);
+}
+
+template <parse_flag Flags, typename Value>
+bool parser::parse_document(Value& v)
+{
+  restart();
+
+  if ((end_ - ptr_ >= 3) && unicode::start_with_u8bom(ptr_, end_)) skip_multi_bytes(3);
+
+  if (skip_space_and_comments<Flags>())
+  {
+    if (*ptr_ == c_object_begin || *ptr_ == c_array_begin)
+      return parse_container<Flags>(v) && parse_document_end<Flags>();
+
+    // JSON5 top level can be a value
+    if (parse_lenient_root)
+    {
+      v = nullptr;
+      return parse_root_value<Flags>(v) && parse_document_end<Flags>();
+    }
+  }
+
+  throw_error(error_code::missing_begin_object_array);
+  return false;
+}
+
+template <parse_flag Flags>
+bool parser::parse_document_end()
+{
+  if (!single_root_ || !skip_space_and_comments<Flags>()) return true;
+
+  throw_error(error_code::illeagl_character, "surplus value after the root");
+  return false;
+}
+
+template <parse_flag Flags, typename Value>
+bool parser::parse_root_value(Value& v)
+{
+  if (*ptr_ == c_double_quotes)
+    parse_value_string<Flags>(v);
+  else if (*ptr_ == c_single_quotes)
+    parse_value_string<Flags>(v);
+  else if (leading_unquoted(*ptr_) && parse_unquoted_string)
+    parse_value_unquoted<Flags>(v);
+  else if (leading_number(*ptr_))
+    parse_value_number<Flags>(v);
+  else if (*ptr_ == c_letter_n)
+    parse_value_null(v);
+  else if (*ptr_ == c_letter_t)
+    parse_value_true(v);
+  else if (*ptr_ == c_letter_f)
+    parse_value_false(v);
+  else if (*ptr_ == c_letter_N)
+    parse_value_nan(v);
+  else if (*ptr_ == c_letter_I)
+    parse_value_infinity(v);
+  else
+  {
+    throw_error(error_code::missing_begin_object_array);
+    return false;
+  }
+
+  skip_space_and_comments<Flags>();
+  return none_error;
+}
+
+template <parse_flag Flags>
+bool parser::parse_sax()
+{
+  if ((end_ - ptr_ >= 3) && unicode::start_with_u8bom(ptr_, end_)) skip_multi_bytes(3);
+
+  if (skip_space_and_comments<Flags>())
+  {
+    if (*ptr_ == c_object_begin || *ptr_ == c_array_begin) return sax_container<Flags>();
+
+    if (parse_lenient_root)
+    {
+      value v;
+      return parse_root_value<Flags>(v) && sax_scalar(v);
+    }
+  }
+
+  throw_error(error_code::missing_begin_object_array);
+  return false;
+}
+
+bool parser::sax_event(bool result)
+{
+  if (!result) throw_error(error_code::aborted);
+
+  return result;
+}
+
+bool parser::sax_scalar(value& v)
+{
+  switch (v.kind_)
+  {
+    case kind::null: return sax_event(sax_->null());
+    case kind::boolean: return sax_event(sax_->boolean(v.data_.v_bool_));
+    case kind::number_int: return sax_event(sax_->number_int(v.data_.v_int_));
+    case kind::number_uint: return sax_event(sax_->number_uint(v.data_.v_uint_));
+    case kind::number_float: return sax_event(sax_->number_float(v.data_.v_double_));
+    case kind::string: return sax_event(sax_->string(*v.data_.v_string_));
+
+    default: return false;
+  }
+}
+
+template <parse_flag Flags>
+bool parser::sax_object_element()
+{
+  sax_buffer_.clear();
+  if (!parse_key<Flags>(sax_buffer_) || !skip_space_and_comments<Flags>()) return false;
+
+  if (*ptr_ != c_name_separator)
+  {
+    throw_error(error_code::missing_name_separator);
+    return false;
+  }
+
+  ++ptr_;
+
+  if (skip_space_and_comments<Flags>()) return sax_event(sax_->key(sax_buffer_));
+
+  throw_error(error_code::illeagl_character, "expecte object value");
+  return false;
+}
+
+template <parse_flag Flags>
+bool parser::sax_container()
+{
+  stack_.clear();
+  if (!sax_open_container()) return false;
+
+  bool has_trailing_comma = false;  // the last token is `,`, the end may not follow it
+  bool has_element        = false;  // the last token ends an element, `,` or the end follows it
+
+  while (skip_space_and_comments<Flags>())
+  {
+    bool          is_object = stack_.back().is_object;
+    unsigned char c         = *ptr_;
+
+    if (c == (is_object ? c_object_end : c_array_end))
+    {
+      if (has_trailing_comma &&
+          !(is_object ? parse_object_trailing_comma : parse_array_trailing_comma))
+      {
+        throw_error(error_code::surplus_trailing_comma);
+        return false;
+      }
+
+      skip_multi_bytes(1);
+      stack_.pop_back();
+      if (!sax_event(is_object ? sax_->end_object() : sax_->end_array())) return false;
+      if (stack_.empty()) return true;
+
+      has_trailing_comma = false;
+      has_element        = true;
+      continue;
+    }
+
+    if (has_element)
+    {
+      if (c != c_value_separator) break;
+
+      skip_multi_bytes(1);
+      has_trailing_comma = true;
+      has_element        = false;
+      continue;
+    }
+
+    if (is_object)
+    {
+      bool has_key = false;
+      if (likely(c == c_double_quotes) || (c == c_single_quotes && parse_single_quotes) ||
+          (leading_unquoted(c) && parse_unquoted_string))
+        has_key = sax_object_element<Flags>();
+      else
+        throw_error(error_code::missing_quotation_mark);
+
+      if (!has_key)
+      {
+        if (none_error) throw_error(error_code::missing_end_object);
+        return false;
+      }
+    }
+
+    has_trailing_comma = false;
+    has_element        = true;
+
+    c = *ptr_;
+    if (c == c_object_begin || c == c_array_begin)
+    {
+      if (!sax_open_container()) return false;
+      has_element = false;
+    }
+    else if (!sax_value<Flags>() || !none_error)
+      return false;
+  }
+
+  if (none_error)
+    throw_error(stack_.back().is_object ? error_code::missing_end_object
+                                        : error_code::missing_end_array);
+  return false;
+}
+
+bool parser::sax_open_container()
+{
+  if (depth_ + stack_.size() >= max_depth_)
+  {
+    throw_error(error_code::too_deep);
+    return false;
+  }
+
+  bool is_object = (*ptr_ == c_object_begin);
+
+  skip_multi_bytes(1);
+  stack_.push_back({nullptr, 0, is_object});
+
+  return sax_event(is_object ? sax_->start_object() : sax_->start_array());
+}
+
+template <parse_flag Flags>
+bool parser::sax_value()
+{
+  unsigned char c = *ptr_;
+
+  // a scalar, the containers are opened by sax_container(). quoted strings go to the reused
+  // buffer, the other scalars are values without storage
+  if (likely(c == c_double_quotes) || (c == c_single_quotes && parse_single_quotes))
+  {
+    sax_buffer_.clear();
+    return parse_string_quoted<Flags>(sax_buffer_) && sax_event(sax_->string(sax_buffer_));
+  }
+
+  value v;
+  return parse_value<Flags>(v) && sax_scalar(v);
+}
+
+bool parser::parse_indexed(value& v)
+{
+  if ((end_ - ptr_ >= 3) && unicode::start_with_u8bom(ptr_, end_)) skip_multi_bytes(3);
+
+  index_base_ = ptr_;
+
+  index_.build(ptr_, end_);
+
+  index_ptr_ = index_.begin();
+  index_end_ = index_.end();
+
+  if (!next_indexed() || (*ptr_ != c_object_begin && *ptr_ != c_array_begin))
+  {
+    throw_error(error_code::missing_begin_object_array);
+    return false;
+  }
+
+  if (!parse_indexed_value(v)) return false;
+
+  // nothing but white space after the root
+  if (next_indexed())
+  {
+    throw_error(error_code::illeagl_character, "surplus value after the root");
+    return false;
+  }
+
+  return true;
+}
+
+bool parser::next_indexed()
+{
+  const char* next = (index_ptr_ != index_end_) ? index_base_ + *index_ptr_ : end_;
+
+  // only white space is not indexed between two tokens. a byte which is neither follows a scalar
+  // directly, the scalar is malformed
+  if (ptr_ != next && !(ptr_ < next && (is_white_space(*ptr_) || *ptr_ == c_form_feed)))
+    return false;
+
+  ptr_ = next;
+  if (index_ptr_ == index_end_) return false;
+
+  ++index_ptr_;
+  return true;
+}
+
+bool parser::parse_indexed_value(value& v)
+{
+  sync_begin_pos();
+
+  unsigned char c = *ptr_;
+
+  if (c == c_object_begin || c == c_array_begin) return parse_indexed_container(v);
+  if (likely(c == c_double_quotes)) return parse_value_string<parse_flag::strict>(v);
+  if (leading_number(c)) return parse_value_number<parse_flag::strict>(v);
+  if (c == c_letter_n) return parse_value_null(v);
+  if (c == c_letter_t) return parse_value_true(v);
+  if (c == c_letter_f) return parse_value_false(v);
+
+  throw_error(error_code::illeagl_character, "illeagl value");
+  return false;
+}
+
+bool parser::parse_indexed_container(value& v)
+{
+  stack_.clear();
+  if (!open_indexed_container(v)) return false;
+
+  while (true)
+  {
+    auto& top = stack_.back();
+
+    // an empty container, or the end after its last element
+    if (*ptr_ == (top.is_object ? c_object_end : c_array_end))
+    {
+      skip_multi_bytes(1);
+      stack_.pop_back();
+      if (stack_.empty()) return true;
+    }
+    else
+    {
+      auto&  container = *static_cast<value*>(top.value);
+      value* element   = top.is_object ? parse_indexed_member(*container.data_.v_object_)
+                                       : &container.data_.v_array_->emplace_back(nullptr);
+      if (!element) return false;
+
+      sync_begin_pos();
+      if (*ptr_ == c_object_begin || *ptr_ == c_array_begin)
+      {
+        if (!open_indexed_container(*element)) return false;
+        continue;
+      }
+
+      if (!parse_indexed_value(*element)) return false;
+    }
+
+    // after an element: `,` and the next element, or the end
+    auto end  = stack_.back().is_object ? c_object_end : c_array_end;
+    auto code = stack_.back().is_object ? error_code::missing_end_object
+                                        : error_code::missing_end_array;
+
+    if (!next_indexed() || (*ptr_ != c_value_separator && *ptr_ != end))
+    {
+      throw_error(code);
+      return false;
+    }
+
+    if (*ptr_ == end) continue;
+
+    ++ptr_;
+    if (!next_indexed())
+    {
+      throw_error(code);
+      return false;
+    }
+
+    if (unlikely(*ptr_ == end))
+    {
+      throw_error(error_code::surplus_trailing_comma);
+      return false;
+    }
   }
-
-  return code;
 }
 
-class DepthAutoCounter
+bool parser::open_indexed_container(value& v)
 {
-public:
-  DepthAutoCounter(int& depth)
-      : depth_(depth)
+  if (depth_ + stack_.size() >= max_depth_)
   {
-    ++depth_;
+    throw_error(error_code::too_deep);
+    return false;
   }
-  ~DepthAutoCounter() { --depth_; }
 
-private:
-  int& depth_;
-};
+  bool is_object = (*ptr_ == c_object_begin);
 
-value parser::parse(const char* begin, const char* end, error& error, parse_flag flag)
-{
-  if (!begin || !end || begin >= end) return value();
+  if (is_object)
+  {
+    v.kind_ = kind::object;
+    v.data_.v_object_ = v.create<value::object_t>();
+  }
+  else
+  {
+    v.kind_ = kind::array;
+    v.data_.v_array_ = v.create<value::array_t>();
+  }
 
-  this->begin_ = begin;
-  this->ptr_   = begin;
-  this->end_   = end;
-  this->flag   = flag;
+  stack_.push_back({&v, 0, is_object});
 
-  value val;
-  if (!parse(val))
+  ++ptr_;
+  if (!next_indexed())
   {
-    val   = kind::error;
-    error = error_;
+    throw_error(is_object ? error_code::missing_end_object : error_code::missing_end_array);
+    return false;
   }
 
-  return val;
-}
-
-value parser::parse(const char* begin, std::size_t len, error& error, parse_flag flag)
-{
-  return (begin && len) ? parse(begin, begin + len, error, flag) : value();
+  return true;
 }
 
-value parser::parse(std::istream& is, error& error, parse_flag flag)
+value* parser::parse_indexed_member(value::object_t& object)
 {
-  if (is.bad() || is.eof()) return value();
-
+  if (unlikely(*ptr_ != c_double_quotes))
   {
-    is_ = &is;
-
-    is_buf_ = std::unique_ptr<char[]>(new char[is_buf_size]);
-    memset(is_buf_.get(), 0, is_buf_size);
-    is_->read(is_buf_.get(), is_buf_size - 1);
-
-    this->begin_ = is_buf_.get();
-    this->ptr_   = is_buf_.get();
-    this->end_   = is_buf_.get() + std::char_traits<char>::length(is_buf_.get());
-    this->flag   = flag;
+    throw_error(error_code::missing_quotation_mark);
+    return nullptr;
   }
 
-  value val;
-  if (!parse(val))
+  std::string key;
+  if (!parse_string_quoted<parse_flag::strict>(key)) return nullptr;
+
+  if (!next_indexed() || *ptr_ != c_name_separator)
   {
-    val   = kind::error;
-    error = error_;
+    throw_error(error_code::missing_name_separator);
+    return nullptr;
   }
 
-  return val;
-}
-
-bool parser::parse(value& v)
-{
-  if ((end_ - ptr_ >= 3) && unicode::start_with_u8bom(ptr_, end_)) skip_multi_bytes(3);
-
-  if (skip_space_and_comments())
+  ++ptr_;
+  if (!next_indexed())
   {
-    if (*ptr_ == c_object_begin) return parse_object(v);
-    if (*ptr_ == c_array_begin) return parse_array(v);
-
-    if (parse_lenient_root)  // JSON5 top level can be a value
-    {
-      if (*ptr_ == c_double_quotes)
-        parse_value_string(v);
-      else if (*ptr_ == c_single_quotes)
-        parse_value_string(v);
-      else if (leading_unquoted(*ptr_))
-        parse_value_unquoted(v);
-      else if (leading_number(*ptr_))
-        parse_value_number(v);
-      else if (*ptr_ == c_letter_n)
-        parse_value_null(v);
-      else if (*ptr_ == c_letter_t)
-        parse_value_true(v);
-      else if (*ptr_ == c_letter_f)
-        parse_value_false(v);
-      else if (*ptr_ == c_letter_N)
-        parse_value_nan(v);
-      else if (*ptr_ == c_letter_I)
-        parse_value_infinity(v);
-      else
-      {
-        throw_error(error_code::missing_begin_object_array);
-        return false;
-      }
-
-      skip_space_and_comments();
-      return none_error;
-    }
+    throw_error(error_code::illeagl_character, "expecte object value");
+    return nullptr;
   }
 
-  throw_error(error_code::missing_begin_object_array);
-  return false;
+  // a duplicate key takes the last value
+  auto insert_ret = object.emplace(std::move(key), nullptr);
+  if (!insert_ret.second) insert_ret.first->second = nullptr;
+
+  return &insert_ret.first->second;
 }
 
-bool parser::parse_object_element(value::object_t& object)
+template <parse_flag Flags, typename Object>
+typename Object::mapped_type* parser::parse_object_element(Object& object, std::size_t pos)
 {
-  std::string key;
-  if (!parse_key(key) || !skip_space_and_comments()) return false;
+  key_buffer_.clear();
+  if (!parse_key<Flags>(key_buffer_) || !skip_space_and_comments<Flags>()) return nullptr;
 
   if (*ptr_ != c_name_separator)
   {
     throw_error(error_code::missing_name_separator);
-    return false;
+    return nullptr;
   }
 
   ++ptr_;
 
-  if (skip_space_and_comments())
+  if (!skip_space_and_comments<Flags>())
   {
-    auto insert_ret = object.emplace(std::move(key), nullptr);
-    return parse_value(insert_ret.first->second);
+    throw_error(error_code::illeagl_character, "expecte object value");
+    return nullptr;
   }
 
-  throw_error(error_code::illeagl_character, "expecte object value");
-  return false;
+  // the member at pos of an object reused is overwritten if it has the key, else it and the
+  // members after it are dropped
+  if (pos < object.size())
+  {
+    auto& member = *(object.begin() + pos);
+    if (std::string_view(member.first.data(), member.first.size()) == key_buffer_)
+      return &member.second;
+
+    while (object.size() > pos) object.erase(object.end() - 1);
+  }
+
+  // a duplicate key takes the last value
+  typename Object::key_type key(key_buffer_.data(), key_buffer_.size(), object.get_allocator());
+
+  auto insert_ret = object.emplace(std::move(key), nullptr);
+  if (!insert_ret.second) insert_ret.first->second = nullptr;
+
+  return &insert_ret.first->second;
 }
 
-bool parser::parse_object(value& v)
+template <parse_flag Flags, typename Value>
+bool parser::parse_container(Value& v)
 {
-  DepthAutoCounter depth(depth_);
-  if (depth_ > JSON_MAX_DEPTH)
+  // the elements are parsed into their containers in place, the open ones are on stack_
+  stack_.clear();
+  if (!open_container(v)) return false;
+
+  bool has_trailing_comma = false;  // the last token is `,`, the end may not follow it
+  bool has_element        = false;  // the last token ends an element, `,` or the end follows it
+
+  while (skip_space_and_comments<Flags>())
   {
-    throw_error(error_code::too_deep);
-    return false;
-  }
+    auto&         top = stack_.back();
+    unsigned char c   = *ptr_;
 
-  skip_multi_bytes(1);
+    if (c == (top.is_object ? c_object_end : c_array_end))
+    {
+      if (has_trailing_comma &&
+          !(top.is_object ? parse_object_trailing_comma : parse_array_trailing_comma))
+      {
+        throw_error(error_code::surplus_trailing_comma);
+        return false;
+      }
 
-  value::object_t object;
+      skip_multi_bytes(1);
+      close_container<Value>();
+      if (stack_.empty()) return true;
 
-  bool has_trailing_comma = false;
+      has_trailing_comma = false;
+      has_element        = true;
+      continue;
+    }
 
-  unsigned char c = -1;
-  while (skip_space_and_comments())
-  {
-    c = *ptr_;
+    if (has_element)
+    {
+      if (c != c_value_separator) break;
+
+      skip_multi_bytes(1);
+      has_trailing_comma = true;
+      has_element        = false;
+      continue;
+    }
 
-    if (c == c_object_end) break;
+    // the elements of a container reused are overwritten in order, the others are appended
+    auto&  container = *static_cast<Value*>(top.value);
+    Value* element   = nullptr;
 
-    if (likely(c == c_double_quotes))
-      parse_object_element(object);
-    else if (c == c_single_quotes && parse_single_quotes)
-      parse_object_element(object);
-    else if (leading_unquoted(c) && parse_unquoted_string)
-      parse_object_element(object);
+    if (!top.is_object)
+    {
+      auto& array = *container.data_.v_array_;
+      element = (top.count < array.size()) ? &array[top.count] : &array.emplace_back(nullptr);
+    }
+    else if (likely(c == c_double_quotes) || (c == c_single_quotes && parse_single_quotes) ||
+             (leading_unquoted(c) && parse_unquoted_string))
+      element = parse_object_element<Flags>(*container.data_.v_object_, top.count);
     else
       throw_error(error_code::missing_quotation_mark);
 
-    if (!none_error || !skip_space_and_comments()) { return false; }
+    if (!element)
+    {
+      if (none_error) throw_error(error_code::missing_end_object);
+      return false;
+    }
 
+    ++top.count;
     has_trailing_comma = false;
-    if (*ptr_ != c_value_separator) break;
-
-    has_trailing_comma = true;
-    skip_multi_bytes(1);
-  }
+    has_element        = true;
 
-  if (ptr_ < end_ && *ptr_ == c_object_end)
-  {
-    if (has_trailing_comma && !parse_object_trailing_comma)
+    c = *ptr_;
+    if (c == c_object_begin || c == c_array_begin)
     {
-      throw_error(error_code::surplus_trailing_comma);
-      return false;
+      if (!open_container(*element)) return false;
+      has_element = false;
+      continue;
     }
 
-    v.kind_ = kind::object;
-    new (&v.data_.v_object_) value::object_t(std::move(object));
+    // a string reused keeps its storage, any other value is released first
+    if (element->kind_ != kind::null &&
+        !(element->kind_ == kind::string && !insitu_ &&
+          (c == c_double_quotes || c == c_single_quotes)))
+      *element = nullptr;
 
-    skip_multi_bytes(1);
-    return true;
+    if (!parse_value<Flags>(*element) || !none_error) return false;
   }
 
-  throw_error(error_code::missing_end_object);
+  if (none_error)
+    throw_error(stack_.back().is_object ? error_code::missing_end_object
+                                        : error_code::missing_end_array);
   return false;
 }
 
-bool parser::parse_array(value& v)
+template <typename Value>
+bool parser::open_container(Value& v)
 {
-  DepthAutoCounter line(depth_);
-  if (depth_ > JSON_MAX_DEPTH)
+  if (depth_ + stack_.size() >= max_depth_)
   {
     throw_error(error_code::too_deep);
     return false;
   }
 
-  ++ptr_;
-
-  value::array_t array;
+  bool is_object = (*ptr_ == c_object_begin);
+  auto depth     = stack_.size();
 
-  bool has_trailing_comma = false;
-
-  while (skip_space_and_comments())
+  // a container of a value reused keeps its elements, the others reserve the elements of the
+  // last one closed at the same depth
+  if (v.kind_ != (is_object ? kind::object : kind::array))
   {
-    if (*ptr_ == c_array_end) break;
-
-    has_trailing_comma = false;
-    if (!parse_value(array.emplace_back(nullptr)) || !skip_space_and_comments()) { return false; }
-
-    if (*ptr_ != c_value_separator) break;
+    if (v.kind_ != kind::null) v = nullptr;
 
-    has_trailing_comma = true;
-    skip_multi_bytes(1);
-  }
+    std::size_t hint = 0;
+    if (depth < hints_.size()) hint = is_object ? hints_[depth].object : hints_[depth].array;
 
-  if (ptr_ < end_ && *ptr_ == c_array_end)
-  {
-    if (has_trailing_comma && !parse_array_trailing_comma)
+    if (is_object)
     {
-      throw_error(error_code::surplus_trailing_comma);
-      return false;
+      v.kind_ = kind::object;
+      v.data_.v_object_ = v.template create<typename Value::object_t>(v.get_allocator());
+      if (hint) v.data_.v_object_->reserve(hint);
     }
+    else
+    {
+      v.kind_ = kind::array;
+      v.data_.v_array_ = v.template create<typename Value::array_t>(v.get_allocator());
+      if (hint) v.data_.v_array_->reserve(hint);
+    }
+  }
 
-    skip_multi_bytes(1);
+  skip_multi_bytes(1);
+  stack_.push_back({&v, 0, is_object});
 
-    v.kind_ = kind::array;
-    new (&v.data_.v_array_) value::array_t(std::move(array));
+  return true;
+}
 
-    return true;
+template <typename Value>
+void parser::close_container()
+{
+  auto& top       = stack_.back();
+  auto& container = *static_cast<Value*>(top.value);
+  auto  depth     = stack_.size() - 1;
+
+  // the elements of a value reused past the ones of the document are dropped
+  if (top.is_object)
+  {
+    auto& object = *container.data_.v_object_;
+    while (object.size() > top.count) object.erase(object.end() - 1);
+  }
+  else
+  {
+    auto& array = *container.data_.v_array_;
+    if (array.size() > top.count) array.erase(array.begin() + top.count, array.end());
   }
 
-  throw_error(error_code::missing_end_array);
-  return false;
+  if (hints_.size() <= depth) hints_.resize(depth + 1);
+  (top.is_object ? hints_[depth].object : hints_[depth].array) = top.count;
+
+  stack_.pop_back();
 }
 
-bool parser::parse_value(value& v)
+template <parse_flag Flags, typename Value>
+bool parser::parse_value(Value& v)
 {
   unsigned char c = *ptr_;
 
-  if (likely(c == c_object_begin)) return parse_object(v);
-  if (likely(c == c_array_begin)) return parse_array(v);
-  if (likely(c == c_double_quotes)) return parse_value_string(v);
-  if (c == c_single_quotes && parse_single_quotes) return parse_value_string(v);
-  if (leading_unquoted(c) && parse_unquoted_string) return parse_value_unquoted(v);
-  if (leading_number(c)) return parse_value_number(v);
+  if (likely(c == c_object_begin || c == c_array_begin)) return parse_container<Flags>(v);
+  if (likely(c == c_double_quotes)) return parse_value_string<Flags>(v);
+  if (c == c_single_quotes && parse_single_quotes) return parse_value_string<Flags>(v);
+  if (leading_unquoted(c) && parse_unquoted_string) return parse_value_unquoted<Flags>(v);
+  if (leading_number(c)) return parse_value_number<Flags>(v);
   if (c == c_letter_n) return parse_value_null(v);
   if (c == c_letter_t) return parse_value_true(v);
   if (c == c_letter_f) return parse_value_false(v);
@@ -311,13 +1055,23 @@ bool parser::parse_value(value& v)
   return false;
 }
 
-bool parser::parse_value_string(value& v)
+template <parse_flag Flags, typename Value>
+bool parser::parse_value_string(Value& v)
 {
-  std::string buffer;
-  if (parse_string_quoted(buffer))
+  if (insitu_) return parse_value_string_insitu<Flags>(v);
+
+  // a string of a value reused is overwritten, its storage is kept
+  if (v.kind_ == kind::string)
+  {
+    v.data_.v_string_->clear();
+    return parse_string_quoted<Flags>(*v.data_.v_string_);
+  }
+
+  typename Value::string_t buffer(v.get_allocator());
+  if (parse_string_quoted<Flags>(buffer))
   {
     v.kind_ = kind::string;
-    new (&v.data_.v_string_) value::string_t(std::move(buffer));
+    v.data_.v_string_ = v.template create<typename Value::string_t>(std::move(buffer));
 
     return true;
   }
@@ -325,11 +1079,49 @@ bool parser::parse_value_string(value& v)
   return false;
 }
 
-bool parser::parse_value_unquoted(value& v)
+template <parse_flag Flags, typename Value>
+bool parser::parse_value_string_insitu(Value& v)
+{
+  // the raw text of the string, between its quotes. the input is writable in situ
+  auto first = const_cast<char*>(ptr_) + 1;
+
+  insitu_string text(insitu_buffer_);
+  if (!parse_string_quoted<Flags>(text)) return false;
+
+  auto view = text.view();
+
+  // the text is no longer than its raw form but for the escaped zero of JSON5, and the size of a
+  // view is 32 bits. a string that does not fit is copied
+  if (view.size() > (std::numeric_limits<std::uint32_t>::max)() ||
+      (text.copied() && view.size() > (std::size_t)(ptr_ - 1 - first)))
+  {
+    v.kind_ = kind::string;
+    v.data_.v_string_ = v.template create<typename Value::string_t>(
+        view.data(), view.size(), v.get_allocator());
+
+    return true;
+  }
+
+  if (text.copied())
+  {
+    std::memcpy(first, view.data(), view.size());
+    view = std::string_view(first, view.size());
+  }
+
+  // the view is stored in the value, nothing is allocated
+  v.kind_ = kind::string_view;
+  v.data_.v_view_ = view.data();
+  v.view_size_    = static_cast<std::uint32_t>(view.size());
+
+  return true;
+}
+
+template <parse_flag Flags, typename Value>
+bool parser::parse_value_unquoted(Value& v)
 {
-  std::string buffer;
+  typename Value::string_t buffer(v.get_allocator());
 
-  if (!parse_string_unquoted(buffer, parse_action::parse_val)) { return false; }
+  if (!parse_string_unquoted<Flags>(buffer, parse_action::parse_val)) { return false; }
 
   {
     number num;
@@ -338,17 +1130,18 @@ bool parser::parse_value_unquoted(value& v)
       if (unlikely(num.is_fraction))
       {
         v.kind_ = kind::number_float;
-        new (&v.data_.v_double_) value::number_float_t(num.negative ? -num.fraction : num.fraction);
+        new (&v.data_.v_double_)
+            typename Value::number_float_t(num.negative ? -num.fraction : num.fraction);
       }
       else if (num.negative)
       {
         v.kind_ = kind::number_int;
-        new (&v.data_.v_int_) value::number_int_t((long long)(~num.integer + 1));
+        new (&v.data_.v_int_) typename Value::number_int_t((long long)(~num.integer + 1));
       }
       else
       {
         v.kind_ = kind::number_uint;
-        new (&v.data_.v_uint_) value::number_uint_t(num.integer);
+        new (&v.data_.v_uint_) typename Value::number_uint_t(num.integer);
       }
 
       return true;
@@ -358,7 +1151,7 @@ bool parser::parse_value_unquoted(value& v)
   if (equal(buffer, "true", 4))
   {
     v.kind_ = kind::boolean;
-    new (&v.data_.v_bool_) value::boolean_t(true);
+    new (&v.data_.v_bool_) typename Value::boolean_t(true);
 
     return true;
   }
@@ -366,7 +1159,7 @@ bool parser::parse_value_unquoted(value& v)
   if (equal(buffer, "false", 5))
   {
     v.kind_ = kind::boolean;
-    new (&v.data_.v_bool_) value::boolean_t(false);
+    new (&v.data_.v_bool_) typename Value::boolean_t(false);
 
     return true;
   }
@@ -376,7 +1169,8 @@ bool parser::parse_value_unquoted(value& v)
   if (parse_nan_num && equal(buffer, "NaN", 3))
   {
     v.kind_ = kind::number_float;
-    new (&v.data_.v_double_) value::number_float_t(std::numeric_limits<double>::quiet_NaN());
+    new (&v.data_.v_double_)
+        typename Value::number_float_t(std::numeric_limits<double>::quiet_NaN());
 
     return true;
   }
@@ -386,7 +1180,8 @@ bool parser::parse_value_unquoted(value& v)
     if (equal(buffer, "Infinity", 8) || equal(buffer, "+Infinity", 9))
     {
       v.kind_ = kind::number_float;
-      new (&v.data_.v_double_) value::number_float_t(std::numeric_limits<double>::infinity());
+      new (&v.data_.v_double_)
+          typename Value::number_float_t(std::numeric_limits<double>::infinity());
 
       return true;
     }
@@ -394,19 +1189,21 @@ bool parser::parse_value_unquoted(value& v)
     if (equal(buffer, "-Infinity", 9))
     {
       v.kind_ = kind::number_float;
-      new (&v.data_.v_double_) value::number_float_t(-std::numeric_limits<double>::infinity());
+      new (&v.data_.v_double_)
+          typename Value::number_float_t(-std::numeric_limits<double>::infinity());
 
       return true;
     }
   }
 
   v.kind_ = kind::string;
-  new (&v.data_.v_string_) value::string_t(std::move(buffer));
+  v.data_.v_string_ = v.template create<typename Value::string_t>(std::move(buffer));
 
   return true;
 }
 
-bool parser::parse_value_number(value& v)
+template <parse_flag Flags, typename Value>
+bool parser::parse_value_number(Value& v)
 {
   sync_begin_pos();
 
@@ -418,7 +1215,7 @@ bool parser::parse_value_number(value& v)
   {
     c = *ptr_;
 
-    if (likely(isdigit(c))) return parse_value_digit(v);
+    if (likely(isdigit(c))) return parse_value_digit<Flags>(v);
     if (c == c_letter_I) return parse_value_infinity(v);
 
     throw_error(error_code::illeagl_number);
@@ -429,7 +1226,8 @@ bool parser::parse_value_number(value& v)
   return false;
 }
 
-bool parser::parse_value_null(value& v)
+template <typename Value>
+bool parser::parse_value_null(Value& v)
 {
   if (skip_if_starts_with("null", 4))
   {
@@ -441,12 +1239,13 @@ bool parser::parse_value_null(value& v)
   return false;
 }
 
-bool parser::parse_value_true(value& v)
+template <typename Value>
+bool parser::parse_value_true(Value& v)
 {
   if (skip_if_starts_with("true", 4))
   {
     v.kind_ = kind::boolean;
-    new (&v.data_.v_bool_) value::boolean_t(true);
+    new (&v.data_.v_bool_) typename Value::boolean_t(true);
 
     return true;
   }
@@ -455,12 +1254,13 @@ bool parser::parse_value_true(value& v)
   return false;
 }
 
-bool parser::parse_value_false(value& v)
+template <typename Value>
+bool parser::parse_value_false(Value& v)
 {
   if (skip_if_starts_with("false", 5))
   {
     v.kind_ = kind::boolean;
-    new (&v.data_.v_bool_) value::boolean_t(false);
+    new (&v.data_.v_bool_) typename Value::boolean_t(false);
 
     return true;
   }
@@ -469,7 +1269,8 @@ bool parser::parse_value_false(value& v)
   return false;
 }
 
-bool parser::parse_value_digit(value& v)
+template <parse_flag Flags, typename Value>
+bool parser::parse_value_digit(Value& v)
 {
   const char* leading_zero_ptr = nullptr;
 
@@ -483,68 +1284,88 @@ bool parser::parse_value_digit(value& v)
   bool negative    = (*begin_ == c_minus_sign);
   bool is_fraction = false;
 
-  value::number_uint_t  integer  = 0;
-  value::number_float_t fraction = 0.0;
+  // the value is integer * 10^exponent. the digits past 64 bits are dropped, they only scale it
+  typename Value::number_uint_t integer   = 0;
+  long long                     exponent  = 0;
+  bool                          dropped   = false;
+  bool                          truncated = false;  // a digit dropped is not zero
 
   auto cutoff = __flowover<sizeof(integer)>::cutoff_tab[8];
   auto cutlim = __flowover<sizeof(integer)>::cutlim_tab[8];
 
-  unsigned char c = *ptr_;
+  // eight digits at once while the integer can't overflow, the rest one at a time
+  while (end_ - ptr_ >= 8 && integer <= __eight_digits_cutoff)
+  {
+    uint64_t block = read_eight_bytes(ptr_);
+    if (!is_eight_digits(block)) break;
+
+    integer = integer * 100000000 + parse_eight_digits(block);
+    ptr_ += 8;
+  }
+
+  unsigned char c = 0;
 
   while (!eof() && isdigit(*ptr_))
   {
     c = char_to_num(*ptr_);
 
-    if (!is_fraction && (integer > cutoff || (integer == cutoff && c > cutlim)))
+    if (dropped || integer > cutoff || (integer == cutoff && c > cutlim))
     {
+      dropped     = true;
+      truncated   = truncated || (c != 0);
       is_fraction = true;
-      fraction    = static_cast<value::number_float_t>(integer);
+      ++exponent;
     }
-
-    if (!is_fraction)
-    {
+    else
       integer = integer * 10 + c;
 
-      if (negative && integer > (decltype(integer))(std::numeric_limits<long long>::max)() + 1)
-      {
-        is_fraction = true;
-        fraction    = static_cast<value::number_float_t>(integer);
-      }
-    }
-    else { fraction = fraction * 10 + c; }
-
     ++ptr_;
   }
 
+  if (negative && integer > (decltype(integer))(std::numeric_limits<long long>::max)() + 1)
+    is_fraction = true;
+
   if (ptr_ < end_ && *ptr_ == c_decimal_point)
   {
     ++ptr_;
-    fraction    = is_fraction ? fraction : static_cast<double>(integer);
     is_fraction = true;
 
-    long long digit_count   = 0;
-    long long fraction_part = 0;
+    while (!dropped && end_ - ptr_ >= 8 && integer <= __eight_digits_cutoff)
+    {
+      uint64_t block = read_eight_bytes(ptr_);
+      if (!is_eight_digits(block)) break;
+
+      integer = integer * 100000000 + parse_eight_digits(block);
+      exponent -= 8;
+      ptr_ += 8;
+    }
 
     while (!eof() && isdigit(*ptr_))
     {
-      ++digit_count;
-      fraction_part = fraction_part * 10 + char_to_num(*ptr_);
+      c = char_to_num(*ptr_);
+
+      if (dropped || integer > cutoff || (integer == cutoff && c > cutlim))
+      {
+        dropped   = true;
+        truncated = truncated || (c != 0);
+      }
+      else
+      {
+        integer = integer * 10 + c;
+        --exponent;
+      }
 
       ++ptr_;
     }
-
-    fraction += (static_cast<double>(fraction_part) * std::pow(10, -digit_count));
   }
 
   if (ptr_ < end_ && (*ptr_ == 'e' || *ptr_ == 'E'))
   {
     ++ptr_;
-
-    fraction    = is_fraction ? fraction : static_cast<double>(integer);
     is_fraction = true;
 
-    bool      exp_neg  = false;
-    long long exponent = 0;
+    bool      exp_neg   = false;
+    long long exp_value = 0;
 
     if (ensure_multi_bytes(1))
     {
@@ -559,18 +1380,12 @@ bool parser::parse_value_digit(value& v)
 
     while (!eof() && isdigit(*ptr_))
     {
-      exponent = exponent * 10 + char_to_num(*ptr_);
+      // saturated far out of the range of double
+      if (exp_value < 100000000) exp_value = exp_value * 10 + char_to_num(*ptr_);
       ++ptr_;
     }
 
-    if (exp_neg) exponent = -exponent;
-    fraction *= std::pow(10, exponent);
-  }
-
-  if (eof())
-  {
-    throw_error(error_code::no_end);
-    return false;
+    exponent += exp_neg ? -exp_value : exp_value;
   }
 
   if (leading_zero_ptr && (ptr_ - leading_zero_ptr > 1) &&
@@ -582,32 +1397,35 @@ bool parser::parse_value_digit(value& v)
 
   if (unlikely(is_fraction))
   {
+    auto fraction = decimal_to_double(integer, exponent, truncated, begin_, ptr_);
+
     v.kind_ = kind::number_float;
-    new (&v.data_.v_double_) value::number_float_t(negative ? -fraction : fraction);
+    new (&v.data_.v_double_) typename Value::number_float_t(negative ? -fraction : fraction);
   }
   else if (negative)
   {
     v.kind_ = kind::number_int;
-    new (&v.data_.v_int_) value::number_int_t((long long)(~integer + 1));
+    new (&v.data_.v_int_) typename Value::number_int_t((long long)(~integer + 1));
   }
   else
   {
     v.kind_ = kind::number_uint;
-    new (&v.data_.v_uint_) value::number_uint_t(integer);
+    new (&v.data_.v_uint_) typename Value::number_uint_t(integer);
   }
 
   sync_begin_pos();
   return true;
 }
 
-bool parser::parse_value_hexadecimal(value& v)
+template <typename Value>
+bool parser::parse_value_hexadecimal(Value& v)
 {
   ++ptr_;
 
   auto cutoff = __flowover<sizeof(unsigned long long)>::cutoff_tab[16 - 2];
   auto cutlim = __flowover<sizeof(unsigned long long)>::cutlim_tab[16 - 2];
 
-  value::number_uint_t number = 0;
+  typename Value::number_uint_t number = 0;
 
   char c = 0;
   while (!eof())
@@ -629,23 +1447,25 @@ bool parser::parse_value_hexadecimal(value& v)
   if (*begin_ == c_minus_sign)
   {
     v.kind_ = kind::number_int;
-    new (&v.data_.v_int_) value::number_int_t((int64_t)(~number + 1));
+    new (&v.data_.v_int_) typename Value::number_int_t((int64_t)(~number + 1));
   }
   else
   {
     v.kind_ = kind::number_uint;
-    new (&v.data_.v_int_) value::number_uint_t(number);
+    new (&v.data_.v_int_) typename Value::number_uint_t(number);
   }
 
   return none_error;
 }
 
-bool parser::parse_value_nan(value& v)
+template <typename Value>
+bool parser::parse_value_nan(Value& v)
 {
   if (skip_if_starts_with("NaN", 3))
   {
     v.kind_ = kind::number_float;
-    new (&v.data_.v_double_) value::number_float_t(std::numeric_limits<double>::quiet_NaN());
+    new (&v.data_.v_double_)
+        typename Value::number_float_t(std::numeric_limits<double>::quiet_NaN());
 
     return true;
   }
@@ -654,7 +1474,8 @@ bool parser::parse_value_nan(value& v)
   return false;
 }
 
-bool parser::parse_value_infinity(value& v)
+template <typename Value>
+bool parser::parse_value_infinity(Value& v)
 {
   if (skip_if_starts_with("Infinity", 8))
   {
@@ -662,7 +1483,7 @@ bool parser::parse_value_infinity(value& v)
                                              : -std::numeric_limits<double>::infinity();
 
     v.kind_ = kind::number_float;
-    new (&v.data_.v_double_) value::number_float_t(inf_val);
+    new (&v.data_.v_double_) typename Value::number_float_t(inf_val);
 
     return true;
   }
@@ -671,13 +1492,15 @@ bool parser::parse_value_infinity(value& v)
   return false;
 }
 
-bool parser::parse_key(std::string& key)
+template <parse_flag Flags, typename String>
+bool parser::parse_key(String& key)
 {
   return (*ptr_ == c_double_quotes || *ptr_ == c_single_quotes)
-             ? parse_string_quoted(key)
-             : parse_string_unquoted(key, parse_action::parse_key);
+             ? parse_string_quoted<Flags>(key)
+             : parse_string_unquoted<Flags>(key, parse_action::parse_key);
 }
 
+template <parse_flag Flags>
 bool parser::is_comment_start()
 {
   if (*ptr_ == c_solidus && parse_comments)
@@ -703,8 +1526,12 @@ bool parser::skip_single_line_comment()
 {
   skip_multi_bytes(2);
 
-  while (!eof())
+  for (;;)
   {
+    // the bytes skipped are not kept when the window slides
+    sync_begin_pos();
+    if (eof()) break;
+
     if (*ptr_ == c_line_feed || *ptr_ == c_carriage_return)
     {
       skip_multi_bytes(1);
@@ -721,8 +1548,11 @@ bool parser::skip_multi_line_comment()
 {
   skip_multi_bytes(2);
 
-  while (!eof())
+  for (;;)
   {
+    sync_begin_pos();
+    if (eof()) break;
+
     if (*ptr_ == c_asterisk && ensure_multi_bytes(2) && *(ptr_ + 1) == c_solidus)
     {
       skip_multi_bytes(2);
@@ -736,19 +1566,29 @@ bool parser::skip_multi_line_comment()
   return false;
 }
 
+template <parse_flag Flags>
 bool parser::skip_space_and_comments()
 {
-  while (!eof())
+  for (;;)
   {
+    // the white space and comments skipped are not kept when the window slides, it grows for
+    // tokens only
+    sync_begin_pos();
+    if (eof()) break;
+
     unsigned char c = *ptr_;
 
-    if (likely(c == c_space || c == c_horizontal_tab || c == c_form_feed))
+    // runs of white space are skipped by blocks. it stops at a `\r` ending the window
+    if (likely(c == c_space || c == c_line_feed || c == c_horizontal_tab || c == c_form_feed ||
+               c == c_carriage_return))
     {
-      ++ptr_;
-      continue;
+      ptr_ = simd::skip_white_space(ptr_, end_, line_);
+      if (ptr_ == end_) continue;
+
+      c = *ptr_;
     }
 
-    if (likely(c == c_carriage_return))  // terminated with `\r`
+    if (unlikely(c == c_carriage_return))  // terminated with `\r`
     {
       ++line_;
       ++ptr_;
@@ -759,13 +1599,6 @@ bool parser::skip_space_and_comments()
       continue;
     }
 
-    if (likely(c == c_line_feed))  // terminated with `\n`.
-    {
-      ++ptr_;
-      ++line_;
-      continue;
-    }
-
     if (parse_comments && c == c_solidus && skip_comment()) { continue; }
 
     if (parse_add_white_space)
@@ -804,7 +1637,8 @@ void parser::skip_multi_bytes(size_t length)
   begin_ = ptr_;
 }
 
-bool parser::parse_string_quoted(std::string& buffer)
+template <parse_flag Flags, typename String>
+bool parser::parse_string_quoted(String& buffer)
 {
   unsigned char quoted_ch = *ptr_;
   skip_multi_bytes(1);
@@ -813,9 +1647,13 @@ bool parser::parse_string_quoted(std::string& buffer)
 
   while (!eof())
   {
+    // clean ascii runs are skipped by blocks, they are appended with the rest of the span
+    ptr_ = simd::scan_string(ptr_, end_, (char)quoted_ch);
+    if (ptr_ == end_) continue;
+
     c = *ptr_;
 
-    if (unlikely(c == quoted_ch))
+    if (likely(c == quoted_ch))
     {
       buffer.append(begin_, ptr_ - begin_);
       skip_multi_bytes(1);
@@ -824,7 +1662,7 @@ bool parser::parse_string_quoted(std::string& buffer)
 
     if (unlikely(c == c_reverse_solidus))
     {
-      if (parse_escaped_sequence(buffer)) continue;
+      if (parse_escaped_sequence<Flags>(buffer)) continue;
 
       return false;
     }
@@ -847,7 +1685,32 @@ bool parser::parse_string_quoted(std::string& buffer)
       return false;
     }
 
-    if (likely(!parse_illegal_utf8 && !parse_utf8_sequence()))
+    if (parse_illegal_utf8)
+    {
+      ++ptr_;
+      continue;
+    }
+
+    // the non-ascii run is validated as a whole, up to the next byte the loop handles itself.
+    // a run cut by the stream window is decoded one sequence at a time
+    if (c >= 0x80)
+    {
+      auto span_end = simd::scan_string(ptr_, end_, (char)quoted_ch, false);
+
+      if (likely(span_end != end_))
+      {
+        if (unlikely(!unicode::validate_utf8(ptr_, span_end)))
+        {
+          throw_error(error_code::illegal_unicode);
+          return false;
+        }
+
+        ptr_ = span_end;
+        continue;
+      }
+    }
+
+    if (unlikely(!parse_utf8_sequence()))
     {
       throw_error(error_code::illegal_unicode);
       return false;
@@ -858,7 +1721,8 @@ bool parser::parse_string_quoted(std::string& buffer)
   return false;
 }
 
-bool parser::parse_string_unquoted(std::string& buffer, parse_action action)
+template <parse_flag Flags, typename String>
+bool parser::parse_string_unquoted(String& buffer, parse_action action)
 {
   unsigned char c = -1;
 
@@ -868,14 +1732,15 @@ bool parser::parse_string_unquoted(std::string& buffer, parse_action action)
 
     if (unlikely(c == c_reverse_solidus))
     {
-      if (parse_escaped_sequence(buffer)) continue;
+      if (parse_escaped_sequence<Flags>(buffer)) continue;
 
       return false;
     }
 
     if (unlikely((reach_key_end(c) && action == parse_action::parse_key) ||
                  (reach_val_end(c) && action == parse_action::parse_val) ||
-                 (is_comment_start() && action == parse_action::parse_val) || (c == c_line_feed)))
+                 (is_comment_start<Flags>() && action == parse_action::parse_val) ||
+                 (c == c_line_feed)))
     {
       auto tmp = ptr_ - 1;
       while (is_white_space(*tmp))
@@ -892,7 +1757,13 @@ bool parser::parse_string_unquoted(std::string& buffer, parse_action action)
       return false;
     }
 
-    if (likely(!parse_illegal_utf8 && !parse_utf8_sequence()))
+    if (parse_illegal_utf8)
+    {
+      ++ptr_;
+      continue;
+    }
+
+    if (unlikely(!parse_utf8_sequence()))
     {
       throw_error(error_code::illegal_unicode);
       return false;
@@ -904,7 +1775,8 @@ bool parser::parse_string_unquoted(std::string& buffer, parse_action action)
   return true;
 }
 
-bool parser::parse_escaped_sequence(std::string& buffer)
+template <parse_flag Flags, typename String>
+bool parser::parse_escaped_sequence(String& buffer)
 {
   buffer.append(begin_, ptr_ - begin_);
   sync_begin_pos();
@@ -934,8 +1806,8 @@ bool parser::parse_escaped_sequence(std::string& buffer)
     case c_horizontal_tab: break;
 
     case c_letter_u: parse_utf16_sequence(buffer); break;
-    case c_letter_x: parse_escaped_hexnum(buffer); break;
-    case c_number_zero: parse_escaped_zero(buffer); break;
+    case c_letter_x: parse_escaped_hexnum<Flags>(buffer); break;
+    case c_number_zero: parse_escaped_zero<Flags>(buffer); break;
 
     default: throw_error(error_code::illeagl_escaped); break;
   }
@@ -943,7 +1815,8 @@ bool parser::parse_escaped_sequence(std::string& buffer)
   return none_error;
 }
 
-bool parser::parse_escaped_zero(std::string& buffer)
+template <parse_flag Flags, typename String>
+bool parser::parse_escaped_zero(String& buffer)
 {
   if (parse_escaped_null)
   {
@@ -955,7 +1828,8 @@ bool parser::parse_escaped_zero(std::string& buffer)
   return false;
 }
 
-bool parser::parse_escaped_hexnum(std::string& buffer)
+template <parse_flag Flags, typename String>
+bool parser::parse_escaped_hexnum(String& buffer)
 {
   if (!parse_escaped_hex)
   {
@@ -1002,7 +1876,8 @@ bool parser::parse_utf8_sequence()
   return false;
 }
 
-bool parser::parse_utf16_sequence(std::string& buffer)
+template <typename String>
+bool parser::parse_utf16_sequence(String& buffer)
 {
   ++ptr_;  // current character is u, move 1 bytes
 
@@ -1025,12 +1900,12 @@ bool parser::parse_utf16_sequence(std::string& buffer)
         }
       }
     }
-    else if (likely(code > 0X7F))
+    else if (likely(code > 0X7F && code <= 0xFFFF))
     {
       ptr_ += 4;
       return true;
     }
-    else
+    else if (code <= 0X7F)
     {
       buffer.append(1, (unsigned char)code);  // ascii: trans to utf8
       skip_multi_bytes(4);
@@ -1070,42 +1945,21 @@ bool parser::eof()
 {
   if (ptr_ < end_) return false;
 
-  if (!is_->eof()) { feed(); }
+  if (!window_.exhausted()) { feed(); }
 
   return (ptr_ >= end_);
 }
 
 void parser::feed()
 {
-  auto data_size = end_ - begin_;
-
-  if (begin_ == is_buf_.get())
-  {
-    is_buf_size <<= 1;
-
-    std::unique_ptr<char[]> new_buff(new char[is_buf_size]);
-    memset(new_buff.get(), 0, is_buf_size);
-    memcpy(new_buff.get(), is_buf_.get(), data_size);
-
-    is_buf_ = std::move(new_buff);
-    is_->read(is_buf_.get() + data_size, (is_buf_size - data_size - 1));
-
-    begin_ = is_buf_.get();
-    ptr_   = is_buf_.get() + data_size;
-    end_   = is_buf_.get() + std::char_traits<char>::length(is_buf_.get());
-
-    return void();
-  }
-
-  memmove(is_buf_.get(), begin_, data_size);
+  if (window_.exhausted()) return void();
 
-  ptr_   = is_buf_.get() + (ptr_ - begin_);
-  begin_ = is_buf_.get();
+  // the token being scanned starts at begin_, it is kept in the window
+  auto begin = window_.slide(begin_);
 
-  memset((char*)begin_ + data_size, 0, is_buf_size - data_size);
-  is_->read((char*)begin_ + data_size, is_buf_size - data_size - 1);
-
-  end_ = begin_ + std::char_traits<char>::length(begin_);
+  ptr_   = begin + (ptr_ - begin_);
+  begin_ = begin;
+  end_   = window_.end();
 }
 
 bool parser::has_error()
@@ -1113,19 +1967,43 @@ bool parser::has_error()
   return error_.code_ != error_code::none;
 }
 
+void parser::restart()
+{
+  // a parser is reused, nothing is left of the document before
+  error_.code_ = error_code::none;
+  error_.message_.clear();
+
+  line_  = 1;
+  depth_ = 0;
+}
+
 void parser::throw_error(error_code code, const char* errmsg)
 {
+  // the two stage parser does not count lines on the way
+  if (index_base_) line_ = 1 + count_line_terminators(index_base_, (ptr_ < end_) ? ptr_ : end_);
+
   char __msg[256] = {0};
+  char __chr      = (ptr_ < end_) ? *ptr_ : ' ';  // nothing left to show at the end of input
 
   if (errmsg)
-    sprintf(__msg, "Line[%d] Parse Character[%c], Error: %s", line_, *ptr_, errmsg);
+    sprintf(__msg, "Line[%d] Parse Character[%c], Error: %s", line_, __chr, errmsg);
   else
-    sprintf(__msg, "Line[%d] Parse Character[%c], Error: %s", line_, *ptr_, error_desc(code));
+    sprintf(__msg, "Line[%d] Parse Character[%c], Error: %s", line_, __chr, error_desc(code));
 
   error_.code_ = code;
   error_.message_.assign(__msg);
 }
 
+template void parser::parse(const char*, const char*, value&, error&, parse_flag);
+template void parser::parse(std::istream&, value&, error&, parse_flag);
+template void parser::parse_insitu(char*, char*, value&, error&, parse_flag);
+
+#ifdef FORMATS_HAS_MEMORY_RESOURCE
+template void parser::parse(const char*, const char*, pmr::value&, error&, parse_flag);
+template void parser::parse(std::istream&, pmr::value&, error&, parse_flag);
+template void parser::parse_insitu(char*, char*, pmr::value&, error&, parse_flag);
+#endif  // FORMATS_HAS_MEMORY_RESOURCE
+
 }  // namespace detail
 
 FORMATS_JSON_NAMESPACE_END
@@ -1,15 +1,26 @@
 ﻿#pragma once
 
 #include <istream>
+#include <vector>
 
 #include <formats/jsoncpp/value.hpp>
 #include <formats/jsoncpp/error.hpp>
 #include <formats/jsoncpp/flags.h>
+#include <formats/jsoncpp/sax.hpp>
+#include <formats/jsoncpp/detail/structural_index.hpp>
+#include <formats/jsoncpp/detail/stream_window.hpp>
 
 FORMATS_JSON_NAMESPACE_BEGIN
 
 namespace detail
 {
+/*
+ * the parse functions are templates of the flags. the strict grammar and JSON5 have kernels of
+ * their own, in which a test of a flag is a constant. any_flags is the generic kernel, which tests
+ * the flag the parser is given, for the other combinations.
+ */
+constexpr parse_flag any_flags = parse_flag(0);
+
 enum parse_action : unsigned char
 {
   parse_object,
@@ -30,33 +41,172 @@ public:
 
   value parse(std::istream& is, error& error, parse_flag flag);
 
+  /*
+   * @brief: parse into v. the strings, arrays and objects of the result are allocated by the
+   * allocator of v, v is the error value if the parse failed.
+   */
+  template <typename Allocator>
+  void parse(const char*             begin,
+             const char*             end,
+             basic_value<Allocator>& v,
+             error&                  error,
+             parse_flag              flag);
+
+  template <typename Allocator>
+  void parse(std::istream& is, basic_value<Allocator>& v, error& error, parse_flag flag);
+
+  /*
+   * @brief: parse into v in situ. the strings are views of [begin, end), of kind string_view. a
+   * string an escape changes is unescaped into the text over its raw form, so the text must be
+   * writable. the keys of the objects are copied.
+   */
+  template <typename Allocator>
+  void parse_insitu(char*                   begin,
+                    char*                   end,
+                    basic_value<Allocator>& v,
+                    error&                  error,
+                    parse_flag              flag);
+
+  /*
+   * @brief: two stage parse of the strict grammar. the structural index of the whole document is
+   * built first, the value is built by walking the index then.
+   */
+  value parse_indexed(const char* begin, const char* end, error& error);
+
+  /*
+   * @brief: parse into the events of a handler, with the grammar of parse.
+   */
+  bool parse(const char* begin, const char* end, sax& handler, error& error, parse_flag flag);
+
+  /*
+   * @brief: on demand access of the strict grammar. index() builds the structural index of the
+   * document and keeps it, the document must outlive the parser. parse_indexed_at() parses the
+   * value whose first structural character is at pos, a container with its whole subtree.
+   */
+  bool index(const char* begin, const char* end, error& error);
+  bool parse_indexed_at(const uint32_t* pos, value& v, error& error);
+
+  /*
+   * @brief: convert the number of the strict grammar at begin. the text is followed by a byte
+   * which is not part of the number before end.
+   * @ret: the end of the number, nullptr if it is malformed.
+   */
+  const char* parse_number(const char* begin, const char* end, value& v, error& error);
+
+  /*
+   * @brief: parse the elements of a root array between two of its split points, for the parallel
+   * parse. [begin, stop) is a list of values separated by `,` of the strict grammar, stop is the
+   * `,` or the `]` after the last one. the text after stop up to end is readable.
+   */
+  bool parse_elements(const char* begin, const char* stop, const char* end,
+                      value::array_t& elements, error& error);
+
+  /*
+   * @brief: the most containers nested in a document, deeper is error_code::too_deep.
+   * JSON_MAX_DEPTH by default. the parse keeps the open containers on a stack of its own and a
+   * value is destroyed in a loop, but a value recurses on its children to be copied, compared or
+   * serialized, so a deeper value is only safe for what does none of them.
+   */
+  void        max_depth(std::size_t depth) { max_depth_ = depth; }
+  std::size_t max_depth() const { return max_depth_; }
+
+  /*
+   * @brief: whether parse() and parse_insitu() overwrite the value they are given in place. its
+   * arrays, objects and strings are kept where the document has one of the same kind, so their
+   * storage is reused. off by default, the value is released first.
+   */
+  void reuse_values(bool reuse) { reuse_ = reuse; }
+
+  /*
+   * @brief: whether parse() fails when anything but white space and comments follows the root.
+   * off by default, the text after the root is not read.
+   */
+  void single_root(bool single) { single_root_ = single; }
+
+  const structural_index& indexed() const { return index_; }
+  const char*             indexed_base() const { return index_base_; }
+
+  /* the window the last stream was read through */
+  const stream_window& window() const { return window_; }
+
 private:
-  bool parse(value& v);
-
-  bool parse_object(value& v);
-  bool parse_array(value& v);
-  bool parse_value(value& v);
-  bool parse_value_string(value& v);
-  bool parse_value_unquoted(value& v);
-  bool parse_value_number(value& v);
-  bool parse_value_null(value& v);
-  bool parse_value_true(value& v);
-  bool parse_value_false(value& v);
-
-  bool parse_object_element(value::object_t& object);
-  bool parse_key(std::string& key);
-
-  bool parse_value_digit(value& v);
-  bool parse_value_hexadecimal(value& v);
-  bool parse_value_nan(value& v);
-  bool parse_value_infinity(value& v);
-  bool parse_string_quoted(std::string& buffer);
-  bool parse_string_unquoted(std::string& buffer, parse_action action);
+  template <typename Value>
+  bool parse(Value& v);
+  template <parse_flag Flags, typename Value>
+  bool parse_document(Value& v);
+  template <parse_flag Flags, typename Value>
+  bool parse_root_value(Value& v);
+  template <parse_flag Flags>
+  bool parse_document_end();
+
+  template <parse_flag Flags, typename Value>
+  bool parse_container(Value& v);
+  template <typename Value>
+  bool open_container(Value& v);
+  template <typename Value>
+  void close_container();
+  template <parse_flag Flags, typename Value>
+  bool parse_value(Value& v);
+  template <parse_flag Flags, typename Value>
+  bool parse_value_string(Value& v);
+  template <parse_flag Flags, typename Value>
+  bool parse_value_string_insitu(Value& v);
+  template <parse_flag Flags, typename Value>
+  bool parse_value_unquoted(Value& v);
+  template <parse_flag Flags, typename Value>
+  bool parse_value_number(Value& v);
+  template <typename Value>
+  bool parse_value_null(Value& v);
+  template <typename Value>
+  bool parse_value_true(Value& v);
+  template <typename Value>
+  bool parse_value_false(Value& v);
+
+  template <parse_flag Flags, typename Object>
+  typename Object::mapped_type* parse_object_element(Object& object, std::size_t pos);
+  template <parse_flag Flags, typename String>
+  bool parse_key(String& key);
+
+private:
+  template <parse_flag Flags>
+  bool parse_sax();
+  template <parse_flag Flags>
+  bool sax_container();
+  bool sax_open_container();
+  template <parse_flag Flags>
+  bool sax_value();
+  template <parse_flag Flags>
+  bool sax_object_element();
+  bool sax_scalar(value& v);
+  bool sax_event(bool result);
 
 private:
+  bool parse_indexed(value& v);
+  bool parse_indexed_container(value& v);
+  bool open_indexed_container(value& v);
+  value* parse_indexed_member(value::object_t& object);
+  bool parse_indexed_value(value& v);
+  bool next_indexed();
+
+  template <parse_flag Flags, typename Value>
+  bool parse_value_digit(Value& v);
+  template <typename Value>
+  bool parse_value_hexadecimal(Value& v);
+  template <typename Value>
+  bool parse_value_nan(Value& v);
+  template <typename Value>
+  bool parse_value_infinity(Value& v);
+  template <parse_flag Flags, typename String>
+  bool parse_string_quoted(String& buffer);
+  template <parse_flag Flags, typename String>
+  bool parse_string_unquoted(String& buffer, parse_action action);
+
+private:
+  template <parse_flag Flags>
   bool skip_space_and_comments();
   void skip_multi_bytes(size_t length);
 
+  template <parse_flag Flags>
   bool is_comment_start();
 
   bool skip_comment();
@@ -64,11 +214,15 @@ private:
   bool skip_multi_line_comment();
 
 private:
-  bool parse_escaped_sequence(std::string& buffer);
-  bool parse_escaped_zero(std::string& buffer);
-  bool parse_escaped_hexnum(std::string& buffer);
+  template <parse_flag Flags, typename String>
+  bool parse_escaped_sequence(String& buffer);
+  template <parse_flag Flags, typename String>
+  bool parse_escaped_zero(String& buffer);
+  template <parse_flag Flags, typename String>
+  bool parse_escaped_hexnum(String& buffer);
   bool parse_utf8_sequence();
-  bool parse_utf16_sequence(std::string& buffer);
+  template <typename String>
+  bool parse_utf16_sequence(String& buffer);
 
 private:
   bool has_error();
@@ -81,6 +235,7 @@ private:
   void feed();
 
 private:
+  void restart();
   void throw_error(error_code, const char* errmsg = nullptr);
 
 private:
@@ -90,14 +245,47 @@ private:
 
   error error_;
 
-  size_t                  is_buf_size = 4096;
-  std::istream*           is_         = nullptr;
-  std::unique_ptr<char[]> is_buf_;
+  stream_window window_;  // the input of parse(std::istream&)
 
   int line_  = 1;
-  int depth_ = 0;
+  int depth_ = 0;  // the containers open around the ones of stack_, of parse_elements
+
+  /* a container open, the value it is parsed into, none for the events of a handler */
+  struct frame
+  {
+    void*       value;
+    std::size_t count;  // the elements parsed into it
+    bool        is_object;
+  };
+
+  /* the elements of the last array and object closed at a depth, reserved for the next ones */
+  struct hint
+  {
+    std::size_t array  = 0;
+    std::size_t object = 0;
+  };
+
+  std::vector<frame> stack_;  // the containers still open, the innermost at the back
+  std::vector<hint>  hints_;
+  std::size_t        max_depth_ = JSON_MAX_DEPTH;
 
   parse_flag flag = parse_flag::ECMA404;
+
+  structural_index index_;
+  const uint32_t*  index_ptr_  = nullptr;
+  const uint32_t*  index_end_  = nullptr;
+  const char*      index_base_ = nullptr;  // offsets are relative to it. set while parse_indexed
+
+  sax*        sax_ = nullptr;
+  std::string sax_buffer_;  // keys and strings, reused
+
+  bool        insitu_ = false;  // set while parse_insitu
+  std::string insitu_buffer_;   // a string an escape changes, before it is written back
+
+  bool        reuse_ = false;  // the value parsed into is overwritten in place, not released
+  std::string key_buffer_;     // the key of a member, before it is compared or inserted
+
+  bool single_root_ = false;  // only white space and comments may follow the root
 };
 
 }  // namespace detail
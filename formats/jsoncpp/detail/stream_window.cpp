@@ -0,0 +1,59 @@
+#include <formats/jsoncpp/detail/stream_window.hpp>
+
+#include <cstring>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace detail
+{
+void stream_window::open(std::istream& is)
+{
+  is_   = &is;
+  size_ = 0;
+
+  // a window of a previous stream is reused
+  if (!buf_)
+  {
+    capacity_ = default_capacity;
+    buf_.reset(new char[capacity_]);
+  }
+
+  read();
+}
+
+const char* stream_window::slide(const char* keep)
+{
+  size_t kept = end() - keep;
+
+  // a token longer than half the window would leave too little room to read, the window doubles
+  if (kept > capacity_ / 2)
+  {
+    std::unique_ptr<char[]> grown(new char[capacity_ * 2]);
+    memcpy(grown.get(), keep, kept);
+
+    buf_ = std::move(grown);
+    capacity_ *= 2;
+  }
+  else
+    memmove(buf_.get(), keep, kept);
+
+  size_ = kept;
+  read();
+
+  return begin();
+}
+
+void stream_window::read()
+{
+  if (is_ && is_->good())
+  {
+    is_->read(buf_.get() + size_, capacity_ - size_ - 1);
+    size_ += (size_t)is_->gcount();
+  }
+
+  buf_[size_] = '\0';
+}
+
+}  // namespace detail
+
+FORMATS_JSON_NAMESPACE_END
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+
+#include <formats/common/marco.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace detail
+{
+/*
+ * the input layer of the stream parser. a window of a fixed size slides over the stream: the bytes
+ * which are consumed are dropped, the token being scanned is moved to the front and the rest of
+ * the window is refilled. the storage is reused, it grows only for a token which fills more than
+ * half of it. the bytes are counted, an embedded NUL is data like any other byte.
+ */
+class stream_window
+{
+public:
+  static constexpr size_t default_capacity = 4096;
+
+  /* attach a stream and read the first window */
+  void open(std::istream& is);
+  void close() { is_ = nullptr; }
+
+  bool is_open() const { return is_ != nullptr; }
+  bool exhausted() const { return !is_ || !is_->good(); }
+
+  const char* begin() const { return buf_.get(); }
+  const char* end() const { return buf_.get() + size_; }
+
+  /*
+   * @brief: drop the bytes before keep and read more behind the others.
+   * @ret: the new address of keep, the pointers into the window move along with it.
+   */
+  const char* slide(const char* keep);
+
+  size_t capacity() const { return capacity_; }
+
+private:
+  void read();
+
+private:
+  std::istream*           is_ = nullptr;
+  std::unique_ptr<char[]> buf_;
+
+  size_t capacity_ = 0;
+  size_t size_     = 0;  // valid bytes, a NUL follows them for the lookahead of fixed strings
+};
+
+}  // namespace detail
+
+FORMATS_JSON_NAMESPACE_END
@@ -24,15 +24,16 @@ namespace detail
 
 // clang-format on
 
+template <typename Value>
 class stringifier
 {
 public:
   template <typename T,
             typename std::enable_if<std::is_same<T, std::string>::value, bool>::type = true>
-  stringifier(T&                 output,
-              const json::value& value,
-              stringify_style    style = stringify_style::standard,
-              stringify_flag     flag  = stringify_flag::strict)
+  stringifier(T&              output,
+              const Value&    value,
+              stringify_style style = stringify_style::standard,
+              stringify_flag  flag  = stringify_flag::strict)
       : stringifier(value, style, flag)
   {
     o = output_adapter::create_string(output);
@@ -40,17 +41,17 @@ public:
 
   template <typename T,
             typename std::enable_if<std::is_same<T, std::ostream>::value, bool>::type = true>
-  stringifier(T&                 output,
-              const json::value& value,
-              stringify_style    style = stringify_style::standard,
-              stringify_flag     flag  = stringify_flag::strict)
+  stringifier(T&              output,
+              const Value&    value,
+              stringify_style style = stringify_style::standard,
+              stringify_flag  flag  = stringify_flag::strict)
       : stringifier(value, style, flag)
   {
     o = output_adapter::create_stream(output);
   }
 
 private:
-  stringifier(const json::value& value, stringify_style style, stringify_flag flag)
+  stringifier(const Value& value, stringify_style style, stringify_flag flag)
       : value(value)
       , style(style)
       , flag(flag)
@@ -71,14 +72,15 @@ public:
   }
 
 private:
-  void write_scaler(const value& v)
+  void write_scaler(const Value& v)
   {
     std::string value_str;
 
     switch (v.kind())
     {
       case kind::string:
-        value_str.append(quote_mark).append(v.as_string()).append(quote_mark);
+      case kind::string_view:
+        value_str.append(quote_mark).append(v.as_string_view()).append(quote_mark);
         break;
       case kind::number_int: value_str.assign(std::to_string(v.as_int64())); break;
       case kind::number_uint: value_str.assign(std::to_string(v.as_uint64())); break;
@@ -91,7 +93,7 @@ private:
     o->write(value_str.c_str(), value_str.size());
   }
 
-  void write_array(const value& v)
+  void write_array(const Value& v)
   {
     o->write(c_array_begin);
 
@@ -132,7 +134,7 @@ private:
     o->write(c_array_end);
   }
 
-  void write_object(const value& v)
+  void write_object(const Value& v)
   {
     o->write(c_object_begin);
 
@@ -175,7 +177,7 @@ private:
   }
 
 private:
-  std::string double_to_string(const value& v)
+  std::string double_to_string(const Value& v)
   {
     auto double_value = v.as_double();
 
@@ -203,7 +205,7 @@ private:
     return std::string(buffer, length);
   }
 
-  void write_key(const std::string& key)
+  void write_key(const typename Value::string_t& key)
   {
     o->write(quote_mark.c_str(), quote_mark.size())
         .write(key.c_str(), key.size())
@@ -215,7 +217,7 @@ private:
 private:
   int depth = 0;
 
-  const json::value& value;
+  const Value& value;
 
   stringify_style style;
   stringify_flag  flag;
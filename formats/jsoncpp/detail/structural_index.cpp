@@ -0,0 +1,214 @@
+#include <formats/jsoncpp/detail/structural_index.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <formats/common/simd/simd.hpp>
+#include <formats/common/unicode/unicode.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace detail
+{
+namespace
+{
+/* blocks classified per call */
+constexpr size_t batch_blocks = 16;
+
+inline bool add_overflow(uint64_t a, uint64_t b, uint64_t& sum)
+{
+  sum = a + b;
+  return sum < a;
+}
+
+/* bit i is the xor of the bits 0..i: set between an opening quote and its closing quote */
+inline uint64_t prefix_xor(uint64_t x)
+{
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+/*
+ * the bytes escaped by a backslash. a run of backslashes escapes the byte after it when its length
+ * is odd: adding the runs which start on an odd bit to the backslashes carries past the runs and
+ * the parity of the landing bit tells the parity of the length. the carry out of the block tells
+ * whether the first byte of the next block is escaped.
+ */
+inline uint64_t find_escaped(uint64_t backslash, uint64_t& prev_escaped)
+{
+  const uint64_t even_bits = 0x5555555555555555ULL;
+
+  backslash &= ~prev_escaped;
+  uint64_t follows_escape = (backslash << 1) | prev_escaped;
+
+  uint64_t odd_starts     = backslash & ~even_bits & ~follows_escape;
+  uint64_t even_sequences = 0;
+  prev_escaped            = add_overflow(odd_starts, backslash, even_sequences) ? 1 : 0;
+
+  return (even_bits ^ (even_sequences << 1)) & follows_escape;
+}
+
+}  // namespace
+
+bool structural_index::build(const char* begin, const char* end)
+{
+  size_ = 0;
+
+  size_t length = end - begin;
+  if (length > max_length) return false;
+
+  reserve(std::max<size_t>(length / 8, 64));
+
+  uint64_t prev_escaped   = 0;  // the first byte of the block is escaped
+  uint64_t prev_in_string = 0;  // all ones when the block starts inside a string
+  uint64_t prev_scalar    = 0;  // the last byte of the block before is a scalar, not a quote
+
+  simd::block_masks masks[batch_blocks];
+  char              tail[64];
+
+  for (size_t offset = 0; offset < length;)
+  {
+    const char* ptr    = begin + offset;
+    size_t      blocks = std::min((length - offset) / 64, batch_blocks);
+
+    // the last partial block is padded with white space
+    if (blocks == 0)
+    {
+      std::memset(tail, ' ', sizeof(tail));
+      std::memcpy(tail, ptr, length - offset);
+
+      ptr    = tail;
+      blocks = 1;
+    }
+
+    simd::classify_json(ptr, blocks, masks);
+
+    for (size_t i = 0; i < blocks; ++i, offset += 64)
+    {
+      const simd::block_masks& m = masks[i];
+
+      uint64_t escaped   = find_escaped(m.backslash, prev_escaped);
+      uint64_t quote     = m.quote & ~escaped;
+      uint64_t in_string = prefix_xor(quote) ^ prev_in_string;
+
+      prev_in_string = (uint64_t)((int64_t)in_string >> 63);
+
+      // a scalar starts where a byte which is neither white space nor operator follows one which
+      // is. a quote starts a scalar too but never continues one
+      uint64_t scalar          = ~(m.op | m.space);
+      uint64_t nonquote_scalar = scalar & ~quote;
+      uint64_t follows_scalar  = (nonquote_scalar << 1) | prev_scalar;
+      uint64_t string_tail     = in_string ^ quote;
+      uint64_t structural      = (m.op | (scalar & ~follows_scalar)) & ~string_tail;
+
+      prev_scalar = nonquote_scalar >> 63;
+
+      if (capacity_ - size_ < 64) reserve(capacity_ * 2);
+
+      uint32_t* out = offsets_.get() + size_;
+      while (structural)
+      {
+        *out++ = (uint32_t)(offset + simd::trailing_zeros(structural));
+        structural &= structural - 1;
+      }
+
+      size_ = out - offsets_.get();
+    }
+  }
+
+  return true;
+}
+
+bool split_array(const char* begin, const char* end, size_t chunk, std::vector<size_t>& splits)
+{
+  splits.clear();
+
+  const char* ptr = begin;
+  if ((end - ptr >= 3) && unicode::start_with_u8bom(ptr, end)) ptr += 3;
+  while (ptr != end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\r' || *ptr == '\n')) ++ptr;
+
+  if (ptr == end || *ptr != '[') return false;
+
+  splits.push_back(ptr - begin);
+
+  size_t length = end - begin;
+  size_t next   = (ptr - begin) + chunk;  // the next split is the first `,` of the root past it
+  size_t depth  = 0;
+
+  uint64_t prev_escaped   = 0;
+  uint64_t prev_in_string = 0;
+
+  simd::block_masks masks[batch_blocks];
+  char              tail[64];
+
+  for (size_t offset = ptr - begin; offset < length;)
+  {
+    const char* block  = begin + offset;
+    size_t      blocks = std::min((length - offset) / 64, batch_blocks);
+
+    if (blocks == 0)
+    {
+      std::memset(tail, ' ', sizeof(tail));
+      std::memcpy(tail, block, length - offset);
+
+      block  = tail;
+      blocks = 1;
+    }
+
+    simd::classify_json(block, blocks, masks);
+
+    for (size_t i = 0; i < blocks; ++i, offset += 64, block += 64)
+    {
+      const simd::block_masks& m = masks[i];
+
+      uint64_t escaped   = find_escaped(m.backslash, prev_escaped);
+      uint64_t in_string = prefix_xor(m.quote & ~escaped) ^ prev_in_string;
+
+      prev_in_string = (uint64_t)((int64_t)in_string >> 63);
+
+      // the brackets are counted, not matched. a mismatch fails the parse of its chunk
+      for (uint64_t op = m.op & ~in_string; op; op &= op - 1)
+      {
+        int  bit = simd::trailing_zeros(op);
+        char c   = block[bit];
+
+        if (c == '[' || c == '{')
+          ++depth;
+        else if (c == ']' || c == '}')
+        {
+          if (--depth > 0) continue;
+
+          splits.push_back(offset + bit);
+          return c == ']';
+        }
+        else if (c == ',' && depth == 1 && offset + bit >= next)
+        {
+          splits.push_back(offset + bit);
+          next = offset + bit + chunk;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+void structural_index::reserve(size_t capacity)
+{
+  if (capacity <= capacity_) return void();
+
+  std::unique_ptr<uint32_t[]> offsets(new uint32_t[capacity]);
+  if (size_) std::memcpy(offsets.get(), offsets_.get(), size_ * sizeof(uint32_t));
+
+  offsets_  = std::move(offsets);
+  capacity_ = capacity;
+}
+
+}  // namespace detail
+
+FORMATS_JSON_NAMESPACE_END
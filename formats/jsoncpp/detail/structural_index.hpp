@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <formats/common/marco.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace detail
+{
+/*
+ * stage 1 of the two stage parser. the offsets of the structural characters of a document: the
+ * operators `{}[]:,` outside strings, the opening quotes of strings and the first bytes of the other
+ * scalars. the text is classified by 64 bytes blocks, escaped quotes and string bodies are masked
+ * out with bit tricks instead of branches.
+ */
+class structural_index
+{
+public:
+  /* documents whose offsets do not fit the index */
+  static constexpr size_t max_length = UINT32_MAX;
+
+  /*
+   * @brief: index [begin, end), the previous index is dropped but its storage is kept. a string
+   * which is never closed masks the rest of the text, the walk fails at its opening quote.
+   * @ret: false if the document is longer than max_length.
+   */
+  bool build(const char* begin, const char* end);
+
+  const uint32_t* begin() const { return offsets_.get(); }
+  const uint32_t* end() const { return offsets_.get() + size_; }
+
+  size_t size() const { return size_; }
+
+private:
+  void reserve(size_t capacity);
+
+private:
+  std::unique_ptr<uint32_t[]> offsets_;
+
+  size_t size_     = 0;
+  size_t capacity_ = 0;
+};
+
+/*
+ * @brief: split a root array for the parallel parse, with the block scan of the index. a split
+ * point is a `,` between two elements of the root, one is taken every chunk bytes about. the text
+ * is only scanned, the chunks are validated by their parse.
+ * @param[splits]: the offset of the `[` of the root, of the split points and of the `]` which
+ * closes the root, in order.
+ * @ret: false if the root is not an array or is not closed.
+ */
+bool split_array(const char* begin, const char* end, size_t chunk, std::vector<size_t>& splits);
+
+}  // namespace detail
+
+FORMATS_JSON_NAMESPACE_END
@@ -0,0 +1,69 @@
+#include <formats/jsoncpp/detail/thread_pool.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace detail
+{
+thread_pool::thread_pool(size_t threads)
+{
+  if (threads == 0) threads = hardware_threads();
+
+  workers_.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) workers_.emplace_back([this] { run(); });
+}
+
+thread_pool::~thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+
+  ready_.notify_all();
+  for (auto& worker : workers_) worker.join();
+}
+
+std::future<void> thread_pool::submit(std::function<void()> task)
+{
+  std::packaged_task<void()> packaged(std::move(task));
+  std::future<void>          future = packaged.get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(packaged));
+  }
+
+  ready_.notify_one();
+  return future;
+}
+
+size_t thread_pool::hardware_threads()
+{
+  size_t threads = std::thread::hardware_concurrency();
+  return threads ? threads : 1;
+}
+
+void thread_pool::run()
+{
+  while (true)
+  {
+    std::packaged_task<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ready_.wait(lock, [this] { return stopped_ || !tasks_.empty(); });
+
+      // the tasks left are run before the worker stops
+      if (tasks_.empty()) return void();
+
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    task();
+  }
+}
+
+}  // namespace detail
+
+FORMATS_JSON_NAMESPACE_END
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <formats/common/marco.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace detail
+{
+/*
+ * a fixed set of worker threads which run the tasks in the order they are submitted. the workers
+ * are started once and joined by the destructor, after the tasks already submitted are run.
+ */
+class thread_pool
+{
+public:
+  /* threads: the count of workers, 0 for one per hardware thread */
+  explicit thread_pool(size_t threads = 0);
+  ~thread_pool();
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /* @ret: the future of the task, it holds the exception the task throws */
+  std::future<void> submit(std::function<void()> task);
+
+  size_t size() const { return workers_.size(); }
+
+  /* the count of hardware threads, at least 1 */
+  static size_t hardware_threads();
+
+private:
+  void run();
+
+private:
+  std::vector<std::thread>               workers_;
+  std::deque<std::packaged_task<void()>> tasks_;
+
+  std::mutex              mutex_;
+  std::condition_variable ready_;
+  bool                    stopped_ = false;
+};
+
+}  // namespace detail
+
+FORMATS_JSON_NAMESPACE_END
@@ -0,0 +1,92 @@
+#include <formats/jsoncpp/document.hpp>
+
+#ifdef FORMATS_HAS_MEMORY_RESOURCE
+
+#include <formats/jsoncpp/detail/parser.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+document::document(std::size_t block_size)
+    : document(block_size, std::pmr::get_default_resource())
+{}
+
+document::document(std::size_t block_size, std::pmr::memory_resource* upstream)
+    : arena_(block_size, upstream)
+    , parser_(new detail::parser())
+{
+  clear();
+}
+
+document::~document() = default;
+
+bool document::parse(const char* data, parse_flag flag)
+{
+  return parse(data, std::char_traits<char>::length(data), flag);
+}
+
+bool document::parse(const char* begin, const char* end, parse_flag flag)
+{
+  clear();
+
+  parser_->max_depth(max_depth_);
+  parser_->parse(begin, end, *root_, error_, flag);
+
+  return !root_->is_error();
+}
+
+bool document::parse(const char* begin, std::size_t len, parse_flag flag)
+{
+  return parse(begin, begin + len, flag);
+}
+
+bool document::parse(const std::string& str, parse_flag flag)
+{
+  return parse(str.data(), str.data() + str.size(), flag);
+}
+
+bool document::parse(std::istream& is, parse_flag flag)
+{
+  clear();
+
+  parser_->max_depth(max_depth_);
+  parser_->parse(is, *root_, error_, flag);
+
+  return !root_->is_error();
+}
+
+bool document::parse_insitu(char* data, std::size_t len, parse_flag flag)
+{
+  clear();
+
+  parser_->max_depth(max_depth_);
+  parser_->parse_insitu(data, data + len, *root_, error_, flag);
+
+  return !root_->is_error();
+}
+
+bool document::parse_insitu(std::string&& text, parse_flag flag)
+{
+  clear();
+
+  // moved before the parse, a short string would move its bytes with it
+  text_ = std::move(text);
+
+  parser_->max_depth(max_depth_);
+  parser_->parse_insitu(text_.data(), text_.data() + text_.size(), *root_, error_, flag);
+
+  return !root_->is_error();
+}
+
+void document::clear() noexcept
+{
+  // the value is dropped with no destructor, its storage is all in the released blocks
+  arena_.release();
+  error_ = json::error();
+  std::string().swap(text_);
+
+  root_ = new (&root_storage_) pmr::value(&arena_);
+}
+
+FORMATS_JSON_NAMESPACE_END
+
+#endif  // FORMATS_HAS_MEMORY_RESOURCE
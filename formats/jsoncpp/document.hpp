@@ -0,0 +1,111 @@
+#pragma once
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include <formats/jsoncpp/value.hpp>
+#include <formats/jsoncpp/error.hpp>
+#include <formats/jsoncpp/flags.h>
+
+#ifdef FORMATS_HAS_MEMORY_RESOURCE
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace detail
+{
+class parser;
+}  // namespace detail
+
+/*
+ * document: a parsed json value whose strings, arrays and objects are all allocated from an arena
+ * owned by the document:
+ *
+ *   json::document doc;
+ *   if (doc.parse(text)) consume(doc.root());
+ *
+ * the arena hands out memory by bumping a pointer into blocks of growing size and frees nothing
+ * one by one. the value is never destroyed: a new parse, clear() and the destructor release all
+ * the blocks at once, whatever the size of the value. the root is a pmr::value on the arena. a
+ * value copied into the root stays on the arena, but a copy constructed from the root, or from one
+ * of its elements, is on the default resource as the copy of any pmr::value. it is given the
+ * arena explicitly to live there:
+ *
+ *   json::pmr::value copy(doc.root()["items"], doc.resource());
+ *
+ * a copy owns its strings: the views of parse_insitu() are copied into strings, so that a copy
+ * outlives the text. only a move with the same allocator keeps them views.
+ *
+ * the parser is kept from one parse to the next, with its buffers and its stack.
+ */
+class document
+{
+public:
+  /* the bytes of the first block of the arena, the next blocks are larger */
+  static constexpr std::size_t default_block_size = 64 * 1024;
+
+  /* upstream: the blocks of the arena are allocated from it */
+  explicit document(std::size_t block_size = default_block_size);
+  document(std::size_t block_size, std::pmr::memory_resource* upstream);
+  ~document();
+
+  document(const document&) = delete;
+  document& operator=(const document&) = delete;
+
+  /*
+   * @brief: parse a json value to the root, with the grammar of json::parse(). the previous root
+   * and all its storage are released first.
+   * @ret: false if the text is malformed, the root is the error value and error() tells why.
+   */
+  bool parse(const char* data, parse_flag flag = parse_flag::strict);
+  bool parse(const char* begin, const char* end, parse_flag flag = parse_flag::strict);
+  bool parse(const char* begin, std::size_t len, parse_flag flag = parse_flag::strict);
+  bool parse(const std::string& str, parse_flag flag = parse_flag::strict);
+  bool parse(std::istream& is, parse_flag flag = parse_flag::strict);
+
+  /*
+   * @brief: parse in situ, as parse() but the strings are views of the text of kind string_view,
+   * not copies. a string an escape changes is unescaped into the text over its raw form, so the
+   * text is modified. the keys of the objects are still copied. the caller's text must outlive
+   * the root, a text given by value is kept by the document until the next parse or clear().
+   */
+  bool parse_insitu(char* data, std::size_t len, parse_flag flag = parse_flag::strict);
+  bool parse_insitu(std::string&& text, parse_flag flag = parse_flag::strict);
+
+  pmr::value&        root() noexcept { return *root_; }
+  const pmr::value&  root() const noexcept { return *root_; }
+  const json::error& error() const noexcept { return error_; }
+
+  /*
+   * @brief: the most containers nested in a document, deeper is error_code::too_deep.
+   * JSON_MAX_DEPTH by default. the nesting costs no call stack to parse or to free the
+   * document; copying, comparing or serializing its root still recurses.
+   */
+  void        max_depth(std::size_t depth) noexcept { max_depth_ = depth; }
+  std::size_t max_depth() const noexcept { return max_depth_; }
+
+  /* the arena, to allocate more values that live as long as the root */
+  std::pmr::memory_resource* resource() noexcept { return &arena_; }
+
+  /* @brief: release the root and the arena, the root is null then */
+  void clear() noexcept;
+
+private:
+  std::pmr::monotonic_buffer_resource arena_;
+
+  // the root is never destroyed. its storage is out of the arena, so clear() allocates nothing
+  std::aligned_storage_t<sizeof(pmr::value), alignof(pmr::value)> root_storage_;
+
+  pmr::value* root_ = nullptr;
+  json::error error_;
+  std::size_t max_depth_ = JSON_MAX_DEPTH;
+
+  std::unique_ptr<detail::parser> parser_;
+
+  std::string text_;  // of parse_insitu, the strings of the root are views of it
+};
+
+FORMATS_JSON_NAMESPACE_END
+
+#endif  // FORMATS_HAS_MEMORY_RESOURCE
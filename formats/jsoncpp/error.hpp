@@ -30,6 +30,7 @@ enum error_code
 
   too_deep,
   no_end,
+  aborted,
 };
 
 inline const char* error_desc(error_code ec)
@@ -56,6 +57,7 @@ inline const char* error_desc(error_code ec)
       "illeagl comments",        /*illeagl_comments*/
       "too deep",                /*too_deep*/
       "no end",                  /*no_end*/
+      "aborted by handler",      /*aborted*/
   };
 
   return messages[ec];
@@ -103,7 +105,7 @@ public:
 public:
   const char* what() const noexcept { return message_.c_str(); }
 
-  int code() { return code_; }
+  int code() const { return code_; }
 
 private:
   error_code  code_ = error_code::none;
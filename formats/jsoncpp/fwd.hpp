@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include <memory>
 #include <string>
 
 #include <formats/common/marco.hpp>
@@ -7,7 +8,12 @@
 FORMATS_JSON_NAMESPACE_BEGIN
 
 class error;
-class value;
+class sax;
+
+template <typename Allocator>
+class basic_value;
+
+using value = basic_value<std::allocator<char>>;
 
 namespace detail
 {
@@ -1,6 +1,14 @@
-#pragma once
+﻿#pragma once
 
 #include <formats/jsoncpp/parse.hpp>
+#include <formats/jsoncpp/document.hpp>
+#include <formats/jsoncpp/ndjson.hpp>
+#include <formats/jsoncpp/ondemand.hpp>
+#include <formats/jsoncpp/parser.hpp>
+#include <formats/jsoncpp/path.hpp>
+#include <formats/jsoncpp/pointer.hpp>
+#include <formats/jsoncpp/push_parser.hpp>
+#include <formats/jsoncpp/sax.hpp>
 #include <formats/jsoncpp/stringify.hpp>
 #include <formats/jsoncpp/value.hpp>
 #include <formats/jsoncpp/conversion.hpp>
\ No newline at end of file
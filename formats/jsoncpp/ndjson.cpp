@@ -0,0 +1,302 @@
+#include <formats/jsoncpp/ndjson.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <fstream>
+
+#include <formats/common/file/mapped_file.hpp>
+#include <formats/common/simd/simd.hpp>
+#include <formats/jsoncpp/detail/parser.hpp>
+#include <formats/jsoncpp/detail/thread_pool.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace
+{
+bool has_flag(parse_flag flag, parse_flag bit)
+{
+  return ((unsigned long long)flag & (unsigned long long)bit) == (unsigned long long)bit;
+}
+
+bool is_blank(const char* ptr, const char* end)
+{
+  for (; ptr != end; ++ptr)
+  {
+    if (*ptr != ' ' && *ptr != '\t' && *ptr != '\r') return false;
+  }
+
+  return true;
+}
+
+// a stream is read by blocks of this size, a record longer than a block makes the buffer grow
+constexpr size_t stream_block = 4 * ndjson_reader::batch_bytes;
+
+}  // namespace
+
+struct ndjson_reader::batch
+{
+  std::vector<record>                              records;
+  std::vector<std::pair<const char*, const char*>> texts;  // of the records, to the line feed
+  std::future<void>                                parsed;
+};
+
+ndjson_reader::ndjson_reader(parse_flag flag, size_t threads)
+    // a record is a root, any value may be a root
+    : flag_((parse_flag)((unsigned long long)flag | (unsigned long long)parse_flag::root_lenient))
+    , multi_lines_(has_flag(flag, parse_flag::string_multi_lines) ||
+                   has_flag(flag, parse_flag::comments))
+{
+  if (threads == 0) threads = detail::thread_pool::hardware_threads();
+  if (threads > 1) pool_.reset(new detail::thread_pool(threads));
+}
+
+ndjson_reader::~ndjson_reader() = default;
+
+bool ndjson_reader::read(const char* begin, const char* end, const callback& cb)
+{
+  progress state;
+  read_records(begin, end, true, state, cb);
+  return state.ok;
+}
+
+bool ndjson_reader::read(const std::string& str, const callback& cb)
+{
+  return read(str.data(), str.data() + str.size(), cb);
+}
+
+bool ndjson_reader::read(std::istream& is, const callback& cb)
+{
+  progress    state;
+  std::string buffer;
+  size_t      size = 0;
+
+  while (!state.stopped && is.good())
+  {
+    buffer.resize(size + stream_block);
+    is.read(&buffer[size], stream_block);
+    size += (size_t)is.gcount();
+
+    // the last record is complete at the end of the stream only
+    bool        last = !is.good();
+    const char* rest = read_records(buffer.data(), buffer.data() + size, last, state, cb);
+
+    size -= rest - buffer.data();
+    buffer.erase(0, rest - buffer.data());
+  }
+
+  return state.ok && !is.bad();
+}
+
+bool ndjson_reader::load(const std::string& filepath, const callback& cb)
+{
+  file::mapped_file mapped;
+  if (mapped.open(filepath)) return read(mapped.begin(), mapped.end(), cb);
+
+  std::ifstream is(filepath, std::ios::in | std::ios::binary);
+  return is.is_open() && read(is, cb);
+}
+
+bool ndjson_reader::read(const char* begin, const char* end, std::vector<record>& records)
+{
+  return read(begin, end, [&records](record& rec) {
+    records.push_back(std::move(rec));
+    return true;
+  });
+}
+
+bool ndjson_reader::read(const std::string& str, std::vector<record>& records)
+{
+  return read(str.data(), str.data() + str.size(), records);
+}
+
+size_t ndjson_reader::threads() const
+{
+  return pool_ ? pool_->size() : 1;
+}
+
+const char* ndjson_reader::read_records(const char* begin, const char* end, bool last,
+                                        progress& state, const callback& cb)
+{
+  // the batches being parsed, in the order of the input. twice the threads keeps them all busy
+  std::deque<std::unique_ptr<batch>> pending;
+  std::vector<std::unique_ptr<batch>> spare;
+
+  size_t max_pending = 2 * threads();
+
+  // the texts must outlive the parse of the batches, whatever is thrown
+  struct drain_guard
+  {
+    std::deque<std::unique_ptr<batch>>& pending;
+    ~drain_guard()
+    {
+      for (auto& b : pending)
+      {
+        if (b->parsed.valid()) b->parsed.wait();
+      }
+    }
+  } guard{pending};
+
+  const char* ptr = begin;
+  while (ptr != end && !state.stopped)
+  {
+    std::unique_ptr<batch> b;
+    if (spare.empty())
+      b.reset(new batch);
+    else
+    {
+      b = std::move(spare.back());
+      spare.pop_back();
+    }
+
+    const char* first = ptr;
+    while (ptr != end && (size_t)(ptr - first) < batch_bytes)
+    {
+      const char* lf = record_end(ptr, end);
+
+      // the rest of the record comes with the next input
+      if (lf == end && !last) break;
+
+      size_t line = state.line;
+      state.line += 1 + (multi_lines_ ? (size_t)std::count(ptr, lf, '\n') : 0);
+
+      if (!is_blank(ptr, lf))
+      {
+        b->records.emplace_back();
+        b->records.back().line = line;
+
+        b->texts.emplace_back(ptr, lf);
+      }
+
+      ptr = (lf == end) ? end : lf + 1;
+    }
+
+    bool incomplete = (ptr != end && (size_t)(ptr - first) < batch_bytes);
+
+    if (!pool_)
+    {
+      parse_batch(*b);
+      deliver(*b, state, cb);
+      spare.push_back(std::move(b));
+    }
+    else
+    {
+      batch* raw = b.get();
+      b->parsed  = pool_->submit([this, raw] { parse_batch(*raw); });
+      pending.push_back(std::move(b));
+
+      while (pending.size() >= max_pending || (!pending.empty() && (incomplete || ptr == end)))
+      {
+        deliver(*pending.front(), state, cb);
+        spare.push_back(std::move(pending.front()));
+        pending.pop_front();
+      }
+    }
+
+    if (incomplete) return ptr;
+  }
+
+  while (!pending.empty())
+  {
+    deliver(*pending.front(), state, cb);
+    pending.pop_front();
+  }
+
+  return ptr;
+}
+
+const char* ndjson_reader::record_end(const char* ptr, const char* end) const
+{
+  // a line feed is never part of a string of the strict grammar, it ends the record
+  if (!multi_lines_)
+  {
+    const void* lf = memchr(ptr, '\n', end - ptr);
+    return lf ? static_cast<const char*>(lf) : end;
+  }
+
+  bool single_quotes = has_flag(flag_, parse_flag::string_single_quotes);
+  bool comments      = has_flag(flag_, parse_flag::comments);
+
+  while (ptr != end)
+  {
+    char c = *ptr;
+    if (c == '\n') return ptr;
+
+    if (c == '"' || (c == '\'' && single_quotes))
+      ptr = string_end(ptr + 1, end, c);
+    else if (c == '/' && comments && end - ptr > 1 && (ptr[1] == '/' || ptr[1] == '*'))
+      ptr = comment_end(ptr, end);
+    else
+      ++ptr;
+  }
+
+  return end;
+}
+
+const char* ndjson_reader::string_end(const char* ptr, const char* end, char quote) const
+{
+  while (true)
+  {
+    ptr = simd::scan_string(ptr, end, quote, false);
+    if (ptr == end) return end;
+
+    if (*ptr == quote) return ptr + 1;
+
+    // an escaped line feed continues the string, a raw one is an error which ends the record
+    if (*ptr == '\\')
+      ptr = (end - ptr > 1) ? ptr + 2 : end;
+    else if (*ptr == '\n')
+      return ptr;
+    else
+      ++ptr;
+  }
+}
+
+const char* ndjson_reader::comment_end(const char* ptr, const char* end) const
+{
+  // a single line comment ends at the line feed, which ends the record too
+  if (ptr[1] == '/')
+  {
+    const void* lf = memchr(ptr, '\n', end - ptr);
+    return lf ? static_cast<const char*>(lf) : end;
+  }
+
+  for (ptr += 2; end - ptr > 1; ++ptr)
+  {
+    if (ptr[0] == '*' && ptr[1] == '/') return ptr + 2;
+  }
+
+  return end;
+}
+
+void ndjson_reader::parse_batch(batch& b) const
+{
+  // a record is a line, a second value on it is an error
+  detail::parser parser;
+  parser.single_root(true);
+
+  for (size_t i = 0; i < b.records.size(); ++i)
+  {
+    record& rec = b.records[i];
+    rec.value   = parser.parse(b.texts[i].first, b.texts[i].second, rec.error, flag_);
+  }
+}
+
+void ndjson_reader::deliver(batch& b, progress& state, const callback& cb) const
+{
+  // a task which threw, bad_alloc, throws here
+  if (b.parsed.valid()) b.parsed.get();
+
+  for (auto& rec : b.records)
+  {
+    if (state.stopped) break;
+
+    if (rec.value.is_error()) state.ok = false;
+    if (!cb(rec)) state.stopped = true;
+  }
+
+  b.records.clear();
+  b.texts.clear();
+}
+
+FORMATS_JSON_NAMESPACE_END
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <functional>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <formats/jsoncpp/value.hpp>
+#include <formats/jsoncpp/error.hpp>
+#include <formats/jsoncpp/flags.h>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace detail
+{
+class thread_pool;
+}  // namespace detail
+
+/*
+ * ndjson_reader: read newline delimited json (JSON Lines), a value per line. the input is split
+ * into records at the line feeds outside strings on the calling thread, the records are parsed by
+ * batches on a pool of threads and are delivered in the order of the input:
+ *
+ *   json::ndjson_reader reader;
+ *   reader.load("events.jsonl", [](json::ndjson_reader::record& rec) {
+ *     if (rec.value.is_object()) consume(rec.value);
+ *     return true;
+ *   });
+ *
+ * a record is parsed with the grammar of parse() and the flags of the reader, its root may be any
+ * value. only white space and comments may follow it on its line. the lines of white space are
+ * skipped. a malformed record does not stop the reading, it is delivered with its error.
+ */
+class ndjson_reader
+{
+public:
+  struct record
+  {
+    size_t      line = 0;  // the line of the record in the input, from 1
+    json::value value;     // of kind error if the record is malformed
+    json::error error;
+  };
+
+  /* takes each record in turn, returns false to stop reading */
+  using callback = std::function<bool(record&)>;
+
+  /* threads: the count of parse threads, 0 for one per hardware thread, 1 parses on the caller */
+  explicit ndjson_reader(parse_flag flag = parse_flag::strict, size_t threads = 0);
+  ~ndjson_reader();
+
+  ndjson_reader(const ndjson_reader&) = delete;
+  ndjson_reader& operator=(const ndjson_reader&) = delete;
+
+  /*
+   * @brief: parse the records and pass them to cb in order, on the calling thread. a regular file
+   * is mapped into memory, a stream is read by blocks. the text must outlive the call only.
+   * @ret: false if a record is malformed, or the input can't be read.
+   */
+  bool read(const char* begin, const char* end, const callback& cb);
+  bool read(const std::string& str, const callback& cb);
+  bool read(std::istream& is, const callback& cb);
+  bool load(const std::string& filepath, const callback& cb);
+
+  /* @brief: parse all the records to records, in order */
+  bool read(const char* begin, const char* end, std::vector<record>& records);
+  bool read(const std::string& str, std::vector<record>& records);
+
+  /* the count of parse threads */
+  size_t threads() const;
+
+  /* records are parsed by batches of batch_bytes of text, at most */
+  static constexpr size_t batch_bytes = 256 * 1024;
+
+private:
+  struct batch;
+
+  struct progress
+  {
+    size_t line    = 1;
+    bool   ok      = true;
+    bool   stopped = false;
+  };
+
+  /* @ret: the begin of the last record if it has no line feed and more input is coming, or end */
+  const char* read_records(const char* begin, const char* end, bool last, progress& state,
+                           const callback& cb);
+
+  const char* record_end(const char* ptr, const char* end) const;
+  const char* string_end(const char* ptr, const char* end, char quote) const;
+  const char* comment_end(const char* ptr, const char* end) const;
+
+  void parse_batch(batch& b) const;
+  void deliver(batch& b, progress& state, const callback& cb) const;
+
+private:
+  parse_flag flag_;
+  bool       multi_lines_;  // a record may span lines: a string with a line break, a comment
+
+  std::unique_ptr<detail::thread_pool> pool_;  // none with a single thread
+};
+
+FORMATS_JSON_NAMESPACE_END
@@ -0,0 +1,308 @@
+#include <formats/jsoncpp/ondemand.hpp>
+
+#include <cstring>
+#include <limits>
+
+#include <formats/common/exception.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace ondemand
+{
+namespace
+{
+const char* kind_name(json::kind k)
+{
+  const char* kinds_name[] = {"error",        "null",   "boolean", "number_int", "number_uint",
+                              "number_float", "string", "array",   "object"};
+
+  return kinds_name[(int)k];
+}
+}  // namespace
+
+json::kind value::kind() const noexcept
+{
+  switch (first())
+  {
+    case '{': return json::kind::object;
+    case '[': return json::kind::array;
+    case '"': return json::kind::string;
+    case 't':
+    case 'f': return json::kind::boolean;
+    case 'n': return json::kind::null;
+    case '\0': return json::kind::error;
+    default: break;
+  }
+
+  // the kind of a number depends on its text
+  return get_value().kind();
+}
+
+bool value::is_number() const noexcept
+{
+  char c = first();
+  return c == '-' || (c >= '0' && c <= '9');
+}
+
+bool value::is_string() const noexcept
+{
+  return first() == '"';
+}
+
+bool value::is_array() const noexcept
+{
+  return first() == '[';
+}
+
+bool value::is_object() const noexcept
+{
+  return first() == '{';
+}
+
+value value::operator[](const char* key) const noexcept
+{
+  return find(key, strlen(key));
+}
+
+value value::operator[](const std::string& key) const noexcept
+{
+  return find(key.data(), key.size());
+}
+
+value value::at(size_t pos) const noexcept
+{
+  if (first() != '[') return value();
+
+  const uint32_t* ptr = pos_ + 1;
+  if (ptr == doc_->end_)
+  {
+    doc_->malformed(error_code::missing_end_array);
+    return value();
+  }
+
+  if (doc_->at_offset(ptr) == ']') return value();
+
+  for (size_t i = 0;; ++i)
+  {
+    if (i == pos) return value(doc_, ptr);
+
+    ptr = doc_->skip(ptr);
+    if (ptr == doc_->end_ || (doc_->at_offset(ptr) != ',' && doc_->at_offset(ptr) != ']'))
+    {
+      doc_->malformed(error_code::missing_end_array);
+      return value();
+    }
+
+    if (doc_->at_offset(ptr) == ']' || ++ptr == doc_->end_) return value();
+  }
+}
+
+size_t value::size() const noexcept
+{
+  char c = first();
+  if (c != '[' && c != '{') return 0;
+
+  const uint32_t* ptr = pos_ + 1;
+  if (ptr == doc_->end_ || doc_->at_offset(ptr) == ']' || doc_->at_offset(ptr) == '}') return 0;
+
+  // an element is skipped as a whole, a member as its key and its value
+  size_t count = 0;
+  while (ptr != doc_->end_)
+  {
+    if (c == '{') ptr += 2;
+    if (ptr >= doc_->end_) break;
+
+    ptr = doc_->skip(ptr);
+    ++count;
+
+    if (ptr == doc_->end_ || doc_->at_offset(ptr) != ',') break;
+    ++ptr;
+  }
+
+  return count;
+}
+
+bool value::get_bool() const noexcept(false)
+{
+  json::value v = parse_scalar("get_bool");
+  FORMATS_THROW_IF(!v.is_bool(),
+                   type_except::create("can't use get_bool with type", kind_name(v.kind())));
+  return v.as_bool();
+}
+
+long long value::get_int64() const noexcept(false)
+{
+  json::value v = parse_scalar("get_int64");
+
+  if (v.is_uint64() && v.as_uint64() <= (unsigned long long)(std::numeric_limits<long long>::max)())
+    return (long long)v.as_uint64();
+
+  FORMATS_THROW_IF(!v.is_int64(),
+                   type_except::create("can't use get_int64 with type", kind_name(v.kind())));
+  return v.as_int64();
+}
+
+unsigned long long value::get_uint64() const noexcept(false)
+{
+  json::value v = parse_scalar("get_uint64");
+  FORMATS_THROW_IF(!v.is_uint64(),
+                   type_except::create("can't use get_uint64 with type", kind_name(v.kind())));
+  return v.as_uint64();
+}
+
+double value::get_double() const noexcept(false)
+{
+  json::value v = parse_scalar("get_double");
+  FORMATS_THROW_IF(!v.is_number(),
+                   type_except::create("can't use get_double with type", kind_name(v.kind())));
+  return v.to_double();
+}
+
+std::string value::get_string() const noexcept(false)
+{
+  json::value v = parse_scalar("get_string");
+  FORMATS_THROW_IF(!v.is_string(),
+                   type_except::create("can't use get_string with type", kind_name(v.kind())));
+  return std::move(v.as_string());
+}
+
+json::value value::get_value() const noexcept
+{
+  if (!pos_) return json::kind::error;
+
+  json::value v;
+  doc_->parser_.parse_indexed_at(pos_, v, doc_->error_);
+  return v;
+}
+
+char value::first() const noexcept
+{
+  return pos_ ? doc_->at_offset(pos_) : '\0';
+}
+
+bool value::key_equals(const uint32_t* pos, const char* key, size_t length) const noexcept
+{
+  // the closing quote is the last one before the name separator
+  const char* raw   = doc_->base_ + *pos + 1;
+  const char* close = doc_->base_ + *(pos + 1);
+  while (close > raw && *(close - 1) != '"') --close;
+
+  if (close == raw) return false;
+  --close;
+
+  // no escape, the key is its text
+  if (!memchr(raw, '\\', close - raw))
+    return (size_t)(close - raw) == length && memcmp(raw, key, length) == 0;
+
+  json::value decoded = value(doc_, pos).get_value();
+  return decoded.is_string() && decoded.as_string().size() == length &&
+         memcmp(decoded.as_string().data(), key, length) == 0;
+}
+
+value value::find(const char* key, size_t length) const noexcept
+{
+  if (first() != '{') return value();
+
+  const uint32_t* ptr = pos_ + 1;
+  if (ptr == doc_->end_)
+  {
+    doc_->malformed(error_code::missing_end_object);
+    return value();
+  }
+
+  if (doc_->at_offset(ptr) == '}') return value();
+
+  while (true)
+  {
+    if (doc_->at_offset(ptr) != '"')
+    {
+      doc_->malformed(error_code::missing_quotation_mark);
+      return value();
+    }
+
+    if (ptr + 2 >= doc_->end_ || doc_->at_offset(ptr + 1) != ':')
+    {
+      doc_->malformed(error_code::missing_name_separator);
+      return value();
+    }
+
+    if (key_equals(ptr, key, length)) return value(doc_, ptr + 2);
+
+    ptr = doc_->skip(ptr + 2);
+    if (ptr == doc_->end_ || (doc_->at_offset(ptr) != ',' && doc_->at_offset(ptr) != '}'))
+    {
+      doc_->malformed(error_code::missing_end_object);
+      return value();
+    }
+
+    if (doc_->at_offset(ptr) == '}') return value();
+
+    if (++ptr == doc_->end_)
+    {
+      doc_->malformed(error_code::missing_end_object);
+      return value();
+    }
+  }
+}
+
+json::value value::parse_scalar(const char* func_name) const noexcept(false)
+{
+  FORMATS_THROW_IF(!pos_, type_except::create(std::string("can't use ") + func_name +
+                                              " with type:error"));
+
+  json::value v = get_value();
+  FORMATS_THROW_IF(v.is_error(), type_except::create(std::string("can't use ") + func_name +
+                                                     ", " + doc_->error_.what()));
+  return v;
+}
+
+document::document(const char* begin, const char* end)
+{
+  if (!parser_.index(begin, end, error_)) return;
+
+  base_    = parser_.indexed_base();
+  offsets_ = parser_.indexed().begin();
+  end_     = parser_.indexed().end();
+}
+
+document::document(const char* begin, size_t len)
+    : document(begin, begin + len)
+{}
+
+document::document(const std::string& str)
+    : document(str.data(), str.data() + str.size())
+{}
+
+value document::root() noexcept
+{
+  return base_ ? value(this, offsets_) : value();
+}
+
+const uint32_t* document::skip(const uint32_t* pos) const noexcept
+{
+  char c = at_offset(pos);
+  if (c != '{' && c != '[') return pos + 1;
+
+  // the brackets of the subtree are counted, not matched
+  size_t depth = 0;
+  for (; pos != end_; ++pos)
+  {
+    c = at_offset(pos);
+
+    if (c == '{' || c == '[')
+      ++depth;
+    else if ((c == '}' || c == ']') && --depth == 0)
+      return pos + 1;
+  }
+
+  return end_;
+}
+
+void document::malformed(error_code code) noexcept
+{
+  error_ = json::error(code, error_desc(code));
+}
+
+}  // namespace ondemand
+
+FORMATS_JSON_NAMESPACE_END
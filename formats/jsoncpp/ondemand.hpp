@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include <formats/jsoncpp/value.hpp>
+#include <formats/jsoncpp/error.hpp>
+#include <formats/jsoncpp/detail/parser.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace ondemand
+{
+class document;
+
+/*
+ * value: a cursor on a value of an on demand document. nothing is parsed until it is asked for,
+ * a lookup walks the structural index and skips the subtrees in between without building them.
+ *
+ * a value is a view of its document, valid while the document lives. a lookup which fails gives
+ * a value of kind error, the lookups on it fail too. the skipped subtrees are not validated.
+ */
+class value
+{
+public:
+  value() = default;
+
+  json::kind kind() const noexcept;
+
+  bool is_error() const noexcept { return pos_ == nullptr; }
+  bool is_null() const noexcept { return kind() == json::kind::null; }
+  bool is_bool() const noexcept { return kind() == json::kind::boolean; }
+  bool is_number() const noexcept;
+  bool is_string() const noexcept;
+  bool is_array() const noexcept;
+  bool is_object() const noexcept;
+
+  /* member of an object by key, element of an array by index */
+  value operator[](const char* key) const noexcept;
+  value operator[](const std::string& key) const noexcept;
+  value at(size_t pos) const noexcept;
+
+  template <typename T, std::enable_if_t<std::is_integral<T>::value, int> = 0>
+  value operator[](T pos) const noexcept
+  {
+    return at((size_t)pos);
+  }
+
+  /* count of the members or the elements, 0 if not a container */
+  size_t size() const noexcept;
+
+  /*
+   * @brief: parse the value. throws type_except if it is not of the kind asked for, or is not
+   * well formed. get_int64 takes the unsigned numbers which fit, get_double takes all numbers.
+   */
+  bool               get_bool() const noexcept(false);
+  long long          get_int64() const noexcept(false);
+  unsigned long long get_uint64() const noexcept(false);
+  double             get_double() const noexcept(false);
+  std::string        get_string() const noexcept(false);
+
+  /* build the json::value of the value and its subtree */
+  json::value get_value() const noexcept;
+
+private:
+  friend class document;
+
+  value(document* doc, const uint32_t* pos)
+      : doc_(doc)
+      , pos_(pos)
+  {}
+
+  char first() const noexcept;
+  bool key_equals(const uint32_t* pos, const char* key, size_t length) const noexcept;
+  value find(const char* key, size_t length) const noexcept;
+
+  json::value parse_scalar(const char* func_name) const noexcept(false);
+
+private:
+  document*       doc_ = nullptr;
+  const uint32_t* pos_ = nullptr;  // the first structural character of the value
+};
+
+/*
+ * document: wraps a strict json text for on demand access. its structural index is built once on
+ * construction, the values are parsed when they are asked for:
+ *
+ *   json::ondemand::document doc(text.data(), text.size());
+ *   long long id = doc["user"]["id"].get_int64();
+ *
+ * the text is not copied, it must outlive the document and its values.
+ */
+class document
+{
+public:
+  document(const char* begin, const char* end);
+  document(const char* begin, size_t len);
+  explicit document(const std::string& str);
+
+  document(const document&) = delete;
+  document& operator=(const document&) = delete;
+
+  /* the root value, of kind error if the document has no object or array root */
+  value root() noexcept;
+
+  value operator[](const char* key) noexcept { return root()[key]; }
+  value operator[](const std::string& key) noexcept { return root()[key]; }
+  value at(size_t pos) noexcept { return root().at(pos); }
+
+  template <typename T, std::enable_if_t<std::is_integral<T>::value, int> = 0>
+  value operator[](T pos) noexcept
+  {
+    return at((size_t)pos);
+  }
+
+  /* the last error of indexing, a lookup or a parse of a value */
+  json::error last_error() const noexcept { return error_; }
+
+private:
+  friend class value;
+
+  const uint32_t* skip(const uint32_t* pos) const noexcept;
+  char            at_offset(const uint32_t* pos) const noexcept { return base_[*pos]; }
+
+  void malformed(error_code code) noexcept;
+
+private:
+  detail::parser parser_;
+  json::error    error_;
+
+  const char*     base_    = nullptr;
+  const uint32_t* offsets_ = nullptr;
+  const uint32_t* end_     = nullptr;
+};
+
+}  // namespace ondemand
+
+FORMATS_JSON_NAMESPACE_END
@@ -1,6 +1,8 @@
 ﻿#include <formats/jsoncpp/parse.hpp>
 #include <formats/jsoncpp/detail/parser.hpp>
+#include <formats/jsoncpp/detail/parallel_parse.hpp>
 
+#include <formats/common/file/mapped_file.hpp>
 #include <formats/common/unicode/unicode.hpp>
 #include <formats/common/number.hpp>
 #include <formats/common/cctypes.hpp>
@@ -35,6 +37,34 @@ bool parse(value& jv, std::istream& is, parse_flag flag)
   return (jv.kind() != json::kind::error);
 }
 
+#ifdef FORMATS_HAS_MEMORY_RESOURCE
+bool parse(pmr::value& jv, const char* data, parse_flag flag)
+{
+  return parse(jv, data, std::char_traits<char>::length(data), flag);
+}
+
+bool parse(pmr::value& jv, const char* begin, const char* end, parse_flag flag)
+{
+  error err;
+  formats::json::detail::parser().parse(begin, end, jv, err, flag);
+
+  return (jv.kind() != json::kind::error);
+}
+
+bool parse(pmr::value& jv, const char* begin, std::size_t len, parse_flag flag)
+{
+  return parse(jv, begin, begin + len, flag);
+}
+
+bool parse(pmr::value& jv, std::istream& is, parse_flag flag)
+{
+  error err;
+  formats::json::detail::parser().parse(is, jv, err, flag);
+
+  return (jv.kind() != json::kind::error);
+}
+#endif  // FORMATS_HAS_MEMORY_RESOURCE
+
 value parse(const char* data, parse_flag flag)
 {
   return parse(data, std::char_traits<char>::length(data), flag);
@@ -66,7 +96,7 @@ value parse(std::istream& is, parse_flag flag)
   if (res.kind() == json::kind::error) { FORMATS_THROW(parse_except::create(err.what())); }
 #endif  // THROW_PARSE_ERROR
 
-  return false;
+  return res;
 }
 
 value parse(const char* data, error& error, parse_flag flag)
@@ -99,8 +129,92 @@ value parse(std::istream& is, error& error, parse_flag flag)
   return formats::json::detail::parser().parse(is, error, flag);
 }
 
+bool fast_parse(value& jv, const char* begin, const char* end)
+{
+  error err;
+  jv = fast_parse(begin, end, err);
+
+  return (jv.kind() != json::kind::error);
+}
+
+value fast_parse(const char* data)
+{
+  return fast_parse(data, std::char_traits<char>::length(data));
+}
+
+value fast_parse(const char* begin, const char* end)
+{
+  error err;
+  auto  res = fast_parse(begin, end, err);
+
+#ifdef THROW_PARSE_ERROR
+  if (res.kind() == json::kind::error) { FORMATS_THROW(parse_except::create(err.what())); }
+#endif  // THROW_PARSE_ERROR
+
+  return res;
+}
+
+value fast_parse(const char* begin, std::size_t len)
+{
+  return fast_parse(begin, begin + len);
+}
+
+value fast_parse(const char* begin, const char* end, error& error)
+{
+  if (!begin || !end || begin >= end) return value();
+
+  return formats::json::detail::parser().parse_indexed(begin, end, error);
+}
+
+value fast_parse(const char* begin, std::size_t len, error& error)
+{
+  return fast_parse(begin, begin + len, error);
+}
+
+bool parallel_parse(value& jv, const char* begin, const char* end, std::size_t threads)
+{
+  error err;
+  jv = parallel_parse(begin, end, err, threads);
+
+  return (jv.kind() != json::kind::error);
+}
+
+value parallel_parse(const char* begin, const char* end, std::size_t threads)
+{
+  error err;
+  auto  res = parallel_parse(begin, end, err, threads);
+
+#ifdef THROW_PARSE_ERROR
+  if (res.kind() == json::kind::error) { FORMATS_THROW(parse_except::create(err.what())); }
+#endif  // THROW_PARSE_ERROR
+
+  return res;
+}
+
+value parallel_parse(const char* begin, std::size_t len, std::size_t threads)
+{
+  return parallel_parse(begin, begin + len, threads);
+}
+
+value parallel_parse(const char* begin, const char* end, error& error, std::size_t threads)
+{
+  if (!begin || !end || begin >= end) return value();
+
+  return formats::json::detail::parse_parallel(begin, end, error, threads);
+}
+
+value parallel_parse(const char* begin, std::size_t len, error& error, std::size_t threads)
+{
+  return parallel_parse(begin, begin + len, error, threads);
+}
+
 bool load(const std::string& filepath, json::value& value, parse_flag flag)
 {
+  // a regular file is parsed in place, with no copy to a buffer
+  file::mapped_file mapped;
+  if (mapped.open(filepath)) return parse(value, mapped.begin(), mapped.end(), flag);
+
+  // a pipe, a device or an empty file is read as a stream
   bool result = false;
 
   std::ifstream is;
@@ -26,6 +26,20 @@ bool parse(value&, const char* begin, const char* end, parse_flag flag = parse_f
 bool parse(value&, const char* begin, std::size_t len, parse_flag flag = parse_flag::strict);
 bool parse(value&, std::istream& is, parse_flag flag = parse_flag::strict);
 
+#ifdef FORMATS_HAS_MEMORY_RESOURCE
+/*
+ * @brief: Parse a json value to a value on a memory resource, such as a pool per request. The
+ * strings, arrays and objects parsed are allocated by the allocator of the value, the one it was
+ * constructed with. no throw when parse failed.
+ *
+ * @return: true if parse success, otherwise false.
+ */
+bool parse(pmr::value&, const char* data, parse_flag flag = parse_flag::strict);
+bool parse(pmr::value&, const char* begin, const char* end, parse_flag flag = parse_flag::strict);
+bool parse(pmr::value&, const char* begin, std::size_t len, parse_flag flag = parse_flag::strict);
+bool parse(pmr::value&, std::istream& is, parse_flag flag = parse_flag::strict);
+#endif  // FORMATS_HAS_MEMORY_RESOURCE
+
 /*
  * @brief: Parse a json value from string or stream. The default behavior don't throw error when
  * parse failed. If you want throws error, define preprocessor(THROW_PARSE_ERROR).
@@ -65,7 +79,54 @@ value parse(const char* begin, std::size_t len, error& error, parse_flag flag =
 value parse(std::istream& is, error& error, parse_flag flag = parse_flag::strict);
 
 /*
- * @brief: Parse a json value from file.
+ * @brief: Parse a json value with the two stage parser. The structural index of the whole document
+ * is built by blocks first: the positions of `{}[]:,` outside strings and of the first bytes of
+ * scalars. The value is built by walking the index then. Only the strict ECMA404 grammar is
+ * supported, the root is an object or an array and nothing but white space may follow it.
+ *
+ * @param:
+ *  value: the reference of the value parse to.
+ *  error: the reference of parse error
+ *  data: string to parse
+ *  begin: pointer at source string begining
+ *  end:   pointer at source string ending
+ *  len:   length of source string. bytes.
+ *
+ * @return json::value parse to, or true if parse success.
+ */
+bool  fast_parse(value&, const char* begin, const char* end);
+value fast_parse(const char* data);
+value fast_parse(const char* begin, const char* end);
+value fast_parse(const char* begin, std::size_t len);
+value fast_parse(const char* begin, const char* end, error& error);
+value fast_parse(const char* begin, std::size_t len, error& error);
+
+/*
+ * @brief: Parse a large json document whose root is an array on several threads. The root is split
+ * between its elements by a block scan, the chunks are parsed by a pool of threads and spliced in
+ * order. Only the strict ECMA404 grammar is supported. Another root, a document under 1 MiB or a
+ * malformed one is parsed like parse() on the calling thread, the errors and their positions are
+ * those of parse().
+ *
+ * @param:
+ *  value: the reference of the value parse to.
+ *  error: the reference of parse error
+ *  begin: pointer at source string begining
+ *  end:   pointer at source string ending
+ *  len:   length of source string. bytes.
+ *  threads: count of threads, 0 for one per hardware thread.
+ *
+ * @return json::value parse to, or true if parse success.
+ */
+bool  parallel_parse(value&, const char* begin, const char* end, std::size_t threads = 0);
+value parallel_parse(const char* begin, const char* end, std::size_t threads = 0);
+value parallel_parse(const char* begin, std::size_t len, std::size_t threads = 0);
+value parallel_parse(const char* begin, const char* end, error& error, std::size_t threads = 0);
+value parallel_parse(const char* begin, std::size_t len, error& error, std::size_t threads = 0);
+
+/*
+ * @brief: Parse a json value from file. A regular file is mapped into memory and parsed in place,
+ * other files (pipes, devices) are read as a stream.
  *
  * @param:
  *  filepath: the absolute path of the file to load.
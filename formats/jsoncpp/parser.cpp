@@ -0,0 +1,105 @@
+#include <formats/jsoncpp/parser.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+parser::parser(parse_flag flag)
+    : flag_(flag)
+{
+  parser_.reuse_values(true);
+}
+
+bool parser::parse(const char* data, value& v)
+{
+  return parse_into(data, data + std::char_traits<char>::length(data), v);
+}
+
+bool parser::parse(const char* begin, const char* end, value& v)
+{
+  return parse_into(begin, end, v);
+}
+
+bool parser::parse(const char* begin, std::size_t len, value& v)
+{
+  return parse_into(begin, begin + len, v);
+}
+
+bool parser::parse(const std::string& str, value& v)
+{
+  return parse_into(str.data(), str.data() + str.size(), v);
+}
+
+bool parser::parse(std::istream& is, value& v)
+{
+  return parse_into(is, v);
+}
+
+#ifdef FORMATS_HAS_MEMORY_RESOURCE
+bool parser::parse(const char* begin, const char* end, pmr::value& v)
+{
+  return parse_into(begin, end, v);
+}
+
+bool parser::parse(std::istream& is, pmr::value& v)
+{
+  return parse_into(is, v);
+}
+#endif  // FORMATS_HAS_MEMORY_RESOURCE
+
+value parser::parse(const char* data)
+{
+  return parse(data, std::char_traits<char>::length(data));
+}
+
+value parser::parse(const char* begin, const char* end)
+{
+  value v;
+  parse_into(begin, end, v);
+
+#ifdef THROW_PARSE_ERROR
+  if (v.kind() == json::kind::error) { FORMATS_THROW(parse_except::create(error_.what())); }
+#endif  // THROW_PARSE_ERROR
+
+  return v;
+}
+
+value parser::parse(const char* begin, std::size_t len)
+{
+  return parse(begin, begin + len);
+}
+
+value parser::parse(const std::string& str)
+{
+  return parse(str.data(), str.data() + str.size());
+}
+
+value parser::parse(std::istream& is)
+{
+  value v;
+  parse_into(is, v);
+
+#ifdef THROW_PARSE_ERROR
+  if (v.kind() == json::kind::error) { FORMATS_THROW(parse_except::create(error_.what())); }
+#endif  // THROW_PARSE_ERROR
+
+  return v;
+}
+
+template <typename Value>
+bool parser::parse_into(const char* begin, const char* end, Value& v)
+{
+  error_ = json::error();
+  parser_.parse(begin, end, v, error_, flag_);
+
+  return !v.is_error();
+}
+
+template <typename Value>
+bool parser::parse_into(std::istream& is, Value& v)
+{
+  error_ = json::error();
+  parser_.parse(is, v, error_, flag_);
+
+  return !v.is_error();
+}
+
+FORMATS_JSON_NAMESPACE_END
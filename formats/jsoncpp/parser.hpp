@@ -0,0 +1,96 @@
+#pragma once
+
+#include <istream>
+#include <string>
+
+#include <formats/jsoncpp/value.hpp>
+#include <formats/jsoncpp/error.hpp>
+#include <formats/jsoncpp/flags.h>
+#include <formats/jsoncpp/detail/parser.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+/*
+ * parser: a parser kept for many documents, with the grammar of json::parse(). json::parse()
+ * sets up a parser per call. this one keeps what it allocates from one document to the next:
+ *   - the buffers of keys and strings.
+ *   - the window a stream is read through.
+ *   - the stack of the open containers.
+ *   - the size of the last array and object at each depth. a new container reserves it.
+ *
+ * parsed into a value it is given, the arrays, objects and strings of the value are overwritten
+ * in place where the document has one of the same kind at the same place, so a message of the
+ * same shape as the last one is parsed with few allocations:
+ *
+ *   json::parser parser;
+ *   json::value  message;
+ *   while (receive(text))
+ *     if (parser.parse(text, message)) consume(message);
+ *
+ * a parser is used by one thread at a time.
+ */
+class parser
+{
+public:
+  explicit parser(parse_flag flag = parse_flag::strict);
+  ~parser() = default;
+
+  parser(const parser&) = delete;
+  parser& operator=(const parser&) = delete;
+
+  /*
+   * @brief: parse a json value into v, over its previous contents. the members and elements of
+   * v past the ones of the document are dropped.
+   * @ret: false if the text is malformed, v is the error value and error() tells why.
+   */
+  bool parse(const char* data, value& v);
+  bool parse(const char* begin, const char* end, value& v);
+  bool parse(const char* begin, std::size_t len, value& v);
+  bool parse(const std::string& str, value& v);
+  bool parse(std::istream& is, value& v);
+
+#ifdef FORMATS_HAS_MEMORY_RESOURCE
+  /* @brief: as parse(), the storage added to v is allocated by the allocator of v */
+  bool parse(const char* begin, const char* end, pmr::value& v);
+  bool parse(std::istream& is, pmr::value& v);
+#endif  // FORMATS_HAS_MEMORY_RESOURCE
+
+  /*
+   * @brief: parse a json value to a new value. If you want throws error, define
+   * preprocessor(THROW_PARSE_ERROR).
+   * @ret: the value, the error value if the text is malformed and error() tells why.
+   */
+  value parse(const char* data);
+  value parse(const char* begin, const char* end);
+  value parse(const char* begin, std::size_t len);
+  value parse(const std::string& str);
+  value parse(std::istream& is);
+
+  /* the grammar of the next documents, parse_flag::strict by default */
+  void       flag(parse_flag flag) noexcept { flag_ = flag; }
+  parse_flag flag() const noexcept { return flag_; }
+
+  /*
+   * the most containers nested in a document, deeper is error_code::too_deep. a deeper value is
+   * parsed and destroyed without the call stack, but copied, compared and serialized with it.
+   */
+  void        max_depth(std::size_t depth) noexcept { parser_.max_depth(depth); }
+  std::size_t max_depth() const noexcept { return parser_.max_depth(); }
+
+  /* the error of the last document, error_code::none if it was parsed */
+  const json::error& error() const noexcept { return error_; }
+
+private:
+  template <typename Value>
+  bool parse_into(const char* begin, const char* end, Value& v);
+
+  template <typename Value>
+  bool parse_into(std::istream& is, Value& v);
+
+private:
+  detail::parser parser_;
+  parse_flag     flag_;
+  json::error    error_;
+};
+
+FORMATS_JSON_NAMESPACE_END
@@ -0,0 +1,698 @@
+#include <formats/jsoncpp/path.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+/* a recursive descent parser of a query, to the segments and the filter nodes of a path */
+class path::compiler
+{
+public:
+  compiler(std::string_view text, path& result)
+      : text_(text)
+      , path_(result)
+  {}
+
+  void compile() noexcept(false)
+  {
+    skip_space();
+    if (!consume('$')) fail("a query must start with '$'");
+
+    for (skip_space(); pos_ < text_.size(); skip_space())
+      path_.segments_.push_back(parse_segment());
+  }
+
+private:
+  segment parse_segment()
+  {
+    segment result;
+
+    if (consume('['))
+    {
+      parse_bracket(result);
+      return result;
+    }
+
+    if (!consume('.')) fail("expect '.' or '['");
+
+    if (consume('.'))
+    {
+      result.descendant = true;
+      if (consume('['))
+      {
+        parse_bracket(result);
+        return result;
+      }
+    }
+
+    selector select;
+    if (consume('*'))
+      select.type = selector_type::wildcard;
+    else
+    {
+      select.type = selector_type::name;
+      select.name = make_step(parse_name(), false);
+    }
+
+    result.selectors.push_back(std::move(select));
+    return result;
+  }
+
+  /* the selectors of a bracket, up to ']' */
+  void parse_bracket(segment& result)
+  {
+    do
+    {
+      skip_space();
+      result.selectors.push_back(parse_selector());
+      skip_space();
+    } while (consume(','));
+
+    if (!consume(']')) fail("expect ']'");
+  }
+
+  selector parse_selector()
+  {
+    selector select;
+
+    if (consume('*')) { select.type = selector_type::wildcard; }
+    else if (peek() == '\'' || peek() == '"')
+    {
+      select.type = selector_type::name;
+      select.name = make_step(parse_quoted(), false);
+    }
+    else if (consume('?'))
+    {
+      select.type   = selector_type::filter;
+      select.filter = parse_or();
+    }
+    else
+    {
+      // an index, or a slice when a ':' follows
+      select.has_start = peek() != ':';
+      if (select.has_start) select.start = parse_integer();
+
+      skip_space();
+      if (!consume(':'))
+      {
+        select.type = selector_type::index;
+        select.name = make_step(std::string(), true);
+
+        select.name.index = select.start;
+        return select;
+      }
+
+      select.type = selector_type::slice;
+
+      skip_space();
+      select.has_end = peek() != ':' && peek() != ']' && peek() != ',';
+      if (select.has_end) select.end = parse_integer();
+
+      skip_space();
+      if (consume(':'))
+      {
+        skip_space();
+        if (peek() != ']' && peek() != ',') select.stride = parse_integer();
+      }
+    }
+
+    return select;
+  }
+
+  // filter expression, from the lowest precedence to the highest
+
+  std::size_t parse_or()
+  {
+    auto left = parse_and();
+    for (skip_space(); consume("||"); skip_space()) left = add(op::logical_or, left, parse_and());
+
+    return left;
+  }
+
+  std::size_t parse_and()
+  {
+    auto left = parse_not();
+    for (skip_space(); consume("&&"); skip_space()) left = add(op::logical_and, left, parse_not());
+
+    return left;
+  }
+
+  std::size_t parse_not()
+  {
+    skip_space();
+    if (peek() == '!' && peek(1) != '=')
+    {
+      ++pos_;
+      return add(op::logical_not, parse_not(), 0);
+    }
+
+    return parse_test();
+  }
+
+  /* a parenthesized expression, a comparison, or a query whose value must exist */
+  std::size_t parse_test()
+  {
+    skip_space();
+    if (consume('('))
+    {
+      auto expression = parse_or();
+
+      skip_space();
+      if (!consume(')')) fail("expect ')'");
+
+      return expression;
+    }
+
+    auto left = parse_operand();
+
+    skip_space();
+    op comparison;
+    if (consume("=="))
+      comparison = op::equal;
+    else if (consume("!="))
+      comparison = op::not_equal;
+    else if (consume("<="))
+      comparison = op::less_equal;
+    else if (consume(">="))
+      comparison = op::greater_equal;
+    else if (consume('<'))
+      comparison = op::less;
+    else if (consume('>'))
+      comparison = op::greater;
+    else
+    {
+      if (path_.nodes_[left].type != op::query) fail("a literal is not a test");
+      return add(op::exists, left, 0);
+    }
+
+    return add(comparison, left, parse_operand());
+  }
+
+  std::size_t parse_operand()
+  {
+    skip_space();
+
+    node operand;
+    if (peek() == '@' || peek() == '$')
+    {
+      operand.type      = op::query;
+      operand.from_root = text_[pos_++] == '$';
+
+      // keys and indices, one per step
+      while (true)
+      {
+        if (consume('.'))
+          operand.steps.push_back(make_step(parse_name(), false));
+        else if (consume('['))
+        {
+          skip_space();
+          if (peek() == '\'' || peek() == '"')
+            operand.steps.push_back(make_step(parse_quoted(), false));
+          else
+          {
+            operand.steps.push_back(make_step(std::string(), true));
+            operand.steps.back().index = parse_integer();
+          }
+
+          skip_space();
+          if (!consume(']')) fail("expect ']'");
+        }
+        else
+          break;
+      }
+    }
+    else if (peek() == '\'' || peek() == '"')
+    {
+      operand.kind   = json::kind::string;
+      operand.string = parse_quoted();
+    }
+    else if (consume("true") || consume("false"))
+    {
+      operand.kind    = json::kind::boolean;
+      operand.boolean = text_[pos_ - 2] == 'u';  // the 'u' of "true", the 's' of "false"
+    }
+    else if (consume("null")) { operand.kind = json::kind::null; }
+    else
+    {
+      auto begin = pos_;
+      while (pos_ < text_.size() && (is_digit(text_[pos_]) || text_[pos_] == '-' ||
+                                     text_[pos_] == '+' || text_[pos_] == '.' ||
+                                     text_[pos_] == 'e' || text_[pos_] == 'E'))
+        ++pos_;
+
+      std::string number(text_.substr(begin, pos_ - begin));
+      char*       end = nullptr;
+
+      operand.kind   = json::kind::number_float;
+      operand.number = std::strtod(number.c_str(), &end);
+      if (number.empty() || end != number.c_str() + number.size()) fail("expect an operand");
+    }
+
+    path_.nodes_.push_back(std::move(operand));
+    return path_.nodes_.size() - 1;
+  }
+
+  // tokens
+
+  /* the name after '.', up to the next segment or the end */
+  std::string parse_name()
+  {
+    auto begin = pos_;
+    while (pos_ < text_.size() && std::string_view(".[]() \t\r\n=!<>&|,").find(text_[pos_]) == npos)
+      ++pos_;
+
+    if (pos_ == begin) fail("expect a name");
+    return std::string(text_.substr(begin, pos_ - begin));
+  }
+
+  /* a string in single or double quotes, a backslash escapes the next character */
+  std::string parse_quoted()
+  {
+    auto        quote = text_[pos_++];
+    std::string result;
+
+    while (pos_ < text_.size() && text_[pos_] != quote)
+    {
+      if (text_[pos_] == '\\' && pos_ + 1 < text_.size()) ++pos_;
+      result.push_back(text_[pos_++]);
+    }
+
+    if (!consume(quote)) fail("a string is not closed");
+    return result;
+  }
+
+  long long parse_integer()
+  {
+    bool negative = consume('-');
+    if (pos_ == text_.size() || !is_digit(text_[pos_])) fail("expect an integer");
+
+    long long result = 0;
+    for (; pos_ < text_.size() && is_digit(text_[pos_]); ++pos_)
+    {
+      if (result > (1ll << 53)) fail("an integer is out of range");
+      result = result * 10 + (text_[pos_] - '0');
+    }
+
+    return negative ? -result : result;
+  }
+
+  step make_step(std::string key, bool is_index)
+  {
+    step result;
+    result.hash     = detail::key_hash()(key);
+    result.key      = std::move(key);
+    result.is_index = is_index;
+
+    return result;
+  }
+
+  std::size_t add(op type, std::size_t left, std::size_t right)
+  {
+    node expression;
+    expression.type  = type;
+    expression.left  = left;
+    expression.right = right;
+
+    path_.nodes_.push_back(std::move(expression));
+    return path_.nodes_.size() - 1;
+  }
+
+  char peek(std::size_t offset = 0) const noexcept
+  {
+    return pos_ + offset < text_.size() ? text_[pos_ + offset] : '\0';
+  }
+
+  bool consume(char c) noexcept
+  {
+    if (peek() != c) return false;
+
+    ++pos_;
+    return true;
+  }
+
+  bool consume(std::string_view token) noexcept
+  {
+    if (text_.substr(pos_, token.size()) != token) return false;
+
+    pos_ += token.size();
+    return true;
+  }
+
+  /* a char of the query may be a byte of utf-8 above 0x7F, negative, which isdigit() rejects */
+  static bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+  void skip_space() noexcept
+  {
+    while (pos_ < text_.size() && std::string_view(" \t\r\n").find(text_[pos_]) != npos) ++pos_;
+  }
+
+  [[noreturn]] void fail(const char* what) const noexcept(false)
+  {
+    auto message = concat("jsonpath: ", what, " at ", std::to_string(pos_));
+    FORMATS_THROW(parse_except::create(message.c_str()));
+  }
+
+private:
+  static constexpr auto npos = std::string_view::npos;
+
+  std::string_view text_;
+  std::size_t      pos_ = 0;
+  path&            path_;
+};
+
+path path::compile(std::string_view text) noexcept(false)
+{
+  path result;
+  compiler(text, result).compile();
+
+  return result;
+}
+
+/* the evaluation of the plan of a path on one value */
+template <typename Value>
+class path::evaluator
+{
+public:
+  evaluator(const path& plan, Value& root)
+      : plan_(plan)
+      , root_(root)
+  {}
+
+  void run(std::vector<Value*>& result)
+  {
+    std::vector<Value*> current{&root_}, next;
+
+    for (const auto& segment : plan_.segments_)
+    {
+      next.clear();
+      for (auto v : current)
+      {
+        if (segment.descendant)
+          descend(segment, v, next);
+        else
+          apply(segment, v, next);
+      }
+
+      current.swap(next);
+      if (current.empty()) return void();
+    }
+
+    result.insert(result.end(), current.begin(), current.end());
+  }
+
+private:
+  enum class operand_type : unsigned char
+  {
+    nothing,  // a query with no value
+    null,
+    boolean,
+    number,
+    string,
+    container,  // an array or an object, compared by identity
+  };
+
+  /* an operand of a comparison */
+  struct operand
+  {
+    operand_type     type      = operand_type::nothing;
+    double           number    = 0;
+    bool             boolean   = false;
+    std::string_view string;
+    const void*      container = nullptr;
+  };
+
+  void descend(const segment& segment, Value* v, std::vector<Value*>& result)
+  {
+    apply(segment, v, result);
+
+    if (auto object = v->if_object())
+    {
+      for (auto& entry : *object) descend(segment, &entry.second, result);
+    }
+    else if (auto array = v->if_array())
+    {
+      for (auto& element : *array) descend(segment, &element, result);
+    }
+  }
+
+  void apply(const segment& segment, Value* v, std::vector<Value*>& result)
+  {
+    for (const auto& select : segment.selectors) apply(select, v, result);
+  }
+
+  void apply(const selector& select, Value* v, std::vector<Value*>& result)
+  {
+    if (auto object = v->if_object())
+    {
+      switch (select.type)
+      {
+        case selector_type::name:
+        {
+          auto iter = object->find(std::string_view(select.name.key), select.name.hash);
+          if (iter != object->end()) result.push_back(&iter->second);
+          break;
+        }
+
+        case selector_type::wildcard:
+          for (auto& entry : *object) result.push_back(&entry.second);
+          break;
+
+        case selector_type::filter:
+          for (auto& entry : *object)
+            if (test(select.filter, &entry.second)) result.push_back(&entry.second);
+          break;
+
+        default: break;
+      }
+    }
+    else if (auto array = v->if_array())
+    {
+      auto size = static_cast<long long>(array->size());
+
+      switch (select.type)
+      {
+        case selector_type::index:
+        {
+          auto index = select.name.index < 0 ? select.name.index + size : select.name.index;
+          if (index >= 0 && index < size) result.push_back(&(*array)[index]);
+          break;
+        }
+
+        case selector_type::slice: slice(select, *array, size, result); break;
+
+        case selector_type::wildcard:
+          for (auto& element : *array) result.push_back(&element);
+          break;
+
+        case selector_type::filter:
+          for (auto& element : *array)
+            if (test(select.filter, &element)) result.push_back(&element);
+          break;
+
+        default: break;
+      }
+    }
+  }
+
+  /* the elements of [start:end:stride], as python and rfc 9535 count them */
+  template <typename Array>
+  void slice(const selector& select, Array& array, long long size, std::vector<Value*>& result)
+  {
+    if (select.stride == 0) return void();
+
+    auto normalize = [size](long long index) { return index < 0 ? index + size : index; };
+
+    if (select.stride > 0)
+    {
+      auto lower = std::clamp(select.has_start ? normalize(select.start) : 0, 0ll, size);
+      auto upper = std::clamp(select.has_end ? normalize(select.end) : size, 0ll, size);
+
+      for (auto i = lower; i < upper; i += select.stride) result.push_back(&array[i]);
+    }
+    else
+    {
+      auto upper = select.has_start ? normalize(select.start) : size - 1;
+      auto lower = select.has_end ? normalize(select.end) : -1;
+
+      upper = std::clamp(upper, -1ll, size - 1);
+      lower = std::clamp(lower, -1ll, size - 1);
+
+      for (auto i = upper; i > lower; i += select.stride) result.push_back(&array[i]);
+    }
+  }
+
+  bool test(std::size_t index, Value* current)
+  {
+    const auto& expression = plan_.nodes_[index];
+
+    switch (expression.type)
+    {
+      case op::logical_or: return test(expression.left, current) || test(expression.right, current);
+      case op::logical_and:
+        return test(expression.left, current) && test(expression.right, current);
+      case op::logical_not: return !test(expression.left, current);
+      case op::exists: return resolve(plan_.nodes_[expression.left], current) != nullptr;
+      default: break;
+    }
+
+    auto left  = evaluate(plan_.nodes_[expression.left], current);
+    auto right = evaluate(plan_.nodes_[expression.right], current);
+
+    switch (expression.type)
+    {
+      case op::equal: return equal(left, right);
+      case op::not_equal: return !equal(left, right);
+      case op::less: return less(left, right);
+      case op::less_equal: return less(left, right) || equal(left, right);
+      case op::greater: return less(right, left);
+      case op::greater_equal: return less(right, left) || equal(left, right);
+      default: return false;
+    }
+  }
+
+  /* @ret: the value of a query, nullptr if there is none */
+  Value* resolve(const node& query, Value* current)
+  {
+    Value* v = query.from_root ? &root_ : current;
+
+    for (const auto& step : query.steps)
+    {
+      if (step.is_index)
+      {
+        auto array = v->if_array();
+        if (!array) return nullptr;
+
+        auto size  = static_cast<long long>(array->size());
+        auto index = step.index < 0 ? step.index + size : step.index;
+        if (index < 0 || index >= size) return nullptr;
+
+        v = &(*array)[index];
+        continue;
+      }
+
+      auto object = v->if_object();
+      if (!object) return nullptr;
+
+      auto iter = object->find(std::string_view(step.key), step.hash);
+      if (iter == object->end()) return nullptr;
+
+      v = &iter->second;
+    }
+
+    return v;
+  }
+
+  operand evaluate(const node& expression, Value* current)
+  {
+    operand result;
+
+    if (expression.type == op::literal)
+    {
+      switch (expression.kind)
+      {
+        case json::kind::null: result.type = operand_type::null; break;
+        case json::kind::boolean:
+          result.type    = operand_type::boolean;
+          result.boolean = expression.boolean;
+          break;
+        case json::kind::string:
+          result.type   = operand_type::string;
+          result.string = expression.string;
+          break;
+        default:
+          result.type   = operand_type::number;
+          result.number = expression.number;
+          break;
+      }
+
+      return result;
+    }
+
+    auto v = resolve(expression, current);
+    if (!v) return result;
+
+    switch (v->kind())
+    {
+      case json::kind::null: result.type = operand_type::null; break;
+      case json::kind::boolean:
+        result.type    = operand_type::boolean;
+        result.boolean = v->as_bool();
+        break;
+      case json::kind::number_int:
+      case json::kind::number_uint:
+      case json::kind::number_float:
+        result.type   = operand_type::number;
+        result.number = v->to_double();
+        break;
+      case json::kind::string:
+      case json::kind::string_view:
+        result.type   = operand_type::string;
+        result.string = v->as_string_view();
+        break;
+      default:
+        result.type      = operand_type::container;
+        result.container = v;
+        break;
+    }
+
+    return result;
+  }
+
+  static bool equal(const operand& left, const operand& right) noexcept
+  {
+    if (left.type != right.type) return false;
+
+    switch (left.type)
+    {
+      case operand_type::boolean: return left.boolean == right.boolean;
+      case operand_type::number: return left.number == right.number;
+      case operand_type::string: return left.string == right.string;
+      case operand_type::container: return left.container == right.container;
+      default: return true;
+    }
+  }
+
+  static bool less(const operand& left, const operand& right) noexcept
+  {
+    if (left.type != right.type) return false;
+
+    if (left.type == operand_type::number) return left.number < right.number;
+    if (left.type == operand_type::string) return left.string < right.string;
+
+    return false;
+  }
+
+private:
+  const path& plan_;
+  Value&      root_;
+};
+
+template <typename Value>
+std::vector<Value*> path::select(Value& root) const
+{
+  std::vector<Value*> result;
+  select(root, result);
+
+  return result;
+}
+
+template <typename Value>
+void path::select(Value& root, std::vector<Value*>& result) const
+{
+  evaluator<Value>(*this, root).run(result);
+}
+
+template std::vector<value*>       path::select(value&) const;
+template std::vector<const value*> path::select(const value&) const;
+template void                      path::select(value&, std::vector<value*>&) const;
+template void path::select(const value&, std::vector<const value*>&) const;
+
+#ifdef FORMATS_HAS_MEMORY_RESOURCE
+template std::vector<pmr::value*>       path::select(pmr::value&) const;
+template std::vector<const pmr::value*> path::select(const pmr::value&) const;
+template void path::select(pmr::value&, std::vector<pmr::value*>&) const;
+template void path::select(const pmr::value&, std::vector<const pmr::value*>&) const;
+#endif  // FORMATS_HAS_MEMORY_RESOURCE
+
+FORMATS_JSON_NAMESPACE_END
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <formats/jsoncpp/value.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+/*
+ * path: a jsonpath query, compiled once to a plan of segments and evaluated on any number of
+ * values:
+ *
+ *   static const auto ids = json::path::compile("$.items[?(@.price > 10)].id");
+ *   for (auto* id : ids.select(jv)) consume(*id);
+ *
+ * select() gives pointers to the values of the query in the value it is given, nothing is copied.
+ * they are valid until the value is modified.
+ *
+ *   $                   the root
+ *   .name  ['name']     a member of an object
+ *   [0]  [-1]           an element of an array, counted from the end if negative
+ *   [start:end:step]    a slice of an array, each part optional
+ *   .*  [*]             all the members of an object or the elements of an array
+ *   ..name  ..*  ..[]   the selector applied to the value and to all its descendants
+ *   [a, b]              the union of the selectors a and b
+ *   [?(expr)]  [?expr]  the members or the elements for which expr holds
+ *
+ * a filter expression compares @ (the member or the element tested) or $ followed by keys and
+ * indices, numbers, strings, true, false and null with == != < <= > >=, and combines the tests
+ * with && || ! and parentheses. a path alone holds if its value exists. only numbers and strings
+ * are ordered, an array or an object is only equal to itself.
+ */
+class path
+{
+public:
+  /* @brief: compile a jsonpath query, throws parse_except if it is malformed */
+  static path compile(std::string_view text) noexcept(false);
+
+  /*
+   * @brief: evaluate the query on root, a json::value or a json::pmr::value, const or not.
+   * @ret: the values selected, in the order of the selectors and of the document.
+   */
+  template <typename Value>
+  std::vector<Value*> select(Value& root) const;
+
+  /* @brief: as select(root), the values are appended to result */
+  template <typename Value>
+  void select(Value& root, std::vector<Value*>& result) const;
+
+private:
+  class compiler;
+
+  template <typename Value>
+  class evaluator;
+
+  /* a key, or an index if it is one, in a path of a filter expression */
+  struct step
+  {
+    std::string key;
+    std::size_t hash     = 0;
+    long long   index    = 0;
+    bool        is_index = false;
+  };
+
+  enum class selector_type : unsigned char
+  {
+    name,
+    index,
+    slice,
+    wildcard,
+    filter,
+  };
+
+  struct selector
+  {
+    selector_type type = selector_type::wildcard;
+
+    step name;  // the key of a name, the index of an index
+
+    // the bounds of a slice
+    long long start     = 0;
+    long long end       = 0;
+    long long stride    = 1;
+    bool      has_start = false;
+    bool      has_end   = false;
+
+    std::size_t filter = 0;  // the root of the expression of a filter in nodes_
+  };
+
+  struct segment
+  {
+    bool                  descendant = false;
+    std::vector<selector> selectors;
+  };
+
+  enum class op : unsigned char
+  {
+    logical_or,
+    logical_and,
+    logical_not,
+    equal,
+    not_equal,
+    less,
+    less_equal,
+    greater,
+    greater_equal,
+    exists,
+    query,    // @ or $ and steps, a value or nothing
+    literal,  // a number, a string, true, false or null
+  };
+
+  /* a node of a filter expression */
+  struct node
+  {
+    op          type  = op::literal;
+    std::size_t left  = 0;
+    std::size_t right = 0;
+
+    // a query
+    bool              from_root = false;
+    std::vector<step> steps;
+
+    // a literal
+    json::kind  kind    = json::kind::null;
+    double      number  = 0;
+    bool        boolean = false;
+    std::string string;
+  };
+
+  std::vector<segment> segments_;
+  std::vector<node>    nodes_;
+};
+
+FORMATS_JSON_NAMESPACE_END
@@ -0,0 +1,85 @@
+#include <formats/jsoncpp/pointer.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace
+{
+/* @ret: the array index of an unescaped token, "0" or digits with no leading zero, else npos */
+std::size_t to_index(std::string_view key, std::size_t npos) noexcept
+{
+  if (key.empty() || key.size() > 19 || (key[0] == '0' && key.size() > 1)) return npos;
+
+  std::size_t index = 0;
+  for (auto c : key)
+  {
+    if (c < '0' || c > '9') return npos;
+    index = index * 10 + (c - '0');
+  }
+
+  return index;
+}
+}  // namespace
+
+pointer::pointer(std::string_view text) noexcept(false)
+{
+  if (text.empty()) return;
+
+  if (text[0] != '/')
+    FORMATS_THROW(parse_except::create("a json pointer must start with '/'"));
+
+  // each '/' starts a token, up to the next one
+  std::size_t begin = 1;
+  while (true)
+  {
+    auto end = text.find('/', begin);
+    auto raw = text.substr(begin, end == std::string_view::npos ? end : end - begin);
+
+    token parsed;
+    parsed.key.reserve(raw.size());
+
+    for (std::size_t i = 0; i < raw.size(); ++i)
+    {
+      if (raw[i] != '~')
+      {
+        parsed.key.push_back(raw[i]);
+        continue;
+      }
+
+      if (i + 1 == raw.size() || (raw[i + 1] != '0' && raw[i + 1] != '1'))
+        FORMATS_THROW(parse_except::create("'~' is not followed by 0 or 1 in a json pointer"));
+
+      parsed.key.push_back(raw[++i] == '0' ? '~' : '/');
+    }
+
+    parsed.hash  = detail::key_hash()(parsed.key);
+    parsed.index = to_index(parsed.key, npos);
+    tokens_.push_back(std::move(parsed));
+
+    if (end == std::string_view::npos) break;
+    begin = end + 1;
+  }
+}
+
+std::string pointer::to_string() const
+{
+  std::string text;
+
+  for (const auto& token : tokens_)
+  {
+    text.push_back('/');
+
+    for (auto c : token.key)
+    {
+      if (c == '~')
+        text.append("~0");
+      else if (c == '/')
+        text.append("~1");
+      else
+        text.push_back(c);
+    }
+  }
+
+  return text;
+}
+
+FORMATS_JSON_NAMESPACE_END
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <formats/jsoncpp/value.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+/*
+ * pointer: a json pointer (rfc 6901), such as "/items/0/name", parsed once and evaluated on any
+ * number of values:
+ *
+ *   static const json::pointer name("/items/0/name");
+ *   if (auto v = name.find(jv)) consume(*v);
+ *
+ * a reference token is unescaped, hashed like the keys of an object, and converted to an array
+ * index when it is one, as the pointer is constructed. so an evaluation allocates nothing and
+ * hashes nothing. the pointer "" refers to the whole value.
+ */
+class pointer
+{
+public:
+  /* the pointer to the whole value */
+  pointer() = default;
+
+  /* @brief: parse a json pointer, throws parse_except if it is malformed */
+  explicit pointer(std::string_view text) noexcept(false);
+
+  /*
+   * @brief: the value the pointer refers to in root, a value or a const value of any allocator.
+   * a token is a key in an object and an index in an array. "-" and the indices past the end
+   * refer to nothing.
+   * @ret: nullptr if there is no such value.
+   */
+  template <typename Value>
+  Value* find(Value& root) const noexcept
+  {
+    Value* v = &root;
+
+    for (const auto& token : tokens_)
+    {
+      if (auto object = v->if_object())
+      {
+        auto iter = object->find(std::string_view(token.key), token.hash);
+        if (iter == object->end()) return nullptr;
+
+        v = &iter->second;
+      }
+      else if (auto array = v->if_array())
+      {
+        if (token.index >= array->size()) return nullptr;
+
+        v = &(*array)[token.index];
+      }
+      else { return nullptr; }
+    }
+
+    return v;
+  }
+
+  /* @brief: as find(), throws range_except if there is no such value */
+  template <typename Value>
+  Value& at(Value& root) const noexcept(false)
+  {
+    if (auto v = find(root)) return *v;
+
+    FORMATS_THROW(range_except::create(concat("no value at json pointer:", to_string())));
+  }
+
+  /* count of the reference tokens, 0 for the whole value */
+  std::size_t size() const noexcept { return tokens_.size(); }
+  bool        empty() const noexcept { return tokens_.empty(); }
+
+  /* @brief: the pointer as text, with '~' and '/' escaped */
+  std::string to_string() const;
+
+private:
+  /* not an array index, a key only */
+  static constexpr std::size_t npos = std::size_t(-1);
+
+  struct token
+  {
+    std::string key;    // unescaped
+    std::size_t hash;   // of the key, as the objects hash their keys
+    std::size_t index;  // npos if the key is not an array index
+  };
+
+  std::vector<token> tokens_;
+};
+
+FORMATS_JSON_NAMESPACE_END
@@ -0,0 +1,650 @@
+#include <formats/jsoncpp/push_parser.hpp>
+
+#include <cstdio>
+
+#include <formats/jsoncpp/detail/parser.hpp>
+#include <formats/common/cctypes.hpp>
+#include <formats/common/unicode/unicode.hpp>
+#include <formats/common/simd/simd.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace detail
+{
+void value_builder::reset()
+{
+  root_ = nullptr;
+  stack_.clear();
+  key_.clear();
+}
+
+value* value_builder::slot()
+{
+  if (stack_.empty()) return &root_;
+
+  value* top = stack_.back();
+  if (top->is_array()) return &top->as_array().emplace_back(nullptr);
+
+  return &top->as_object().emplace(std::move(key_), nullptr).first->second;
+}
+
+bool value_builder::add(value&& val)
+{
+  *slot() = std::move(val);
+  return true;
+}
+
+bool value_builder::open(kind k)
+{
+  value* container = slot();
+
+  *container = k;
+  stack_.push_back(container);
+  return true;
+}
+
+bool value_builder::close()
+{
+  stack_.pop_back();
+  return true;
+}
+
+}  // namespace detail
+
+namespace
+{
+bool is_number_char(unsigned char c)
+{
+  return isdigit(c) || c == c_decimal_point || c == 'e' || c == 'E' || c == c_plus_sign ||
+         c == c_minus_sign;
+}
+}  // namespace
+
+push_parser::push_parser()
+    : number_parser_(new detail::parser())
+    , handler_(&builder_)
+{}
+
+push_parser::push_parser(sax& handler)
+    : number_parser_(new detail::parser())
+    , handler_(&handler)
+{}
+
+push_parser::push_parser(std::unique_ptr<sax> adapter)
+    : number_parser_(new detail::parser())
+    , adapter_(std::move(adapter))
+    , handler_(adapter_.get())
+{}
+
+push_parser::~push_parser() = default;
+
+push_parser::status push_parser::feed(const char* data, size_t len)
+{
+  if (state_ == state::failed) return status::error;
+
+  ptr_ = data;
+  end_ = data + len;
+
+  if (!parse_chunk())
+  {
+    state_ = state::failed;
+    return status::error;
+  }
+
+  return (state_ == state::done) ? status::done : status::need_more;
+}
+
+push_parser::status push_parser::finish()
+{
+  if (state_ == state::failed) return status::error;
+  if (state_ == state::done) return status::done;
+
+  ptr_ = end_ = nullptr;
+
+  switch (state_)
+  {
+    case state::bom:
+    case state::root: throw_error(error_code::missing_begin_object_array); break;
+
+    case state::string: throw_error(error_code::missing_quotation_mark); break;
+    case state::escape:
+    case state::number: throw_error(error_code::no_end); break;
+
+    case state::unicode:
+    case state::low_escape:
+    case state::low_unicode: throw_error(error_code::illegal_unicode); break;
+
+    case state::literal:
+      throw_error((*literal_ == 'n')   ? error_code::expect_null
+                  : (*literal_ == 't') ? error_code::expect_true
+                                       : error_code::expect_false);
+      break;
+
+    default:
+      throw_error(stack_.back() == c_object_begin ? error_code::missing_end_object
+                                                  : error_code::missing_end_array);
+      break;
+  }
+
+  state_ = state::failed;
+  return status::error;
+}
+
+void push_parser::reset()
+{
+  builder_.reset();
+
+  error_ = error();
+  state_ = state::bom;
+
+  stack_.clear();
+  token_.clear();
+
+  low_surrogate_ = false;
+  literal_pos_   = 0;
+  line_          = 1;
+  pair_lf_       = false;
+}
+
+bool push_parser::parse_chunk()
+{
+  while (ptr_ < end_)
+  {
+    bool result = true;
+
+    switch (state_)
+    {
+      case state::bom: result = skip_bom(); break;
+
+      case state::string: result = parse_string(); break;
+      case state::escape: result = parse_escape(*ptr_); break;
+
+      case state::unicode:
+      case state::low_escape:
+      case state::low_unicode: result = parse_unicode(*ptr_); break;
+
+      case state::number: result = parse_number(); break;
+      case state::literal: result = parse_literal(); break;
+
+      default: result = !skip_white_space() || parse_structural(*ptr_); break;
+    }
+
+    if (!result) return false;
+  }
+
+  return true;
+}
+
+bool push_parser::parse_structural(unsigned char c)
+{
+  switch (state_)
+  {
+    case state::root:
+      if (c == c_object_begin || c == c_array_begin) return open(c);
+
+      throw_error(error_code::missing_begin_object_array);
+      return false;
+
+    case state::object_first:
+      if (c == c_object_end) return close(c);
+      // fall through
+
+    case state::object_key:
+      if (likely(c == c_double_quotes))
+      {
+        ++ptr_;
+        in_key_    = true;
+        non_ascii_ = false;
+        validated_ = 0;
+        state_     = state::string;
+        token_.clear();
+        return true;
+      }
+
+      throw_error((c == c_object_end) ? error_code::surplus_trailing_comma
+                                      : error_code::missing_quotation_mark);
+      return false;
+
+    case state::name_sep:
+      if (likely(c == c_name_separator))
+      {
+        ++ptr_;
+        state_ = state::value;
+        return true;
+      }
+
+      throw_error(error_code::missing_name_separator);
+      return false;
+
+    case state::array_first:
+      if (c == c_array_end) return close(c);
+      return parse_value_start(c);
+
+    case state::array_value:
+      if (unlikely(c == c_array_end))
+      {
+        throw_error(error_code::surplus_trailing_comma);
+        return false;
+      }
+
+      return parse_value_start(c);
+
+    case state::value: return parse_value_start(c);
+
+    case state::after_value: {
+      bool in_object = (stack_.back() == c_object_begin);
+
+      if (c == c_value_separator)
+      {
+        ++ptr_;
+        state_ = in_object ? state::object_key : state::array_value;
+        return true;
+      }
+
+      if (c == (in_object ? c_object_end : c_array_end)) return close(c);
+
+      throw_error(in_object ? error_code::missing_end_object : error_code::missing_end_array);
+      return false;
+    }
+
+    default: break;
+  }
+
+  throw_error(error_code::illeagl_character, "surplus value after the root");
+  return false;
+}
+
+bool push_parser::parse_value_start(unsigned char c)
+{
+  if (c == c_object_begin || c == c_array_begin) return open(c);
+
+  if (likely(c == c_double_quotes))
+  {
+    ++ptr_;
+    in_key_    = false;
+    non_ascii_ = false;
+    validated_ = 0;
+    state_     = state::string;
+    token_.clear();
+    return true;
+  }
+
+  if (leading_number(c))
+  {
+    state_ = state::number;
+    token_.clear();
+    return parse_number();
+  }
+
+  if (c == c_letter_n || c == c_letter_t || c == c_letter_f)
+  {
+    literal_     = (c == c_letter_n) ? "null" : (c == c_letter_t) ? "true" : "false";
+    literal_pos_ = 0;
+    state_       = state::literal;
+    return parse_literal();
+  }
+
+  throw_error(error_code::illeagl_character, "illeagl value");
+  return false;
+}
+
+bool push_parser::parse_string()
+{
+  const char* begin = ptr_;
+
+  while (true)
+  {
+    // clean ascii runs are skipped by blocks, the span is appended once it ends
+    ptr_ = simd::scan_string(ptr_, end_, c_double_quotes);
+    if (ptr_ == end_)
+    {
+      token_.append(begin, ptr_ - begin);
+      return true;
+    }
+
+    unsigned char c = *ptr_;
+
+    if (likely(c == c_double_quotes))
+    {
+      token_.append(begin, ptr_ - begin);
+      ++ptr_;
+      return end_string();
+    }
+
+    if (c == c_reverse_solidus)
+    {
+      token_.append(begin, ptr_ - begin);
+      if (!validate_utf8()) return false;
+
+      ++ptr_;
+      state_ = state::escape;
+      return true;
+    }
+
+    if (unlikely(c == c_horizontal_tab))
+    {
+      throw_error(error_code::tab_in_string);
+      return false;
+    }
+
+    if (unlikely(c == c_line_feed))
+    {
+      throw_error(error_code::linefeed_in_string);
+      return false;
+    }
+
+    // non-ascii runs are validated at the next stop of the string, a run may be cut by the chunk
+    if (c >= 0x80)
+    {
+      non_ascii_ = true;
+      ptr_       = simd::scan_string(ptr_, end_, c_double_quotes, false);
+      if (ptr_ == end_) continue;
+
+      token_.append(begin, ptr_ - begin);
+      begin = ptr_;
+
+      if (!validate_utf8()) return false;
+      continue;
+    }
+
+    ++ptr_;  // the other control characters are kept
+  }
+}
+
+bool push_parser::parse_escape(unsigned char c)
+{
+  // the escapes are kept as they are written, but \u of an ascii character
+  switch (c)
+  {
+    case c_double_quotes:
+    case c_single_quotes:
+    case c_reverse_solidus:
+    case c_solidus:
+    case c_letter_b:
+    case c_letter_f:
+    case c_letter_n:
+    case c_letter_r:
+    case c_letter_t:
+    case c_letter_v:
+      token_.push_back(c_reverse_solidus);
+      token_.push_back(c);
+      ++ptr_;
+      state_ = state::string;
+      return true;
+
+    case c_carriage_return:
+      token_.push_back(c_reverse_solidus);
+      state_ = state::string;
+      return true;
+
+    case c_horizontal_tab: throw_error(error_code::tab_in_string); return false;
+    case c_line_feed: throw_error(error_code::linefeed_in_string); return false;
+
+    case c_letter_u:
+      token_.append("\\u");
+      ++ptr_;
+      hex_count_ = 0;
+      code_      = 0;
+      state_     = state::unicode;
+      return true;
+
+    default: break;
+  }
+
+  throw_error(error_code::illeagl_escaped);
+  return false;
+}
+
+bool push_parser::parse_unicode(unsigned char c)
+{
+  if (state_ != state::unicode)
+  {
+    // a high surrogate is followed by the \u of a low surrogate
+    if (c != (state_ == state::low_escape ? c_reverse_solidus : c_letter_u))
+    {
+      throw_error(error_code::illegal_unicode);
+      return false;
+    }
+
+    token_.push_back(c);
+    ++ptr_;
+
+    if (state_ == state::low_escape)
+    {
+      state_ = state::low_unicode;
+      return true;
+    }
+
+    hex_count_     = 0;
+    code_          = 0;
+    low_surrogate_ = true;
+    state_         = state::unicode;
+    return true;
+  }
+
+  char num = char_to_num(c);
+  if (num < 0)
+  {
+    throw_error(error_code::illegal_unicode);
+    return false;
+  }
+
+  token_.push_back(c);
+  ++ptr_;
+
+  code_ = (code_ << 4) + num;
+  if (++hex_count_ < 4) return true;
+
+  state_ = state::string;
+
+  if (low_surrogate_)
+  {
+    low_surrogate_ = false;
+
+    if (code_ >= 0xDC00 && code_ <= 0xDFFF) return true;
+
+    throw_error(error_code::illegal_unicode);
+    return false;
+  }
+
+  if (code_ <= 0x7F)
+  {
+    token_.resize(token_.size() - 6);
+    token_.push_back((char)code_);  // ascii: trans to utf8
+  }
+  else if (code_ >= 0xD800 && code_ <= 0xDBFF)
+    state_ = state::low_escape;
+
+  return true;
+}
+
+bool push_parser::parse_number()
+{
+  const char* begin = ptr_;
+  while (ptr_ < end_ && is_number_char(*ptr_))
+    ++ptr_;
+
+  token_.append(begin, ptr_ - begin);
+
+  return (ptr_ == end_) || end_number(*ptr_);
+}
+
+bool push_parser::parse_literal()
+{
+  while (ptr_ < end_ && literal_[literal_pos_])
+  {
+    if (*ptr_ != literal_[literal_pos_])
+    {
+      throw_error((*literal_ == 'n')   ? error_code::expect_null
+                  : (*literal_ == 't') ? error_code::expect_true
+                                       : error_code::expect_false);
+      return false;
+    }
+
+    ++ptr_;
+    ++literal_pos_;
+  }
+
+  if (literal_[literal_pos_]) return true;
+
+  state_ = state::after_value;
+
+  if (*literal_ == 'n') return event(handler_->null());
+  return event(handler_->boolean(*literal_ == 't'));
+}
+
+bool push_parser::validate_utf8()
+{
+  const char* begin = token_.data() + validated_;
+
+  if (non_ascii_ && !unicode::validate_utf8(begin, token_.data() + token_.size()))
+  {
+    throw_error(error_code::illegal_unicode);
+    return false;
+  }
+
+  non_ascii_ = false;
+  validated_ = token_.size();
+  return true;
+}
+
+bool push_parser::end_string()
+{
+  if (!validate_utf8()) return false;
+
+  if (in_key_)
+  {
+    state_ = state::name_sep;
+    return event(handler_->key(token_));
+  }
+
+  state_ = state::after_value;
+  return event(handler_->string(token_));
+}
+
+bool push_parser::end_number(unsigned char delimiter)
+{
+  // the number is converted by the one stage parser, the delimiter tells it where the text ends
+  token_.push_back(delimiter);
+
+  const char* begin = token_.data();
+
+  value       v;
+  error       err;
+  const char* end = number_parser_->parse_number(begin, begin + token_.size(), v, err);
+
+  if (!end)
+  {
+    throw_error((error_code)err.code());
+    return false;
+  }
+
+  // the number ends before the text does, a byte which cannot follow a value
+  if (end != begin + token_.size() - 1)
+  {
+    throw_error(stack_.back() == c_object_begin ? error_code::missing_end_object
+                                                : error_code::missing_end_array);
+    return false;
+  }
+
+  state_ = state::after_value;
+
+  switch (v.kind())
+  {
+    case kind::number_int: return event(handler_->number_int(*v.if_int64()));
+    case kind::number_uint: return event(handler_->number_uint(*v.if_uint64()));
+    default: return event(handler_->number_float(*v.if_double()));
+  }
+}
+
+bool push_parser::skip_white_space()
+{
+  if (pair_lf_ && *ptr_ == c_line_feed) ++ptr_;
+  pair_lf_ = false;
+
+  ptr_ = simd::skip_white_space(ptr_, end_, line_);
+
+  // a `\r` which ends the chunk
+  if (ptr_ + 1 == end_ && *ptr_ == c_carriage_return)
+  {
+    ++ptr_;
+    ++line_;
+    pair_lf_ = true;
+  }
+
+  return ptr_ < end_;
+}
+
+bool push_parser::skip_bom()
+{
+  const char* bom = "\xEF\xBB\xBF";
+
+  if (*ptr_ == bom[literal_pos_])
+  {
+    ++ptr_;
+    if (++literal_pos_ == 3) state_ = state::root;
+    return true;
+  }
+
+  if (literal_pos_ == 0)
+  {
+    state_ = state::root;
+    return true;
+  }
+
+  throw_error(error_code::missing_begin_object_array);
+  return false;
+}
+
+bool push_parser::open(unsigned char c)
+{
+  if (stack_.size() >= max_depth_)
+  {
+    throw_error(error_code::too_deep);
+    return false;
+  }
+
+  ++ptr_;
+  stack_.push_back(c);
+
+  if (c == c_object_begin)
+  {
+    state_ = state::object_first;
+    return event(handler_->start_object());
+  }
+
+  state_ = state::array_first;
+  return event(handler_->start_array());
+}
+
+bool push_parser::close(unsigned char c)
+{
+  ++ptr_;
+  stack_.pop_back();
+
+  state_ = stack_.empty() ? state::done : state::after_value;
+
+  return event((c == c_object_end) ? handler_->end_object() : handler_->end_array());
+}
+
+bool push_parser::event(bool result)
+{
+  if (!result) throw_error(error_code::aborted);
+
+  return result;
+}
+
+void push_parser::throw_error(error_code code, const char* errmsg)
+{
+  char __msg[256] = {0};
+  char __chr      = (ptr_ < end_) ? *ptr_ : ' ';  // nothing left to show at the end of input
+
+  if (errmsg)
+    sprintf(__msg, "Line[%d] Parse Character[%c], Error: %s", line_, __chr, errmsg);
+  else
+    sprintf(__msg, "Line[%d] Parse Character[%c], Error: %s", line_, __chr, error_desc(code));
+
+  error_ = error(code, __msg);
+}
+
+FORMATS_JSON_NAMESPACE_END
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <formats/jsoncpp/value.hpp>
+#include <formats/jsoncpp/error.hpp>
+#include <formats/jsoncpp/sax.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+namespace detail
+{
+class parser;
+
+/* builds a json::value of the events of a push parser */
+class value_builder final : public sax
+{
+public:
+  void reset();
+
+  value& result() { return root_; }
+
+  bool null() override { return add(nullptr); }
+  bool boolean(bool val) override { return add(val); }
+  bool number_int(long long val) override { return add(val); }
+  bool number_uint(unsigned long long val) override { return add(val); }
+  bool number_float(double val) override { return add(val); }
+  bool string(std::string& val) override { return add(std::move(val)); }
+
+  bool start_object() override { return open(kind::object); }
+  bool key(std::string& val) override { return key_.swap(val), true; }
+  bool end_object() override { return close(); }
+  bool start_array() override { return open(kind::array); }
+  bool end_array() override { return close(); }
+
+private:
+  value* slot();
+
+  bool add(value&& val);
+  bool open(kind k);
+  bool close();
+
+private:
+  value               root_;
+  std::vector<value*> stack_;  // the containers still open
+  std::string         key_;
+};
+
+}  // namespace detail
+
+/*
+ * push_parser: parse a strict document which arrives in chunks of any size, with no blocking read.
+ * feed() consumes a chunk at once and returns need_more until the root is closed. a token which is
+ * cut by the end of a chunk, a string, a number, an escape or a literal, is suspended with its
+ * state and resumed by the next chunk, the bytes already consumed are never scanned again.
+ *
+ * the grammar is the strict grammar of parse(). the events go to a sax handler, or build a
+ * json::value when there is none.
+ */
+class push_parser
+{
+public:
+  enum class status
+  {
+    need_more,
+    done,
+    error,
+  };
+
+  push_parser();
+  explicit push_parser(sax& handler);
+  ~push_parser();
+
+  template <typename Handler, detail::enable_if_sax_handler_t<Handler> = 0>
+  explicit push_parser(Handler& handler)
+      : push_parser(std::unique_ptr<sax>(new detail::sax_adapter<Handler>(handler)))
+  {}
+
+  push_parser(const push_parser&) = delete;
+  push_parser& operator=(const push_parser&) = delete;
+
+  /*
+   * @brief: consume the next chunk of the document. only white space may follow the root.
+   * @ret: done once the root is closed, error after a parse error. the error is final until reset.
+   */
+  status feed(const char* data, size_t len);
+  status feed(const std::string& data) { return feed(data.data(), data.size()); }
+
+  /*
+   * @brief: the end of the input, a document which is not done yet is truncated.
+   * @ret: done or error.
+   */
+  status finish();
+
+  /* start a new document, the buffers are kept */
+  void reset();
+
+  /* the built value, without a handler */
+  value& result() { return builder_.result(); }
+
+  error last_error() const { return error_; }
+
+  /*
+   * the most containers nested in a document, deeper is error_code::too_deep. JSON_MAX_DEPTH by
+   * default, kept by reset(). the open containers cost a byte each, but the built value is copied,
+   * compared and serialized by a recursion.
+   */
+  void        max_depth(std::size_t depth) noexcept { max_depth_ = depth; }
+  std::size_t max_depth() const noexcept { return max_depth_; }
+
+private:
+  enum class state : unsigned char
+  {
+    bom,           // the first bytes, which may be a utf8 bom
+    root,          // white space before the root
+    object_first,  // after `{`: a key or `}`
+    object_key,    // after `,` in an object
+    name_sep,      // after a key
+    value,         // after `:`
+    array_first,   // after `[`: a value or `]`
+    array_value,   // after `,` in an array
+    after_value,   // `,` or the end of the container
+    done,          // white space after the root
+
+    string,       // string body
+    escape,       // after `\`
+    unicode,      // the hex digits of `\u`
+    low_escape,   // the `\` of the low surrogate
+    low_unicode,  // the `u` of the low surrogate
+    number,       // number text
+    literal,      // true, false or null
+    failed,
+  };
+
+private:
+  explicit push_parser(std::unique_ptr<sax> adapter);
+
+  bool parse_chunk();
+
+  bool parse_structural(unsigned char c);
+  bool parse_value_start(unsigned char c);
+  bool parse_string();
+  bool parse_escape(unsigned char c);
+  bool parse_unicode(unsigned char c);
+  bool parse_number();
+  bool parse_literal();
+
+  bool validate_utf8();
+  bool end_string();
+  bool end_number(unsigned char delimiter);
+  bool skip_white_space();
+  bool skip_bom();
+
+  bool open(unsigned char c);
+  bool close(unsigned char c);
+
+  bool event(bool result);
+  void throw_error(error_code code, const char* errmsg = nullptr);
+
+private:
+  detail::value_builder           builder_;
+  std::unique_ptr<detail::parser> number_parser_;  // numbers are converted by the parser of parse()
+
+  std::unique_ptr<sax> adapter_;  // of a handler which does not derive from sax
+  sax*                 handler_ = nullptr;
+
+  error error_;
+
+  const char* ptr_ = nullptr;
+  const char* end_ = nullptr;
+
+  state state_ = state::bom;
+
+  std::string stack_;  // `{` and `[` of the containers still open
+  std::size_t max_depth_ = JSON_MAX_DEPTH;
+  std::string token_;  // the key, the string or the number being parsed
+
+  bool in_key_        = false;
+  bool non_ascii_     = false;  // the string has bytes past validated_ to check
+  bool low_surrogate_ = false;  // the hex digits are those of a low surrogate
+
+  size_t validated_ = 0;  // the string is valid utf8 up to there
+
+  const char* literal_     = nullptr;
+  int         literal_pos_ = 0;  // bytes of the literal, or of the bom, matched so far
+  int         hex_count_   = 0;
+  unsigned    code_        = 0;
+
+  int  line_    = 1;
+  bool pair_lf_ = false;  // a `\r` ended the last chunk, a `\n` next is the same terminator
+};
+
+FORMATS_JSON_NAMESPACE_END
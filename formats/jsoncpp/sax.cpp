@@ -0,0 +1,23 @@
+#include <formats/jsoncpp/sax.hpp>
+#include <formats/jsoncpp/detail/parser.hpp>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+bool sax_parse(const char* begin, const char* end, sax& handler, error& error, parse_flag flag)
+{
+  return formats::json::detail::parser().parse(begin, end, handler, error, flag);
+}
+
+bool sax_parse(const char* begin, const char* end, sax& handler, parse_flag flag)
+{
+  error err;
+  bool  res = sax_parse(begin, end, handler, err, flag);
+
+#ifdef THROW_PARSE_ERROR
+  if (!res) { FORMATS_THROW(parse_except::create(err.what())); }
+#endif  // THROW_PARSE_ERROR
+
+  return res;
+}
+
+FORMATS_JSON_NAMESPACE_END
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <type_traits>
+
+#include <formats/jsoncpp/fwd.hpp>
+#include <formats/jsoncpp/error.hpp>
+#include <formats/jsoncpp/flags.h>
+
+FORMATS_JSON_NAMESPACE_BEGIN
+
+/*
+ * sax: receives the events of a json document in document order, no json::value is built.
+ *
+ * every callback returns false to stop the parse, which fails with error_code::aborted then. the
+ * strings passed to key and string are only valid during the call, they may be moved from.
+ */
+class sax
+{
+public:
+  virtual ~sax() = default;
+
+  virtual bool null()                              = 0;
+  virtual bool boolean(bool val)                   = 0;
+  virtual bool number_int(long long val)           = 0;
+  virtual bool number_uint(unsigned long long val) = 0;
+  virtual bool number_float(double val)            = 0;
+  virtual bool string(std::string& val)            = 0;
+
+  virtual bool start_object()        = 0;
+  virtual bool key(std::string& val) = 0;
+  virtual bool end_object()          = 0;
+  virtual bool start_array()         = 0;
+  virtual bool end_array()           = 0;
+};
+
+namespace detail
+{
+/* forwards the events to a handler which has the callbacks of sax without deriving from it */
+template <typename Handler>
+class sax_adapter final : public sax
+{
+public:
+  explicit sax_adapter(Handler& handler)
+      : handler_(handler)
+  {}
+
+  bool null() override { return handler_.null(); }
+  bool boolean(bool val) override { return handler_.boolean(val); }
+  bool number_int(long long val) override { return handler_.number_int(val); }
+  bool number_uint(unsigned long long val) override { return handler_.number_uint(val); }
+  bool number_float(double val) override { return handler_.number_float(val); }
+  bool string(std::string& val) override { return handler_.string(val); }
+
+  bool start_object() override { return handler_.start_object(); }
+  bool key(std::string& val) override { return handler_.key(val); }
+  bool end_object() override { return handler_.end_object(); }
+  bool start_array() override { return handler_.start_array(); }
+  bool end_array() override { return handler_.end_array(); }
+
+private:
+  Handler& handler_;
+};
+
+template <typename Handler>
+using enable_if_sax_handler_t = std::enable_if_t<!std::is_base_of<sax, Handler>::value, int>;
+
+}  // namespace detail
+
+/*
+ * @brief: Parse a json document into the events of a handler. The grammar and the parse flags are
+ * the same as parse(), no json::value is built.
+ *
+ * @param:
+ *  begin: pointer at source string begining
+ *  end:   pointer at source string ending
+ *  handler: json::sax, or any type which has its callbacks
+ *  error: the reference of parse error
+ *  parse_flag: bit-or combination of the possible flags-enum.
+ *
+ * @return: true if parse success, otherwise false.
+ */
+bool sax_parse(const char* begin, const char* end, sax& handler, error& error,
+               parse_flag flag = parse_flag::strict);
+bool sax_parse(const char* begin, const char* end, sax& handler,
+               parse_flag flag = parse_flag::strict);
+
+template <typename Handler, detail::enable_if_sax_handler_t<Handler> = 0>
+bool sax_parse(const char* begin, const char* end, Handler& handler, error& error,
+               parse_flag flag = parse_flag::strict)
+{
+  detail::sax_adapter<Handler> adapter(handler);
+  return sax_parse(begin, end, static_cast<sax&>(adapter), error, flag);
+}
+
+template <typename Handler, detail::enable_if_sax_handler_t<Handler> = 0>
+bool sax_parse(const char* begin, const char* end, Handler& handler,
+               parse_flag flag = parse_flag::strict)
+{
+  detail::sax_adapter<Handler> adapter(handler);
+  return sax_parse(begin, end, static_cast<sax&>(adapter), flag);
+}
+
+FORMATS_JSON_NAMESPACE_END
@@ -1,5 +1,6 @@
 #include <array>
 #include <algorithm>
+#include <vector>
 
 #include <formats/jsoncpp/value.hpp>
 #include <formats/jsoncpp/detail/stringifier.hpp>
@@ -9,22 +10,56 @@
 
 FORMATS_JSON_NAMESPACE_BEGIN
 
-value::value() noexcept
-    : kind_(kind::null)
+namespace
+{
+/* a std::string made by the library, as the string of a value */
+template <typename String>
+String to_string_t(std::string&& s, const typename String::allocator_type& alloc)
+{
+  return String(s.data(), s.size(), alloc);
+}
+
+template <>
+std::string to_string_t<std::string>(std::string&& s, const std::allocator<char>&)
+{
+  return std::move(s);
+}
+}  // namespace
+
+template <typename Allocator>
+basic_value<Allocator>::basic_value() noexcept
+    : detail::allocator_storage<Allocator>(allocator_type())
+    , kind_(kind::null)
 {}
 
-value::value(const value& other) noexcept
-    : kind_(other.kind_)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::null)
+{}
+
+template <typename Allocator>
+basic_value<Allocator>::basic_value(const basic_value& other) noexcept
+    : basic_value(other,
+                  std::allocator_traits<Allocator>::select_on_container_copy_construction(
+                      other.allocator()))
+{}
+
+template <typename Allocator>
+basic_value<Allocator>::basic_value(const basic_value& other, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(other.kind_)
 {
   switch (kind_)
   {
     case kind::boolean: new (&data_.v_bool_) bool(other.data_.v_bool_); break;
-    case kind::string: new (&data_.v_string_) string_t(other.data_.v_string_); break;
+    case kind::string: data_.v_string_ = create<string_t>(*other.data_.v_string_, alloc); break;
+    case kind::string_view: copy_view(other.view(), alloc); break;
     case kind::number_int: new (&data_.v_int_) number_uint_t(other.data_.v_int_); break;
     case kind::number_uint: new (&data_.v_uint_) number_uint_t(other.data_.v_uint_); break;
     case kind::number_float: new (&data_.v_double_) number_float_t(other.data_.v_double_); break;
-    case kind::array: new (&data_.v_array_) array_t(other.data_.v_array_); break;
-    case kind::object: new (&data_.v_object_) object_t(other.data_.v_object_); break;
+    case kind::array: data_.v_array_ = create<array_t>(*other.data_.v_array_, alloc); break;
+    case kind::object: data_.v_object_ = create<object_t>(*other.data_.v_object_, alloc); break;
     case kind::error:
       // new (&data_.v_error_) error(other.data_.v_error_);
       break;
@@ -33,18 +68,47 @@ value::value(const value& other) noexcept
   }
 }
 
-value::value(value&& other) noexcept
-    : kind_(other.kind_)
+// the storage of the containers is taken over, other is left null
+template <typename Allocator>
+basic_value<Allocator>::basic_value(basic_value&& other) noexcept
+    : detail::allocator_storage<Allocator>(other.allocator())
+    , kind_(other.kind_)
+    , view_size_(other.view_size_)
+    , data_(other.data_)
+{
+  other.kind_ = kind::null;
+}
+
+// the storage is taken over with an equal allocator, the contents are moved one by one otherwise
+template <typename Allocator>
+basic_value<Allocator>::basic_value(basic_value&& other, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(other.kind_)
 {
+  if (alloc == other.allocator())
+  {
+    view_size_  = other.view_size_;
+    data_       = other.data_;
+    other.kind_ = kind::null;
+    return;
+  }
+
   switch (kind_)
   {
     case kind::boolean: new (&data_.v_bool_) bool(other.data_.v_bool_); break;
-    case kind::string: new (&data_.v_string_) string_t(std::move(other.data_.v_string_)); break;
+    case kind::string:
+      data_.v_string_ = create<string_t>(std::move(*other.data_.v_string_), alloc);
+      break;
+    case kind::string_view: copy_view(other.view(), alloc); break;
     case kind::number_int: new (&data_.v_int_) number_int_t(other.data_.v_int_); break;
     case kind::number_uint: new (&data_.v_uint_) number_uint_t(other.data_.v_uint_); break;
     case kind::number_float: new (&data_.v_double_) number_float_t(other.data_.v_double_); break;
-    case kind::array: new (&data_.v_array_) array_t(std::move(other.data_.v_array_)); break;
-    case kind::object: new (&data_.v_object_) object_t(std::move(other.data_.v_object_)); break;
+    case kind::array:
+      data_.v_array_ = create<array_t>(std::move(*other.data_.v_array_), alloc);
+      break;
+    case kind::object:
+      data_.v_object_ = create<object_t>(std::move(*other.data_.v_object_), alloc);
+      break;
     case kind::error:  // new (&data_.v_error_) error(std::move(other.data_.v_error_)); break;
 
     default: break;
@@ -53,18 +117,24 @@ value::value(value&& other) noexcept
   other.destory();
 }
 
-value::value(json::kind kind) noexcept
-    : kind_(kind)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(json::kind kind, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind)
 {
   switch (kind_)
   {
     case kind::boolean: new (&data_.v_bool_) bool(false); break;
-    case kind::string: new (&data_.v_string_) string_t{}; break;
+    case kind::string: data_.v_string_ = create<string_t>(alloc); break;
+    case kind::string_view:
+      data_.v_view_ = "";
+      view_size_    = 0;
+      break;
     case kind::number_int: new (&data_.v_int_) number_uint_t(0); break;
     case kind::number_uint: new (&data_.v_uint_) number_int_t(0); break;
     case kind::number_float: new (&data_.v_double_) number_float_t(0.0); break;
-    case kind::array: new (&data_.v_array_) array_t{}; break;
-    case kind::object: new (&data_.v_object_) object_t{}; break;
+    case kind::array: data_.v_array_ = create<array_t>(alloc); break;
+    case kind::object: data_.v_object_ = create<object_t>(alloc); break;
     case kind::error:
       // new (&data_.v_error_) error(other.data_.v_error_);
       break;
@@ -73,137 +143,180 @@ value::value(json::kind kind) noexcept
   }
 }
 
-value::value(std::nullptr_t) noexcept
-    : kind_(kind::null)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(std::nullptr_t, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::null)
 {}
 
-value::value(float v) noexcept
-    : kind_(kind::number_float)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(float v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::number_float)
 {
   new (&data_.v_double_) number_float_t(v);
 }
 
-value::value(double v) noexcept
-    : kind_(kind::number_float)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(double v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::number_float)
 {
   new (&data_.v_double_) number_float_t(v);
 }
 
-value::value(signed char v) noexcept
-    : kind_(kind::number_int)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(signed char v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::number_int)
 {
   new (&data_.v_int_) int64_t(v);
 }
 
-value::value(signed short v) noexcept
-    : kind_(kind::number_int)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(signed short v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::number_int)
 {
   new (&data_.v_int_) int64_t(v);
 }
 
-value::value(signed int v) noexcept
-    : kind_(kind::number_int)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(signed int v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::number_int)
 {
   new (&data_.v_int_) int64_t(v);
 }
 
-value::value(signed long v) noexcept
-    : kind_(kind::number_int)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(signed long v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::number_int)
 {
   new (&data_.v_int_) int64_t(v);
 }
 
-value::value(signed long long v) noexcept
-    : kind_(kind::number_int)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(signed long long v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::number_int)
 {
   new (&data_.v_int_) int64_t(v);
 }
 
-value::value(unsigned char v) noexcept
-    : kind_(kind::number_uint)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(unsigned char v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::number_uint)
 {
   new (&data_.v_uint_) uint64_t(v);
 }
 
-value::value(unsigned short v) noexcept
-    : kind_(kind::number_uint)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(unsigned short v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::number_uint)
 {
   new (&data_.v_uint_) uint64_t(v);
 }
 
-value::value(unsigned int v) noexcept
-    : kind_(kind::number_uint)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(unsigned int v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::number_uint)
 {
   new (&data_.v_uint_) uint64_t(v);
 }
 
-value::value(unsigned long v) noexcept
-    : kind_(kind::number_uint)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(unsigned long v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::number_uint)
 {
   new (&data_.v_uint_) uint64_t(v);
 }
 
-value::value(unsigned long long v) noexcept
-    : kind_(kind::number_uint)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(unsigned long long v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::number_uint)
 {
   new (&data_.v_uint_) uint64_t(v);
 }
 
-value::value(const string_t& v) noexcept
-    : kind_(kind::string)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(const string_t& v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::string)
 {
-  new (&data_.v_string_) string_t(v);
+  data_.v_string_ = create<string_t>(v, alloc);
 }
 
-value::value(string_t&& v) noexcept
-    : kind_(kind::string)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(string_t&& v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::string)
 {
-  new (&data_.v_string_) string_t(std::move(v));
+  data_.v_string_ = create<string_t>(std::move(v), alloc);
 }
 
-value::value(const char* v) noexcept
-    : kind_(kind::string)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(const char* v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::string)
 {
-  new (&data_.v_string_) string_t(v);
+  data_.v_string_ = create<string_t>(v, alloc);
 }
 
-value::value(const array_t& v) noexcept
-    : kind_(kind::array)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(const array_t& v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::array)
 {
-  new (&data_.v_array_) array_t(v);
+  data_.v_array_ = create<array_t>(v, alloc);
 }
 
-value::value(array_t&& v) noexcept
-    : kind_(kind::array)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(array_t&& v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::array)
 {
-  new (&data_.v_array_) array_t(std::move(v));
+  data_.v_array_ = create<array_t>(std::move(v), alloc);
 }
 
-value::value(const object_t& v) noexcept
-    : kind_(kind::object)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(const object_t& v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::object)
 {
-  new (&data_.v_object_) object_t(v);
+  data_.v_object_ = create<object_t>(v, alloc);
 }
 
-value::value(object_t&& v) noexcept
-    : kind_(kind::object)
+template <typename Allocator>
+basic_value<Allocator>::basic_value(object_t&& v, const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
+    , kind_(kind::object)
 {
-  new (&data_.v_object_) object_t(std::move(v));
+  data_.v_object_ = create<object_t>(std::move(v), alloc);
 }
 
-value::value(initializer_list_t init_list) noexcept
+template <typename Allocator>
+basic_value<Allocator>::basic_value(initializer_list_t init_list,
+                                    const allocator_type& alloc) noexcept
+    : detail::allocator_storage<Allocator>(alloc)
 {
   if (init_list.size() == 1)
   {
     auto& other = init_list.begin()->operator*();
 
-    if (other.is_array() && other.data_.v_array_.size() == 2 && other[0].is_string())
+    if (other.is_array() && other.data_.v_array_->size() == 2 && other[0].is_string())
     {
-      value v = other[static_cast<size_type>(1)];
+      basic_value v = other[static_cast<size_type>(1)];
 
       kind_ = kind::object;
-      new (&data_.v_object_) object_t();
-      data_.v_object_.emplace(other[static_cast<size_type>(0)].as_string(), v);
+      data_.v_object_ = create<object_t>(alloc);
+      data_.v_object_->emplace(other[static_cast<size_type>(0)].as_string(), v);
 
       return;
     }
@@ -219,45 +332,54 @@ value::value(initializer_list_t init_list) noexcept
   if (is_object)
   {
     kind_ = kind::object;
-    new (&data_.v_object_) object_t();
+    data_.v_object_ = create<object_t>(alloc);
 
     for (auto& value_ref : init_list)
     {
-      value v = (*value_ref)[static_cast<size_type>(1)];
+      basic_value v = (*value_ref)[static_cast<size_type>(1)];
 
-      data_.v_object_.emplace((*value_ref)[size_type(0)].as_string(), v);
+      data_.v_object_->emplace((*value_ref)[size_type(0)].as_string(), v);
     }
   }
   else
   {
     kind_ = kind::array;
-    new (&data_.v_array_) array_t();
+    data_.v_array_ = create<array_t>(alloc);
 
     for (auto& value_ref : init_list)
     {
-      data_.v_array_.push_back(*value_ref);
+      data_.v_array_->push_back(*value_ref);
     }
   }
 }
 
-value::~value() noexcept
+template <typename Allocator>
+basic_value<Allocator>::~basic_value() noexcept
 {
   this->destory();
 }
 
-value& value::operator=(const value& other) noexcept
+// the value keeps its allocator, the contents of other are copied with it
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(const basic_value& other) noexcept
 {
+  if (this == &other) return *this;
+
   this->destory();
 
+  const allocator_type& alloc = this->allocator();
+
+  this->kind_ = other.kind_;
   switch (other.kind_)
   {
     case kind::boolean: new (&data_.v_bool_) bool(other.data_.v_bool_); break;
-    case kind::string: new (&data_.v_string_) string_t(other.data_.v_string_); break;
+    case kind::string: data_.v_string_ = create<string_t>(*other.data_.v_string_, alloc); break;
+    case kind::string_view: copy_view(other.view(), alloc); break;
     case kind::number_int: new (&data_.v_int_) int64_t(other.data_.v_int_); break;
     case kind::number_uint: new (&data_.v_uint_) uint64_t(other.data_.v_uint_); break;
     case kind::number_float: new (&data_.v_double_) number_float_t(other.data_.v_double_); break;
-    case kind::array: new (&data_.v_array_) array_t(other.data_.v_array_); break;
-    case kind::object: new (&data_.v_object_) object_t(other.data_.v_object_); break;
+    case kind::array: data_.v_array_ = create<array_t>(*other.data_.v_array_, alloc); break;
+    case kind::object: data_.v_object_ = create<object_t>(*other.data_.v_object_, alloc); break;
     case kind::error:
       // new (&data_.v_error_) error(std::move(other.data_.v_error_));
       break;
@@ -265,24 +387,48 @@ value& value::operator=(const value& other) noexcept
     default: break;
   }
 
-  this->kind_ = other.kind_;
-
   return *this;
 }
 
-value& value::operator=(value&& other) noexcept
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(basic_value&& other) noexcept
 {
+  if (this == &other) return *this;
+
+  // the storage is taken over with an equal allocator. the previous contents are released last,
+  // other may be one of their elements
+  if (this->allocator() == other.allocator())
+  {
+    basic_value previous(std::move(*this));
+
+    kind_       = other.kind_;
+    view_size_  = other.view_size_;
+    data_       = other.data_;
+    other.kind_ = kind::null;
+    return *this;
+  }
+
   this->destory();
 
+  const allocator_type& alloc = this->allocator();
+
+  this->kind_ = other.kind_;
   switch (other.kind_)
   {
     case kind::boolean: new (&data_.v_bool_) bool(other.data_.v_bool_); break;
-    case kind::string: new (&data_.v_string_) string_t(std::move(other.data_.v_string_)); break;
+    case kind::string:
+      data_.v_string_ = create<string_t>(std::move(*other.data_.v_string_), alloc);
+      break;
+    case kind::string_view: copy_view(other.view(), alloc); break;
     case kind::number_int: new (&data_.v_int_) int64_t(other.data_.v_int_); break;
     case kind::number_uint: new (&data_.v_uint_) uint64_t(other.data_.v_uint_); break;
     case kind::number_float: new (&data_.v_double_) number_float_t(other.data_.v_double_); break;
-    case kind::array: new (&data_.v_array_) array_t(std::move(other.data_.v_array_)); break;
-    case kind::object: new (&data_.v_object_) object_t(std::move(other.data_.v_object_)); break;
+    case kind::array:
+      data_.v_array_ = create<array_t>(std::move(*other.data_.v_array_), alloc);
+      break;
+    case kind::object:
+      data_.v_object_ = create<object_t>(std::move(*other.data_.v_object_), alloc);
+      break;
     case kind::error:
       // new (&data_.v_error_) error(std::move(other.data_.v_error_));
       break;
@@ -290,332 +436,430 @@ value& value::operator=(value&& other) noexcept
     default: break;
   }
 
-  this->kind_ = other.kind_;
-
   other.destory();
   return *this;
 }
 
-value& value::operator=(json::kind kind) noexcept
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(json::kind kind) noexcept
 {
-  value(kind).swap(*this);
+  basic_value(kind, this->allocator()).swap(*this);
   return *this;
 }
 
-value& value::operator=(std::nullptr_t) noexcept
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(std::nullptr_t) noexcept
 {
-  value(nullptr).swap(*this);
+  basic_value(nullptr, this->allocator()).swap(*this);
   return *this;
 }
 
-value& value::operator=(float v) noexcept
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(float v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(double v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(double v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(signed char v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(signed char v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(signed short v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(signed short v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(signed int v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(signed int v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(signed long v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(signed long v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(signed long long v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(signed long long v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(unsigned char v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(unsigned char v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(unsigned short v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(unsigned short v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(unsigned int v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(unsigned int v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(unsigned long v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(unsigned long v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(unsigned long long v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(unsigned long long v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(const string_t& v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(const string_t& v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
 
-value& value::operator=(string_t&& v) noexcept
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(string_t&& v) noexcept
 {
-  value(std::move(v)).swap(*this);
+  basic_value(std::move(v), this->allocator()).swap(*this);
   return *this;
 }
 
-value& value::operator=(const char* v) noexcept
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(const char* v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
 
-value& value::operator=(const array_t& v) noexcept
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(const array_t& v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(array_t&& v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(array_t&& v) noexcept
 {
-  value(std::move(v)).swap(*this);
+  basic_value(std::move(v), this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(const object_t& v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(const object_t& v) noexcept
 {
-  value(v).swap(*this);
+  basic_value(v, this->allocator()).swap(*this);
   return *this;
 }
-value& value::operator=(object_t&& v) noexcept
+
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(object_t&& v) noexcept
 {
-  value(std::move(v)).swap(*this);
+  basic_value(std::move(v), this->allocator()).swap(*this);
   return *this;
 }
 
-value& value::operator=(initializer_list_t init_list) noexcept
+template <typename Allocator>
+basic_value<Allocator>& basic_value<Allocator>::operator=(initializer_list_t init_list) noexcept
 {
-  value v(std::move(init_list));
+  basic_value v(std::move(init_list), this->allocator());
   swap(v);
 
   return *this;
 }
 
-value::boolean_t* value::if_bool() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::boolean_t* basic_value<Allocator>::if_bool() noexcept
 {
   return (is_bool()) ? &data_.v_bool_ : nullptr;
 }
 
-value::number_int_t* value::if_int64() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::number_int_t* basic_value<Allocator>::if_int64() noexcept
 {
   return (is_int64()) ? &data_.v_int_ : nullptr;
 }
 
-value::number_uint_t* value::if_uint64() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::number_uint_t* basic_value<Allocator>::if_uint64() noexcept
 {
   return (is_uint64()) ? &data_.v_uint_ : nullptr;
 }
 
-value::number_float_t* value::if_double() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::number_float_t* basic_value<Allocator>::if_double() noexcept
 {
   return (is_double()) ? &data_.v_double_ : nullptr;
 }
 
-value::string_t* value::if_string() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::string_t* basic_value<Allocator>::if_string() noexcept
 {
-  return (is_string()) ? &data_.v_string_ : nullptr;
+  return (is_string()) ? data_.v_string_ : nullptr;
 }
 
-value::array_t* value::if_array() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::array_t* basic_value<Allocator>::if_array() noexcept
 {
-  return (is_array()) ? &data_.v_array_ : nullptr;
+  return (is_array()) ? data_.v_array_ : nullptr;
 }
 
-value::object_t* value::if_object() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::object_t* basic_value<Allocator>::if_object() noexcept
 {
-  return (is_object()) ? &data_.v_object_ : nullptr;
+  return (is_object()) ? data_.v_object_ : nullptr;
 }
 
-const value::boolean_t* value::if_bool() const noexcept
+template <typename Allocator>
+const typename basic_value<Allocator>::boolean_t* basic_value<Allocator>::if_bool() const noexcept
 {
   return (is_bool()) ? &data_.v_bool_ : nullptr;
 }
 
-const value::number_int_t* value::if_int64() const noexcept
+template <typename Allocator>
+const typename basic_value<Allocator>::number_int_t*
+basic_value<Allocator>::if_int64() const noexcept
 {
   return (is_int64()) ? &data_.v_int_ : nullptr;
 }
 
-const value::number_uint_t* value::if_uint64() const noexcept
+template <typename Allocator>
+const typename basic_value<Allocator>::number_uint_t*
+basic_value<Allocator>::if_uint64() const noexcept
 {
   return (is_uint64()) ? &data_.v_uint_ : nullptr;
 }
 
-const value::number_float_t* value::if_double() const noexcept
+template <typename Allocator>
+const typename basic_value<Allocator>::number_float_t*
+basic_value<Allocator>::if_double() const noexcept
 {
   return (is_double()) ? &data_.v_double_ : nullptr;
 }
 
-const value::string_t* value::if_string() const noexcept
+template <typename Allocator>
+const typename basic_value<Allocator>::string_t* basic_value<Allocator>::if_string() const noexcept
 {
-  return (is_string()) ? &data_.v_string_ : nullptr;
+  return (is_string()) ? data_.v_string_ : nullptr;
 }
-const value::array_t* value::if_array() const noexcept
+template <typename Allocator>
+const typename basic_value<Allocator>::array_t* basic_value<Allocator>::if_array() const noexcept
 {
-  return (is_array()) ? &data_.v_array_ : nullptr;
+  return (is_array()) ? data_.v_array_ : nullptr;
 }
-const value::object_t* value::if_object() const noexcept
+template <typename Allocator>
+const typename basic_value<Allocator>::object_t* basic_value<Allocator>::if_object() const noexcept
 {
-  return (is_object()) ? &data_.v_object_ : nullptr;
+  return (is_object()) ? data_.v_object_ : nullptr;
 }
 
-bool value::is_bool() const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::is_bool() const noexcept
 {
   return kind_ == kind::boolean;
 }
 
-bool value::is_null() const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::is_null() const noexcept
 {
   return kind_ == kind::null;
 }
 
-bool value::is_int64() const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::is_int64() const noexcept
 {
   return kind_ == kind::number_int;
 }
 
-bool value::is_uint64() const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::is_uint64() const noexcept
 {
   return kind_ == kind::number_uint;
 }
 
-bool value::is_double() const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::is_double() const noexcept
 {
   return kind_ == kind::number_float;
 }
 
-bool value::is_string() const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::is_string() const noexcept
 {
   return kind_ == kind::string;
 }
 
-bool value::is_array() const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::is_array() const noexcept
 {
   return kind_ == kind::array;
 }
 
-bool value::is_object() const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::is_object() const noexcept
 {
   return kind_ == kind::object;
 }
 
-bool value::is_number() const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::is_number() const noexcept
 {
   return (kind_ == kind::number_int || kind_ == kind::number_uint || kind_ == kind::number_float);
 }
 
-bool value::is_error() const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::is_error() const noexcept
 {
   return kind_ == kind::error;
 }
 
-bool& value::as_bool() noexcept(false)
+template <typename Allocator>
+bool basic_value<Allocator>::is_string_view() const noexcept
+{
+  return kind_ == kind::string_view;
+}
+
+template <typename Allocator>
+bool& basic_value<Allocator>::as_bool() noexcept(false)
 {
   FORMATS_THROW_IF(!is_bool(), type_except::create("can't use as_bool with type", type_name()));
   return data_.v_bool_;
 }
 
-value::number_int_t& value::as_int64() noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::number_int_t& basic_value<Allocator>::as_int64() noexcept(false)
 {
   FORMATS_THROW_IF(!is_int64(), type_except::create("can't use as_int with type", type_name()));
   return data_.v_int_;
 }
 
-value::number_uint_t& value::as_uint64() noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::number_uint_t& basic_value<Allocator>::as_uint64() noexcept(false)
 {
   FORMATS_THROW_IF(!is_uint64(), type_except::create("can't use as_uint with type", type_name()));
   return data_.v_uint_;
 }
 
-value::number_float_t& value::as_double() noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::number_float_t& basic_value<Allocator>::as_double() noexcept(false)
 {
   FORMATS_THROW_IF(!is_double(), type_except::create("can't use as_float with type", type_name()));
   return data_.v_double_;
 }
 
-value::string_t& value::as_string() noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::string_t& basic_value<Allocator>::as_string() noexcept(false)
 {
   FORMATS_THROW_IF(!is_string(), type_except::create("can't use as_string with type", type_name()));
-  return data_.v_string_;
+  return *data_.v_string_;
 }
-value::array_t& value::as_array() noexcept(false)
+
+template <typename Allocator>
+std::string_view basic_value<Allocator>::as_string_view() const noexcept(false)
+{
+  if (is_string_view()) return view();
+
+  FORMATS_THROW_IF(!is_string(),
+                   type_except::create("can't use as_string_view with type", type_name()));
+  return *data_.v_string_;
+}
+template <typename Allocator>
+typename basic_value<Allocator>::array_t& basic_value<Allocator>::as_array() noexcept(false)
 {
   FORMATS_THROW_IF(!is_array(), type_except::create("can't use as_array with type", type_name()));
-  return data_.v_array_;
+  return *data_.v_array_;
 }
-value::object_t& value::as_object() noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::object_t& basic_value<Allocator>::as_object() noexcept(false)
 {
   FORMATS_THROW_IF(!is_object(), type_except::create("can't use as_object with type", type_name()));
-  return data_.v_object_;
+  return *data_.v_object_;
 }
 
-bool value::as_bool() const noexcept(false)
+template <typename Allocator>
+bool basic_value<Allocator>::as_bool() const noexcept(false)
 {
   FORMATS_THROW_IF(!is_bool(), type_except::create("can't use as_bool with type", type_name()));
   return data_.v_bool_;
 }
 
-value::number_int_t value::as_int64() const noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::number_int_t
+basic_value<Allocator>::as_int64() const noexcept(false)
 {
   FORMATS_THROW_IF(!is_int64(), type_except::create("can't use as_int with type", type_name()));
   return data_.v_int_;
 }
 
-value::number_uint_t value::as_uint64() const noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::number_uint_t
+basic_value<Allocator>::as_uint64() const noexcept(false)
 {
   FORMATS_THROW_IF(!is_uint64(), type_except::create("can't use as_uint with type", type_name()));
   return data_.v_uint_;
 }
 
-double value::as_double() const noexcept(false)
+template <typename Allocator>
+double basic_value<Allocator>::as_double() const noexcept(false)
 {
   FORMATS_THROW_IF(!is_double(), type_except::create("can't use as_float with type", type_name()));
   return data_.v_double_;
 }
 
-const value::string_t& value::as_string() const noexcept(false)
+template <typename Allocator>
+const typename basic_value<Allocator>::string_t&
+basic_value<Allocator>::as_string() const noexcept(false)
 {
   FORMATS_THROW_IF(!is_string(), type_except::create("can't use as_string with type", type_name()));
-  return data_.v_string_;
+  return *data_.v_string_;
 }
 
-const value::array_t& value::as_array() const noexcept(false)
+template <typename Allocator>
+const typename basic_value<Allocator>::array_t&
+basic_value<Allocator>::as_array() const noexcept(false)
 {
   FORMATS_THROW_IF(!is_array(), type_except::create("can't use as_array with type", type_name()));
-  return data_.v_array_;
+  return *data_.v_array_;
 }
 
-const value::object_t& value::as_object() const noexcept(false)
+template <typename Allocator>
+const typename basic_value<Allocator>::object_t&
+basic_value<Allocator>::as_object() const noexcept(false)
 {
   FORMATS_THROW_IF(!is_object(), type_except::create("can't use as_object with type", type_name()));
-  return data_.v_object_;
+  return *data_.v_object_;
 }
 
-bool value::to_bool(bool dflt) const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::to_bool(bool dflt) const noexcept
 {
   switch (kind_)
   {
@@ -624,7 +868,9 @@ bool value::to_bool(bool dflt) const noexcept
     case kind::number_uint: return data_.v_uint_ != 0;
     case kind::number_float: return data_.v_double_ != 0.0;
     case kind::string:
-      return !data_.v_string_.empty() && !equal(toupper(data_.v_string_), "FALSE", 5);
+      return !data_.v_string_->empty() && !equal(toupper(*data_.v_string_), "FALSE", 5);
+    case kind::string_view:
+      return view_size_ != 0 && !equal(toupper(std::string(view())), "FALSE", 5);
 
     default: break;
   }
@@ -632,7 +878,9 @@ bool value::to_bool(bool dflt) const noexcept
   return dflt;
 }
 
-value::number_int_t value::to_int64(value::number_int_t dflt) const noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::number_int_t basic_value<Allocator>::to_int64(
+    number_int_t dflt) const noexcept
 {
   switch (kind_)
   {
@@ -651,7 +899,12 @@ value::number_int_t value::to_int64(value::number_int_t dflt) const noexcept
 
     case kind::boolean: return data_.v_bool_ ? 1 : 0;
     case kind::string: {
-      auto result = strtoll(data_.v_string_);
+      auto result = strtoll(data_.v_string_->c_str());
+      if (result.second) return result.first;
+      break;
+    }
+    case kind::string_view: {
+      auto result = strtoll(std::string(view()).c_str());
       if (result.second) return result.first;
     }
 
@@ -661,7 +914,9 @@ value::number_int_t value::to_int64(value::number_int_t dflt) const noexcept
   return dflt;
 }
 
-value::number_uint_t value::to_uint64(value::number_uint_t dflt) const noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::number_uint_t basic_value<Allocator>::to_uint64(
+    number_uint_t dflt) const noexcept
 {
   switch (kind_)
   {
@@ -675,7 +930,12 @@ value::number_uint_t value::to_uint64(value::number_uint_t dflt) const noexcept
 
     case kind::boolean: return data_.v_bool_ ? 1 : 0;
     case kind::string: {
-      auto result = strtoull(data_.v_string_);
+      auto result = strtoull(data_.v_string_->c_str());
+      if (result.second) return result.first;
+      break;
+    }
+    case kind::string_view: {
+      auto result = strtoull(std::string(view()).c_str());
       if (result.second) return result.first;
     }
 
@@ -685,7 +945,8 @@ value::number_uint_t value::to_uint64(value::number_uint_t dflt) const noexcept
   return dflt;
 }
 
-double value::to_double(double dflt) const noexcept
+template <typename Allocator>
+double basic_value<Allocator>::to_double(double dflt) const noexcept
 {
   switch (kind_)
   {
@@ -694,7 +955,12 @@ double value::to_double(double dflt) const noexcept
     case kind::number_int: return (number_float_t)data_.v_int_;
     case kind::boolean: return (number_float_t)data_.v_bool_;
     case kind::string: {
-      auto result = strtod(data_.v_string_);
+      auto result = strtod(data_.v_string_->c_str());
+      if (result.second) return result.first;
+      break;
+    }
+    case kind::string_view: {
+      auto result = strtod(std::string(view()).c_str());
       if (result.second) return result.first;
     }
 
@@ -704,86 +970,110 @@ double value::to_double(double dflt) const noexcept
   return dflt;
 }
 
-value::string_t value::to_string(string_t&& dflt) const noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::string_t basic_value<Allocator>::to_string(
+    string_t&& dflt) const noexcept
 {
   switch (kind_)
   {
-    case kind::string: return data_.v_string_;
-    case kind::number_int: return std::to_string(data_.v_int_);
-    case kind::number_uint: return std::to_string(data_.v_uint_);
-    case kind::number_float: return dtoa(data_.v_double_);
-    case kind::boolean: return data_.v_bool_ ? "true" : "false";
-    case kind::null: return "null";
+    case kind::string: return *data_.v_string_;
+    case kind::string_view:
+      return string_t(data_.v_view_, view_size_, this->allocator());
+    case kind::number_int:
+      return to_string_t<string_t>(std::to_string(data_.v_int_), this->allocator());
+    case kind::number_uint:
+      return to_string_t<string_t>(std::to_string(data_.v_uint_), this->allocator());
+    case kind::number_float: return to_string_t<string_t>(dtoa(data_.v_double_), this->allocator());
+    case kind::boolean: return string_t(data_.v_bool_ ? "true" : "false", this->allocator());
+    case kind::null: return string_t("null", this->allocator());
     default: break;
   }
 
   return dflt;
 }
 
-json::kind value::kind() const noexcept
+template <typename Allocator>
+json::kind basic_value<Allocator>::kind() const noexcept
 {
   return kind_;
 }
 
-value::string_t value::type_name() const noexcept
+template <typename Allocator>
+std::string basic_value<Allocator>::type_name() const noexcept
 {
   const char* types_name[] = {"error",        "null",   "boolean", "number_int", "number_uint",
-                              "number_float", "string", "array",   "object"};
+                              "number_float", "string", "array",   "object",
+                              "string_view"};
 
   return types_name[(int)kind_];
 }
 
-value::string_t value::get(const char* key, string_t dflt) const noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::string_t basic_value<Allocator>::get(std::string_view key,
+                                                                      string_t dflt) const noexcept
 {
   auto result = if_contains(key);
   return result ? result->to_string(std::move(dflt)) : dflt;
 }
 
-value::string_t value::get(const char* key_path, char separator, string_t dflt) const noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::string_t basic_value<Allocator>::get(const char* key_path,
+                                                                      char separator,
+                                                                      string_t dflt) const noexcept
 {
   auto val = if_contains(key_path, separator);
   return val ? val->to_string(std::move(dflt)) : dflt;
 }
 
-bool value::empty() const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::empty() const noexcept
 {
-  if (is_array()) return data_.v_array_.empty();
-  if (is_object()) return data_.v_object_.empty();
+  if (is_array()) return data_.v_array_->empty();
+  if (is_object()) return data_.v_object_->empty();
 
   return true;
 }
 
-value::size_type value::size() const noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::size_type basic_value<Allocator>::size() const noexcept
 {
-  if (is_array()) return data_.v_array_.size();
-  if (is_object()) return data_.v_object_.size();
+  if (is_array()) return data_.v_array_->size();
+  if (is_object()) return data_.v_object_->size();
 
   return 0;
 }
 
-value::iterator value::find(const object_t::key_type& key) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::iterator basic_value<Allocator>::find(
+    std::string_view key) noexcept(false)
 {
-  if (is_object()) { return value::iterator(this, data_.v_object_.find(key)); }
+  if (is_object()) { return iterator(this, data_.v_object_->find(key)); }
 
   FORMATS_THROW(type_except::create("can't use find() with type", type_name()));
 }
 
-value::const_iterator value::find(const object_t::key_type& key) const noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::const_iterator basic_value<Allocator>::find(
+    std::string_view key) const noexcept(false)
 {
-  if (is_object()) { return value::const_iterator(this, data_.v_object_.find(key)); }
+  if (is_object()) { return const_iterator(this, data_.v_object_->find(key)); }
 
   FORMATS_THROW(type_except::create("can't use find() with type", type_name()));
 }
 
-value::iterator value::find(const char* path, char path_separator) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::iterator basic_value<Allocator>::find(
+    const char* path,
+    char path_separator) noexcept(false)
 {
   if (is_object())
   {
-    auto keys = spilt(path, path_separator);
+    std::string_view keys(path);
 
-    value::iterator iter;
+    iterator iter;
 
-    for (const auto& key : keys)
+    for (auto key = next_segment(keys, path_separator); !key.empty();
+         key = next_segment(keys, path_separator))
     {
       iter = find(key);
       if (iter == end()) break;
@@ -795,15 +1085,19 @@ value::iterator value::find(const char* path, char path_separator) noexcept(fals
   FORMATS_THROW(type_except::create("can't use find() with type", type_name()));
 }
 
-value::const_iterator value::find(const char* path, char path_separator) const noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::const_iterator basic_value<Allocator>::find(
+    const char* path,
+    char path_separator) const noexcept(false)
 {
   if (is_object())
   {
-    auto keys = spilt(path, path_separator);
+    std::string_view keys(path);
 
-    value::const_iterator iter;
+    const_iterator iter;
 
-    for (const auto& key : keys)
+    for (auto key = next_segment(keys, path_separator); !key.empty();
+         key = next_segment(keys, path_separator))
     {
       iter = find(key);
       if (iter == end()) break;
@@ -815,74 +1109,79 @@ value::const_iterator value::find(const char* path, char path_separator) const n
   FORMATS_THROW(type_except::create("can't use find() with type", type_name()));
 }
 
-bool value::contains(const object_t::key_type& key) const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::contains(std::string_view key) const noexcept
 {
-  return (is_object()) ? data_.v_object_.contains(key) : false;
+  return (is_object()) ? data_.v_object_->contains(key) : false;
 }
 
-value::pointer value::if_contains(const object_t::key_type& key) noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::pointer basic_value<Allocator>::if_contains(
+    std::string_view key) noexcept
 {
   if (is_object())
   {
-    auto iter = data_.v_object_.find(key);
-    if (iter != data_.v_object_.end()) return &iter->second;
+    auto iter = data_.v_object_->find(key);
+    if (iter != data_.v_object_->end()) return &iter->second;
   }
 
   return nullptr;
 }
 
-value::pointer value::if_contains(const string_t& key_path, char separator) noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::pointer basic_value<Allocator>::if_contains(
+    const string_t& key_path,
+    char separator) noexcept
 {
-  auto paths = spilt(key_path.c_str(), separator);
+  // the keys are views of the path, nothing is copied
+  std::string_view path(key_path);
 
-  value::pointer val = this;
+  pointer val = this;
 
-  for (const auto& key : paths)
+  for (auto key = next_segment(path, separator); !key.empty() && val;
+       key = next_segment(path, separator))
   {
-    if (likely(val))
-    {
-      val = val->if_contains(key);
-      continue;
-    }
-
-    break;
+    val = val->if_contains(key);
   }
 
   return val;
 }
 
-value::const_pointer value::if_contains(const object_t::key_type& key) const noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::const_pointer basic_value<Allocator>::if_contains(
+    std::string_view key) const noexcept
 {
   if (is_object())
   {
-    auto iter = data_.v_object_.find(key);
-    if (iter != data_.v_object_.end()) return &iter->second;
+    auto iter = data_.v_object_->find(key);
+    if (iter != data_.v_object_->end()) return &iter->second;
   }
 
   return nullptr;
 }
 
-value::const_pointer value::if_contains(const string_t& key_path, char separator) const noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::const_pointer basic_value<Allocator>::if_contains(
+    const string_t& key_path,
+    char separator) const noexcept
 {
-  auto paths = spilt(key_path.c_str(), separator);
+  // the keys are views of the path, nothing is copied
+  std::string_view path(key_path);
 
-  value::const_pointer val = this;
+  const_pointer val = this;
 
-  for (const auto& key : paths)
+  for (auto key = next_segment(path, separator); !key.empty() && val;
+       key = next_segment(path, separator))
   {
-    if (likely(val))
-    {
-      val = val->if_contains(key);
-      continue;
-    }
-
-    break;
+    val = val->if_contains(key);
   }
 
   return val;
 }
 
-value::reference value::at(const object_t::key_type& key) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::reference basic_value<Allocator>::at(
+    std::string_view key) noexcept(false)
 {
   if (is_object())
   {
@@ -899,7 +1198,9 @@ value::reference value::at(const object_t::key_type& key) noexcept(false)
 //  return at(key);
 //}
 
-value::const_reference value::at(const object_t::key_type& key) const noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::const_reference basic_value<Allocator>::at(
+    std::string_view key) const noexcept(false)
 {
   if (is_object())
   {
@@ -916,33 +1217,42 @@ value::const_reference value::at(const object_t::key_type& key) const noexcept(f
 //  return at(key);
 //}
 
-value::reference value::operator[](const object_t::key_type& key) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::reference basic_value<Allocator>::operator[](
+    std::string_view key) noexcept(false)
 {
-  if (is_object()) return data_.v_object_[key];
+  if (is_object()) return (*data_.v_object_)[key];
   FORMATS_THROW(type_except::create("can't use operator[] with string whth type", type_name()));
 }
 
-value::reference value::operator[](object_t::key_type&& key) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::reference basic_value<Allocator>::operator[](
+    typename object_t::key_type&& key) noexcept(false)
 {
-  if (is_object()) return data_.v_object_[std::move(key)];
+  if (is_object()) return (*data_.v_object_)[std::move(key)];
   FORMATS_THROW(type_except::create("can't use operator[] with string whth type", type_name()));
 }
 
-value::const_reference value::operator[](const object_t::key_type& key) const noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::const_reference basic_value<Allocator>::operator[](
+    std::string_view key) const noexcept(false)
 {
   return at(key);
 }
 
-value::const_reference value::operator[](object_t::key_type&& key) const noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::const_reference basic_value<Allocator>::operator[](
+    typename object_t::key_type&& key) const noexcept(false)
 {
   return at(key);
 }
 
-value::reference value::at(size_type pos) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::reference basic_value<Allocator>::at(size_type pos) noexcept(false)
 {
   if (is_array())
   {
-    if (pos < data_.v_array_.size()) return data_.v_array_[pos];
+    if (pos < data_.v_array_->size()) return (*data_.v_array_)[pos];
 
     FORMATS_THROW(range_except::create("operator[] index out of range", pos));
   }
@@ -950,11 +1260,13 @@ value::reference value::at(size_type pos) noexcept(false)
   FORMATS_THROW(type_except::create("can't use operator[] with type", type_name()));
 }
 
-value::const_reference value::at(size_type pos) const noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::const_reference basic_value<Allocator>::at(
+    size_type pos) const noexcept(false)
 {
   if (is_array())
   {
-    if (pos < data_.v_array_.size()) return data_.v_array_[pos];
+    if (pos < data_.v_array_->size()) return (*data_.v_array_)[pos];
 
     FORMATS_THROW(range_except::create("operator[] index out of range", pos));
   }
@@ -962,7 +1274,8 @@ value::const_reference value::at(size_type pos) const noexcept(false)
   FORMATS_THROW(type_except::create("can't use operator[] with type", type_name()));
 }
 
-bool value::operator==(const value& other) const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::operator==(const basic_value& other) const noexcept
 {
   if (kind_ == other.kind_)
   {
@@ -972,9 +1285,10 @@ bool value::operator==(const value& other) const noexcept
       case kind::number_int: return data_.v_int_ == other.data_.v_int_;
       case kind::number_uint: return data_.v_uint_ == other.data_.v_uint_;
       case kind::number_float: return data_.v_double_ == other.data_.v_double_;
-      case kind::string: return data_.v_string_ == other.data_.v_string_;
-      case kind::array: return data_.v_array_ == other.data_.v_array_;
-      case kind::object: return data_.v_object_ == other.data_.v_object_;
+      case kind::string: return *data_.v_string_ == *other.data_.v_string_;
+      case kind::string_view: return view() == other.view();
+      case kind::array: return *data_.v_array_ == *other.data_.v_array_;
+      case kind::object: return *data_.v_object_ == *other.data_.v_object_;
       case kind::null: return true;
       case kind::error: return true; break;
 
@@ -988,20 +1302,27 @@ bool value::operator==(const value& other) const noexcept
                                               : (this->to_uint64() == other.to_uint64());
   }
 
+  // a string and a view are equal by their text
+  if ((is_string() || is_string_view()) && (other.is_string() || other.is_string_view()))
+    return as_string_view() == other.as_string_view();
+
   return false;
 }
 
-bool value::operator!=(const value& other) const noexcept
+template <typename Allocator>
+bool basic_value<Allocator>::operator!=(const basic_value& other) const noexcept
 {
   return !(this->operator==(other));
 }
 
-void value::emplace_null() noexcept
+template <typename Allocator>
+void basic_value<Allocator>::emplace_null() noexcept
 {
   destory();
 }
 
-value::boolean_t& value::emplace_bool() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::boolean_t& basic_value<Allocator>::emplace_bool() noexcept
 {
   destory();
   kind_ = kind::boolean;
@@ -1010,7 +1331,8 @@ value::boolean_t& value::emplace_bool() noexcept
   return data_.v_bool_;
 }
 
-value::number_int_t& value::emplace_int64() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::number_int_t& basic_value<Allocator>::emplace_int64() noexcept
 {
   destory();
   kind_ = kind::number_int;
@@ -1019,7 +1341,8 @@ value::number_int_t& value::emplace_int64() noexcept
   return data_.v_int_;
 }
 
-value::number_uint_t& value::emplace_uint64() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::number_uint_t& basic_value<Allocator>::emplace_uint64() noexcept
 {
   destory();
   kind_ = kind::number_uint;
@@ -1028,7 +1351,8 @@ value::number_uint_t& value::emplace_uint64() noexcept
   return data_.v_uint_;
 }
 
-value::number_float_t& value::emplace_double() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::number_float_t& basic_value<Allocator>::emplace_double() noexcept
 {
   destory();
   kind_ = kind::number_float;
@@ -1037,40 +1361,45 @@ value::number_float_t& value::emplace_double() noexcept
   return data_.v_double_;
 }
 
-value::string_t& value::emplace_string() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::string_t& basic_value<Allocator>::emplace_string() noexcept
 {
   destory();
   kind_ = kind::string;
-  new (&data_.v_string_) string_t("");
+  data_.v_string_ = create<string_t>(this->allocator());
 
-  return data_.v_string_;
+  return *data_.v_string_;
 }
 
-value::array_t& value::emplace_array() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::array_t& basic_value<Allocator>::emplace_array() noexcept
 {
   destory();
   kind_ = kind::array;
-  new (&data_.v_array_) array_t();
+  data_.v_array_ = create<array_t>(this->allocator());
 
-  return data_.v_array_;
+  return *data_.v_array_;
 }
 
-value::object_t& value::emplace_object() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::object_t& basic_value<Allocator>::emplace_object() noexcept
 {
   destory();
   kind_ = kind::object;
-  new (&data_.v_object_) object_t();
+  data_.v_object_ = create<object_t>(this->allocator());
 
-  return data_.v_object_;
+  return *data_.v_object_;
 }
 
-void value::clear() noexcept
+template <typename Allocator>
+void basic_value<Allocator>::clear() noexcept
 {
   switch (kind_)
   {
-    case kind::array: data_.v_array_.clear(); break;
-    case kind::object: data_.v_object_.clear(); break;
-    case kind::string: data_.v_string_.clear(); break;
+    case kind::array: data_.v_array_->clear(); break;
+    case kind::object: data_.v_object_->clear(); break;
+    case kind::string: data_.v_string_->clear(); break;
+    case kind::string_view: view_size_ = 0; break;
     case kind::boolean: data_.v_bool_ = false; break;
     case kind::number_int: data_.v_int_ = 0; break;
     case kind::number_uint: data_.v_uint_ = 0; break;
@@ -1079,52 +1408,47 @@ void value::clear() noexcept
   }
 }
 
-void value::swap(value& other) noexcept
+template <typename Allocator>
+void basic_value<Allocator>::swap(basic_value& other) noexcept
 {
   if (this == &other) return void();
 
-  if (kind() == other.kind())
+  // the storage of a container can only be exchanged with the one of an equal allocator
+  if (this->allocator() == other.allocator())
   {
-    switch (kind_)
-    {
-      case kind::array: data_.v_array_.swap(other.data_.v_array_); break;
-      case kind::object: data_.v_object_.swap(other.data_.v_object_); break;
-      case kind::string: data_.v_string_.swap(other.data_.v_string_); break;
-      case kind::boolean: std::swap(data_.v_bool_, other.data_.v_bool_); break;
-      case kind::number_int: std::swap(data_.v_int_, other.data_.v_int_); break;
-      case kind::number_uint: std::swap(data_.v_uint_, other.data_.v_uint_); break;
-      case kind::number_float: std::swap(data_.v_double_, other.data_.v_double_); break;
-      default: break;
-    }
-
+    std::swap(kind_, other.kind_);
+    std::swap(view_size_, other.view_size_);
+    std::swap(data_, other.data_);
     return void();
   }
 
-  value v(std::move(*this));
+  basic_value v(std::move(*this));
   *this = std::move(other);
   other = std::move(v);
 }
 
-void value::merge(value& other) noexcept(false)
+template <typename Allocator>
+void basic_value<Allocator>::merge(basic_value& other) noexcept(false)
 {
   set_type_if_none(kind::object);
 
   if (is_object() && other.is_object())
   {
-    data_.v_object_.merge(other.data_.v_object_);
+    data_.v_object_->merge(*other.data_.v_object_);
     return void();
   }
 
   FORMATS_THROW(type_except::create("can't use merge with type", type_name()));
 }
 
-void value::merge(value&& other) noexcept(false)
+template <typename Allocator>
+void basic_value<Allocator>::merge(basic_value&& other) noexcept(false)
 {
   set_type_if_none(kind::object);
 
   if (is_object() && other.is_object())
   {
-    data_.v_object_.merge(std::move(other.data_.v_object_));
+    data_.v_object_->merge(std::move(*other.data_.v_object_));
     other.destory();
 
     return void();
@@ -1133,23 +1457,26 @@ void value::merge(value&& other) noexcept(false)
   FORMATS_THROW(type_except::create("can't use merge with type", type_name()));
 }
 
-void value::erase(const object_t::key_type& key) noexcept
+template <typename Allocator>
+void basic_value<Allocator>::erase(const typename object_t::key_type& key) noexcept
 {
-  if (is_object()) { data_.v_object_.erase(key); }
+  if (is_object()) { data_.v_object_->erase(key); }
 }
 
-void value::erase(object_t::key_type&& key) noexcept
+template <typename Allocator>
+void basic_value<Allocator>::erase(typename object_t::key_type&& key) noexcept
 {
-  if (is_object()) { data_.v_object_.erase(std::move(key)); }
+  if (is_object()) { data_.v_object_->erase(std::move(key)); }
 }
 
-void value::erase(size_type pos) noexcept(false)
+template <typename Allocator>
+void basic_value<Allocator>::erase(size_type pos) noexcept(false)
 {
   if (is_array())
   {
-    if (pos < data_.v_array_.size())
+    if (pos < data_.v_array_->size())
     {
-      data_.v_array_.erase(data_.v_array_.begin() + pos);
+      data_.v_array_->erase(data_.v_array_->begin() + pos);
       return void();
     }
 
@@ -1159,12 +1486,16 @@ void value::erase(size_type pos) noexcept(false)
   FORMATS_THROW(type_except::create("can't use erase with type", type_name()));
 }
 
-value::iterator value::erase(iterator pos) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::iterator basic_value<Allocator>::erase(
+    iterator pos) noexcept(false)
 {
   return erase(const_iterator(pos));
 }
 
-value::iterator value::erase(const_iterator pos) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::iterator basic_value<Allocator>::erase(
+    const_iterator pos) noexcept(false)
 {
   if (is_array())
   {
@@ -1178,24 +1509,30 @@ value::iterator value::erase(const_iterator pos) noexcept(false)
       FORMATS_THROW(range_except::create("can't erase iterators not within the range of this"));
     }
 
-    auto dis = std::distance(data_.v_array_.begin(), data_.v_array_.erase(pos.array_iter()));
+    auto dis = std::distance(data_.v_array_->begin(), data_.v_array_->erase(pos.array_iter()));
     return iterator(this, dis);
 
-    /*auto pos_next = data_.v_array_.erase(pos.array_iter());
-    return (pos_next != data_.v_array_.end())
-               ? iterator(this, std::distance(data_.v_array_.begin(), pos_next))
+    /*auto pos_next = data_.v_array_->erase(pos.array_iter());
+    return (pos_next != data_.v_array_->end())
+               ? iterator(this, std::distance(data_.v_array_->begin(), pos_next))
                : end();*/
   }
 
   return end();
 }
 
-value::iterator value::erase(iterator first, iterator last) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::iterator basic_value<Allocator>::erase(
+    iterator first,
+    iterator last) noexcept(false)
 {
   return erase(const_iterator(first), const_iterator(last));
 }
 
-value::iterator value::erase(const_iterator first, const_iterator last) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::iterator basic_value<Allocator>::erase(
+    const_iterator first,
+    const_iterator last) noexcept(false)
 {
   if (is_array())
   {
@@ -1204,59 +1541,72 @@ value::iterator value::erase(const_iterator first, const_iterator last) noexcept
       FORMATS_THROW(type_except::create("can't erase iterators not into *this"));
     }
 
-    auto pos_next = data_.v_array_.erase(first.array_iter(), last.array_iter());
-    return (pos_next != data_.v_array_.end())
-               ? iterator(this, std::distance(data_.v_array_.begin(), pos_next))
+    auto pos_next = data_.v_array_->erase(first.array_iter(), last.array_iter());
+    return (pos_next != data_.v_array_->end())
+               ? iterator(this, std::distance(data_.v_array_->begin(), pos_next))
                : end();
   }
 
   return end();
 }
 
-void value::push_back(const value& other) noexcept(false)
+template <typename Allocator>
+void basic_value<Allocator>::push_back(const basic_value& other) noexcept(false)
 {
   set_type_if_none(kind::array);
 
   if (is_array())
   {
-    data_.v_array_.push_back(other);
+    data_.v_array_->push_back(other);
     return void();
   }
 
   FORMATS_THROW(type_except::create("can't use push_back with type", type_name()));
 }
 
-void value::push_back(value&& other) noexcept(false)
+template <typename Allocator>
+void basic_value<Allocator>::push_back(basic_value&& other) noexcept(false)
 {
   set_type_if_none(kind::array);
 
   if (is_array())
   {
-    data_.v_array_.push_back(std::move(other));
+    data_.v_array_->push_back(std::move(other));
     return void();
   }
 
   FORMATS_THROW(type_except::create("can't use push_back with type", type_name()));
 }
 
-value::iterator value::insert(const_iterator pos, const value& val) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::iterator basic_value<Allocator>::insert(
+    const_iterator pos,
+    const basic_value& val) noexcept(false)
 {
   return insert_iterator_to_array(pos, val);
 }
 
-value::iterator value::insert(const_iterator pos, value&& val) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::iterator basic_value<Allocator>::insert(
+    const_iterator pos,
+    basic_value&& val) noexcept(false)
 {
   return insert_iterator_to_array(pos, std::move(val));
 }
 
-value::iterator value::insert(const_iterator pos, size_type cnt, const value& val) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::iterator basic_value<Allocator>::insert(
+    const_iterator pos,
+    size_type cnt,
+    const basic_value& val) noexcept(false)
 {
   return (cnt == 0)
-             ? value::iterator(this, std::distance(data_.v_array_.cbegin(), pos.array_iter()))
+             ? iterator(this, std::distance(data_.v_array_->cbegin(), pos.array_iter()))
              : insert_iterator_to_array(pos, cnt, val);
 }
 
-value::iterator value::insert(const_iterator pos,
+template <typename Allocator>
+typename basic_value<Allocator>::iterator basic_value<Allocator>::insert(const_iterator pos,
                               const_iterator first,
                               const_iterator last) noexcept(false)
 {
@@ -1268,11 +1618,14 @@ value::iterator value::insert(const_iterator pos,
   return insert_iterator_to_array(pos, first.array_iter(), last.array_iter());
 }
 
-value::iterator value::insert(const_iterator pos, initializer_list_t init_list) noexcept(false)
+template <typename Allocator>
+typename basic_value<Allocator>::iterator basic_value<Allocator>::insert(
+    const_iterator pos,
+    initializer_list_t init_list) noexcept(false)
 {
   if (is_array())
   {
-    value::iterator iter(this, std::distance(data_.v_array_.cbegin(), pos.array_iter()));
+    iterator iter(this, std::distance(data_.v_array_->cbegin(), pos.array_iter()));
 
     auto val_ref_iter = init_list.begin();
     while (val_ref_iter != init_list.end())
@@ -1292,64 +1645,115 @@ value::iterator value::insert(const_iterator pos, initializer_list_t init_list)
   FORMATS_THROW(type_except::create("can't use insert with type", type_name()));
 }
 
-value::iterator value::begin() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::iterator basic_value<Allocator>::begin() noexcept
 {
-  return is_object() ? iterator(this, data_.v_object_.begin()) : iterator(this, (size_t)0);
+  return is_object() ? iterator(this, data_.v_object_->begin()) : iterator(this, (size_t)0);
 }
 
-value::iterator value::end() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::iterator basic_value<Allocator>::end() noexcept
 {
-  return is_object() ? iterator(this, data_.v_object_.end()) : iterator(this, (size_t)-1);
+  return is_object() ? iterator(this, data_.v_object_->end()) : iterator(this, (size_t)-1);
 }
 
-value::const_iterator value::begin() const noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::const_iterator basic_value<Allocator>::begin() const noexcept
 {
-  return is_object() ? const_iterator(this, data_.v_object_.begin())
+  return is_object() ? const_iterator(this, data_.v_object_->begin())
                      : const_iterator(this, (size_t)0);
 }
 
-value::const_iterator value::end() const noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::const_iterator basic_value<Allocator>::end() const noexcept
 {
-  return is_object() ? const_iterator(this, data_.v_object_.end())
+  return is_object() ? const_iterator(this, data_.v_object_->end())
                      : const_iterator(this, (size_t)-1);
 }
 
-value::const_iterator value::cbegin() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::const_iterator basic_value<Allocator>::cbegin() noexcept
 {
   return begin();
 }
 
-value::const_iterator value::cend() noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::const_iterator basic_value<Allocator>::cend() noexcept
 {
   return end();
 }
 
-value::string_t value::dump() const noexcept
+template <typename Allocator>
+typename basic_value<Allocator>::string_t basic_value<Allocator>::dump() const noexcept
 {
-  string_t result;
+  std::string result;
   detail::stringifier(result, *this, stringify_style::pretty).dump();
 
-  return result;
+  return to_string_t<string_t>(std::move(result), this->allocator());
 }
 
-void value::destory() noexcept
+template <typename Allocator>
+void basic_value<Allocator>::destory() noexcept
 {
   switch (kind_)
   {
-    case kind::string: data_.v_string_.~string_t(); break;
+    case kind::string: release(data_.v_string_); break;
     case kind::number_float: data_.v_double_.~number_float_t(); break;
     case kind::number_int: data_.v_int_.~number_int_t(); break;
     case kind::number_uint: data_.v_uint_.~number_uint_t(); break;
     case kind::boolean: data_.v_bool_.~boolean_t(); break;
-    case kind::array: data_.v_array_.~array_t(); break;
-    case kind::object: data_.v_object_.~object_t(); break;
+    case kind::array:
+    case kind::object: release_containers(); break;
     default: break;
   }
 
   kind_ = kind::null;
 }
 
-void value::set_type_if_none(json::kind kind) noexcept
+/*
+ * the arrays and objects nested in the value are moved out to a list before the container is
+ * freed, so that no container is freed with one inside it: the value is released in a loop, not
+ * by a recursion as deep as its nesting.
+ */
+template <typename Allocator>
+void basic_value<Allocator>::release_containers() noexcept
+{
+  std::vector<basic_value> nested;
+
+  auto detach = [&nested](basic_value& v) {
+    if ((v.kind_ == kind::array && !v.data_.v_array_->empty()) ||
+        (v.kind_ == kind::object && !v.data_.v_object_->empty()))
+    {
+      nested.push_back(std::move(v));
+    }
+  };
+
+  auto release_one = [&detach](basic_value& v) {
+    if (v.kind_ == kind::array)
+    {
+      for (auto& element : *v.data_.v_array_) detach(element);
+      v.release(v.data_.v_array_);
+    }
+    else
+    {
+      for (auto& member : *v.data_.v_object_) detach(member.second);
+      v.release(v.data_.v_object_);
+    }
+
+    v.kind_ = kind::null;
+  };
+
+  release_one(*this);
+  while (!nested.empty())
+  {
+    basic_value current(std::move(nested.back()));
+    nested.pop_back();
+    release_one(current);
+  }
+}
+
+template <typename Allocator>
+void basic_value<Allocator>::set_type_if_none(json::kind kind) noexcept
 {
   if (kind_ != kind::null) return void();
 
@@ -1357,12 +1761,16 @@ void value::set_type_if_none(json::kind kind) noexcept
   switch (kind_)
   {
     case kind::boolean: new (&data_.v_bool_) bool(false); break;
-    case kind::string: new (&data_.v_string_) string_t{}; break;
+    case kind::string: data_.v_string_ = create<string_t>(this->allocator()); break;
+    case kind::string_view:
+      data_.v_view_ = "";
+      view_size_    = 0;
+      break;
     case kind::number_int: new (&data_.v_int_) int64_t(0); break;
     case kind::number_uint: new (&data_.v_uint_) uint64_t(0); break;
     case kind::number_float: new (&data_.v_double_) number_float_t(0.0); break;
-    case kind::array: new (&data_.v_array_) array_t{}; break;
-    case kind::object: new (&data_.v_object_) object_t{}; break;
+    case kind::array: data_.v_array_ = create<array_t>(this->allocator()); break;
+    case kind::object: data_.v_object_ = create<object_t>(this->allocator()); break;
     case kind::error:
       // new (&data_.v_error_) error(other.data_.v_error_);
       break;
@@ -1371,10 +1779,20 @@ void value::set_type_if_none(json::kind kind) noexcept
   }
 }
 
-std::ostream& operator<<(std::ostream& ostream, const value& v) noexcept
+template <typename Allocator>
+std::ostream& operator<<(std::ostream& ostream, const basic_value<Allocator>& v) noexcept
 {
   detail::stringifier(ostream, v, stringify_style::standard).dump();
   return ostream;
 }
 
+template class basic_value<std::allocator<char>>;
+template std::ostream& operator<<(std::ostream&, const basic_value<std::allocator<char>>&) noexcept;
+
+#ifdef FORMATS_HAS_MEMORY_RESOURCE
+template class basic_value<std::pmr::polymorphic_allocator<char>>;
+template std::ostream& operator<<(std::ostream&,
+                                  const basic_value<std::pmr::polymorphic_allocator<char>>&) noexcept;
+#endif  // FORMATS_HAS_MEMORY_RESOURCE
+
 FORMATS_JSON_NAMESPACE_END
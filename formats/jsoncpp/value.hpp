@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 #include <formats/jsoncpp/fwd.hpp>
 
@@ -16,6 +18,10 @@
 #include <formats/jsoncpp/detail/detector.hpp>
 #include <formats/jsoncpp/error.hpp>
 
+#ifdef FORMATS_HAS_MEMORY_RESOURCE
+#include <memory_resource>
+#endif  // FORMATS_HAS_MEMORY_RESOURCE
+
 FORMATS_JSON_NAMESPACE_BEGIN
 
 /* json value type */
@@ -30,86 +36,144 @@ enum class kind : unsigned char
   string,        // string value
   array,         // array value
   object,        // ordered map
+  string_view,   // a view of a string in the text parsed in situ, see document::parse_insitu
 };
 
-class value
+namespace detail
+{
+/* the allocator of a value. an empty allocator, such as std::allocator, takes no storage */
+template <typename Allocator>
+class allocator_storage : private Allocator
 {
 public:
+  allocator_storage(const Allocator& alloc) noexcept
+      : Allocator(alloc)
+  {}
+
+  const Allocator& allocator() const noexcept { return *this; }
+};
+
+/* the hash and the equality of the keys of an object, a key is looked up by a string_view of it */
+struct key_hash
+{
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view key) const noexcept
+  {
+    return std::hash<std::string_view>()(key);
+  }
+};
+
+struct key_equal
+{
+  using is_transparent = void;
+
+  bool operator()(std::string_view left, std::string_view right) const noexcept
+  {
+    return left == right;
+  }
+};
+}  // namespace detail
+
+/*
+ * a json value whose strings, arrays and objects are allocated by Allocator, rebound to each of
+ * them. the allocator follows the rules of the allocator aware containers: a value keeps the
+ * allocator it is constructed with, copies and moves to it go through that allocator, and the
+ * elements of an array or object get the allocator of their container.
+ */
+template <typename Allocator>
+class basic_value : private detail::allocator_storage<Allocator>
+{
+  template <typename T>
+  using rebind_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+public:
+  using allocator_type = Allocator;
+
   using boolean_t      = bool;
   using number_float_t = double;
   using number_int_t   = signed long long;
   using number_uint_t  = unsigned long long;
-  using string_t       = std::string;
-  using array_t        = formats::array<value>;
-  using object_t       = formats::ordered_map<string_t, value>;
+  using string_t       = std::basic_string<char, std::char_traits<char>, rebind_alloc<char>>;
+  using array_t        = formats::array<basic_value, rebind_alloc<basic_value>>;
+  using object_t       = formats::ordered_map<string_t,
+                                        basic_value,
+                                        detail::key_hash,
+                                        detail::key_equal,
+                                        rebind_alloc<std::pair<const string_t, basic_value>>>;
   using null_t         = std::nullptr_t;
 
-  using initializer_list_t = std::initializer_list<refex_wrapper<value>>;
+  using initializer_list_t = std::initializer_list<refex_wrapper<basic_value>>;
 
   using size_type       = typename string_t::size_type;
-  using reference       = value&;
-  using const_reference = const value&;
+  using reference       = basic_value&;
+  using const_reference = const basic_value&;
 
-  using pointer       = value*;
-  using const_pointer = const value*;
+  using pointer       = basic_value*;
+  using const_pointer = const basic_value*;
 
-  using iterator       = formats::iterator<value>;
-  using const_iterator = formats::iterator<const value>;
+  using iterator       = formats::iterator<basic_value>;
+  using const_iterator = formats::iterator<const basic_value>;
 
 public:
-  value() noexcept;
-  value(const value& value) noexcept;
-  value(value&& value) noexcept;
-  value(json::kind) noexcept;
+  basic_value() noexcept;
+  explicit basic_value(const allocator_type& alloc) noexcept;
+  basic_value(const basic_value& other) noexcept;
+  basic_value(const basic_value& other, const allocator_type& alloc) noexcept;
+  basic_value(basic_value&& other) noexcept;
+  basic_value(basic_value&& other, const allocator_type& alloc) noexcept;
+  basic_value(json::kind, const allocator_type& alloc = allocator_type()) noexcept;
 
   template <typename T, typename std::enable_if<std::is_same<T, bool>::value>::type* = nullptr>
-  inline value(T val)
-      : kind_(json::kind::boolean)
+  inline basic_value(T val, const allocator_type& alloc = allocator_type())
+      : detail::allocator_storage<Allocator>(alloc)
+      , kind_(json::kind::boolean)
       , data_(val)
   {}
 
-  value(std::nullptr_t) noexcept;
-  value(float val) noexcept;
-  value(double val) noexcept;
-  value(signed char val) noexcept;
-  value(signed short val) noexcept;
-  value(signed int val) noexcept;
-  value(signed long val) noexcept;
-  value(signed long long val) noexcept;
-  value(unsigned char val) noexcept;
-  value(unsigned short val) noexcept;
-  value(unsigned int val) noexcept;
-  value(unsigned long val) noexcept;
-  value(unsigned long long val) noexcept;
-
-  value(const string_t& val) noexcept;
-  value(string_t&& val) noexcept;
+  basic_value(std::nullptr_t, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(float val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(double val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(signed char val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(signed short val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(signed int val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(signed long val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(signed long long val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(unsigned char val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(unsigned short val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(unsigned int val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(unsigned long val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(unsigned long long val, const allocator_type& alloc = allocator_type()) noexcept;
+
+  basic_value(const string_t& val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(string_t&& val, const allocator_type& alloc = allocator_type()) noexcept;
   // value(std::string_view sv) noexcept;
-  value(const char* val) noexcept;
+  basic_value(const char* val, const allocator_type& alloc = allocator_type()) noexcept;
 
-  value(const array_t& val) noexcept;
-  value(array_t&& val) noexcept;
-  value(const object_t& val) noexcept;
-  value(object_t&& val) noexcept;
-  value(initializer_list_t ilist) noexcept;
+  basic_value(const array_t& val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(array_t&& val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(const object_t& val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(object_t&& val, const allocator_type& alloc = allocator_type()) noexcept;
+  basic_value(initializer_list_t ilist, const allocator_type& alloc = allocator_type()) noexcept;
 
   /*
    * @brief: construct a json object from pair. first_type is string and json value could be
    * constructed from second_type.
    * @param: pair to construct this
    */
-  template <
-      typename Pair,
-      typename std::enable_if<formats::detail::is_pair_v<Pair> &&
-                                  std::is_same<string_t, typename Pair::first_type>::value &&
-                                  std::is_constructible<value, typename Pair::second_type>::value,
-                              int>::type = 0>
-  value(const Pair& pair) noexcept
+  template <typename Pair,
+            typename std::enable_if<
+                formats::detail::is_pair_v<Pair> &&
+                    std::is_same<string_t, typename Pair::first_type>::value &&
+                    std::is_constructible<basic_value, typename Pair::second_type>::value,
+                int>::type = 0>
+  basic_value(const Pair& pair, const allocator_type& alloc = allocator_type()) noexcept
+      : detail::allocator_storage<Allocator>(alloc)
   {
     kind_ = json::kind::object;
-    new (&data_.v_object_) object_t();
+    data_.v_object_ = create<object_t>(alloc);
 
-    data_.v_object_.emplace(pair.first, value(pair.second));
+    data_.v_object_->emplace(pair.first, basic_value(pair.second));
   }
 
   /*
@@ -117,19 +181,20 @@ public:
    * deque, set .etc.
    * @param: unmapped container to construct this.
    */
-  template <
-      typename Container,
-      typename std::enable_if<
-          formats::detail::is_unmapped_traversable_container<Container>::value &&
-          std::is_constructible<value, typename Container::value_type>::value>::type* = nullptr>
-  value(const Container& container) noexcept
+  template <typename Container,
+            typename std::enable_if<
+                formats::detail::is_unmapped_traversable_container<Container>::value &&
+                std::is_constructible<basic_value, typename Container::value_type>::value>::type* =
+                nullptr>
+  basic_value(const Container& container, const allocator_type& alloc = allocator_type()) noexcept
+      : detail::allocator_storage<Allocator>(alloc)
   {
     kind_ = json::kind::array;
-    new (&data_.v_array_) array_t();
+    data_.v_array_ = create<array_t>(alloc);
 
     for (const typename Container::value_type& element : container)
     {
-      data_.v_array_.emplace_back(element);
+      data_.v_array_->emplace_back(element);
     }
   }
 
@@ -137,19 +202,20 @@ public:
    * @brief: construct a json object from mapped container. such as std::map, unordered_map .etc.
    * @param: unmapped container to construct this.
    */
-  template <
-      typename Container,
-      typename std::enable_if<
-          formats::detail::is_mapped_container<Container>::value &&
-          std::is_constructible<string_t, typename Container::key_type>::value &&
-          std::is_constructible<value, typename Container::mapped_type>::value>::type* = nullptr>
-  value(const Container& container) noexcept
+  template <typename Container,
+            typename std::enable_if<
+                formats::detail::is_mapped_container<Container>::value &&
+                std::is_constructible<string_t, typename Container::key_type>::value &&
+                std::is_constructible<basic_value, typename Container::mapped_type>::value>::type* =
+                nullptr>
+  basic_value(const Container& container, const allocator_type& alloc = allocator_type()) noexcept
+      : detail::allocator_storage<Allocator>(alloc)
   {
     kind_ = json::kind::object;
-    new (&data_.v_object_) object_t();
+    data_.v_object_ = create<object_t>(alloc);
 
     for (const typename Container::value_type& entry : container)
-      data_.v_object_.emplace(entry.first, entry.second);
+      data_.v_object_->emplace(entry.first, entry.second);
   }
 
   /*
@@ -157,9 +223,10 @@ public:
    * @param: custom type to construct this.
    */
   template <typename T, typename std::enable_if<has_member_to_json_v<T>, int>::type = 0>
-  value(const T& t) noexcept
+  basic_value(const T& t, const allocator_type& alloc = allocator_type()) noexcept
+      : detail::allocator_storage<Allocator>(alloc)
   {
-    *this = t.to_json();
+    *this = basic_value(t.to_json(), alloc);
   }
 
   /*
@@ -167,45 +234,98 @@ public:
    * @param: custom type to construct this.
    */
   template <typename T, typename std::enable_if<has_global_to_json_v<T>, int>::type = 0>
-  value(const T& t) noexcept
+  basic_value(const T& t, const allocator_type& alloc = allocator_type()) noexcept
+      : detail::allocator_storage<Allocator>(alloc)
   {
-    *this = adl_serializer<T>::to_json(t);
+    *this = basic_value(adl_serializer<T>::to_json(t), alloc);
   }
 
-  ~value() noexcept;
+  /*
+   * @brief: copy a value of another allocator. the strings, arrays and objects of the copy are
+   * allocated by alloc.
+   * @param: value to copy.
+   */
+  template <typename OtherAllocator,
+            typename std::enable_if<!std::is_same<OtherAllocator, Allocator>::value, int>::type = 0>
+  explicit basic_value(const basic_value<OtherAllocator>& other,
+                       const allocator_type&              alloc = allocator_type())
+      : detail::allocator_storage<Allocator>(alloc)
+      , kind_(other.kind())
+  {
+    switch (kind_)
+    {
+      case json::kind::boolean: new (&data_.v_bool_) boolean_t(other.as_bool()); break;
+      case json::kind::number_int: new (&data_.v_int_) number_int_t(other.as_int64()); break;
+      case json::kind::number_uint: new (&data_.v_uint_) number_uint_t(other.as_uint64()); break;
+      case json::kind::number_float:
+        new (&data_.v_double_) number_float_t(other.as_double());
+        break;
+      case json::kind::string: {
+        const auto& str = other.as_string();
+        data_.v_string_ = create<string_t>(str.data(), str.size(), alloc);
+        break;
+      }
+      case json::kind::string_view: copy_view(other.as_string_view(), alloc); break;
+      case json::kind::array: {
+        data_.v_array_ = create<array_t>(alloc);
+
+        data_.v_array_->reserve(other.size());
+        for (const auto& element : other.as_array())
+          data_.v_array_->emplace_back(element);
+        break;
+      }
+      case json::kind::object: {
+        data_.v_object_ = create<object_t>(alloc);
+
+        for (const auto& entry : other.as_object())
+          data_.v_object_->emplace(string_t(entry.first.data(), entry.first.size(), alloc),
+                                  entry.second);
+        break;
+      }
+
+      default: break;
+    }
+  }
 
-  value& operator=(const value& val) noexcept;
-  value& operator=(value&& val) noexcept;
-  value& operator=(json::kind) noexcept;
+  ~basic_value() noexcept;
+
+  basic_value& operator=(const basic_value& val) noexcept;
+  basic_value& operator=(basic_value&& val) noexcept;
+  basic_value& operator=(json::kind) noexcept;
 
   template <typename T, typename std::enable_if<std::is_same<T, bool>::value>::type* = nullptr>
-  inline value& operator=(T val) noexcept
+  inline basic_value& operator=(T val) noexcept
   {
-    value(val).swap(*this);
+    basic_value(val, get_allocator()).swap(*this);
     return *this;
   }
 
-  value& operator=(std::nullptr_t) noexcept;
-  value& operator=(float val) noexcept;
-  value& operator=(double val) noexcept;
-  value& operator=(signed char val) noexcept;
-  value& operator=(signed short val) noexcept;
-  value& operator=(signed int val) noexcept;
-  value& operator=(signed long val) noexcept;
-  value& operator=(signed long long val) noexcept;
-  value& operator=(unsigned char val) noexcept;
-  value& operator=(unsigned short val) noexcept;
-  value& operator=(unsigned int val) noexcept;
-  value& operator=(unsigned long val) noexcept;
-  value& operator=(unsigned long long val) noexcept;
-  value& operator=(const string_t&) noexcept;
-  value& operator=(string_t&&) noexcept;
-  value& operator=(const char*) noexcept;
-  value& operator=(const array_t& val) noexcept;
-  value& operator=(array_t&& val) noexcept;
-  value& operator=(const object_t& val) noexcept;
-  value& operator=(object_t&& val) noexcept;
-  value& operator=(initializer_list_t ilist) noexcept;
+  basic_value& operator=(std::nullptr_t) noexcept;
+  basic_value& operator=(float val) noexcept;
+  basic_value& operator=(double val) noexcept;
+  basic_value& operator=(signed char val) noexcept;
+  basic_value& operator=(signed short val) noexcept;
+  basic_value& operator=(signed int val) noexcept;
+  basic_value& operator=(signed long val) noexcept;
+  basic_value& operator=(signed long long val) noexcept;
+  basic_value& operator=(unsigned char val) noexcept;
+  basic_value& operator=(unsigned short val) noexcept;
+  basic_value& operator=(unsigned int val) noexcept;
+  basic_value& operator=(unsigned long val) noexcept;
+  basic_value& operator=(unsigned long long val) noexcept;
+  basic_value& operator=(const string_t&) noexcept;
+  basic_value& operator=(string_t&&) noexcept;
+  basic_value& operator=(const char*) noexcept;
+  basic_value& operator=(const array_t& val) noexcept;
+  basic_value& operator=(array_t&& val) noexcept;
+  basic_value& operator=(const object_t& val) noexcept;
+  basic_value& operator=(object_t&& val) noexcept;
+  basic_value& operator=(initializer_list_t ilist) noexcept;
+
+  /*
+   * @brief: the allocator of this value, its strings, arrays and objects are allocated by it.
+   */
+  allocator_type get_allocator() const noexcept { return this->allocator(); }
 
 public:
   /*
@@ -240,6 +360,7 @@ public:
   bool is_object() const noexcept;
   bool is_number() const noexcept;
   bool is_error() const noexcept;
+  bool is_string_view() const noexcept;
 
   /*
    * @brief: return a reference to the underlying value if this is certain type, else throw an
@@ -261,6 +382,9 @@ public:
   const array_t&  as_array() const noexcept(false);
   const object_t& as_object() const noexcept(false);
 
+  /* @brief: the text of a string or of a string view, else throw an exception */
+  std::string_view as_string_view() const noexcept(false);
+
   /*
    * @brief: return value if convert this value to certain type success, else dflt
    */
@@ -283,7 +407,7 @@ public:
     Container res;
 
     if (is_object())
-      for (const auto& entry : data_.v_object_)
+      for (const auto& entry : *data_.v_object_)
         res.emplace_back(entry.first);
 
     return res;
@@ -297,7 +421,7 @@ public:
     Container res;
 
     if (is_object())
-      for (const auto& entry : data_.v_object_)
+      for (const auto& entry : *data_.v_object_)
         res.emplace(entry.first);
 
     return res;
@@ -316,11 +440,11 @@ public:
    * @return: return value if the element with specified key exists and could be convert to T.
    * otherwise dflt.
    */
-  string_t get(const char* key, string_t dflt) const noexcept;
+  string_t get(std::string_view key, string_t dflt) const noexcept;
   string_t get(const char* key_path, char separator, string_t dflt) const noexcept;
 
   template <typename T, typename std::enable_if<std::is_same<T, bool>::value, int>::type = 0>
-  T get(const char* key, T dflt) const noexcept
+  T get(std::string_view key, T dflt) const noexcept
   {
     auto result = if_contains(key);
     return result ? result->to_bool(std::move(dflt)) : dflt;
@@ -413,16 +537,16 @@ public:
    * @return: An iterator to the requested element. If no such element is found, past-the-end (see
    * end()) iterator is returned.
    */
-  iterator       find(const object_t::key_type& key) noexcept(false);
-  const_iterator find(const object_t::key_type& key) const noexcept(false);
+  iterator       find(std::string_view key) noexcept(false);
+  const_iterator find(std::string_view key) const noexcept(false);
 
   iterator       find(const char* path, char path_separator) noexcept(false);
   const_iterator find(const char* path, char path_separator) const noexcept(false);
 
-  bool          contains(const object_t::key_type& key) const noexcept;
-  pointer       if_contains(const object_t::key_type& key) noexcept;
+  bool          contains(std::string_view key) const noexcept;
+  pointer       if_contains(std::string_view key) noexcept;
   pointer       if_contains(const string_t& key_path, char separator) noexcept;
-  const_pointer if_contains(const object_t::key_type& key) const noexcept;
+  const_pointer if_contains(std::string_view key) const noexcept;
   const_pointer if_contains(const string_t& key_path, char separator) const noexcept;
 
   /*
@@ -434,8 +558,8 @@ public:
    *
    * @return: A reference to the object value of the requested element.
    */
-  reference       at(const object_t::key_type& key) noexcept(false);
-  const_reference at(const object_t::key_type& key) const noexcept(false);
+  reference       at(std::string_view key) noexcept(false);
+  const_reference at(std::string_view key) const noexcept(false);
 
   /*
    * @brief: Call when value is object. Returns a reference to the the element with specified key.
@@ -449,25 +573,25 @@ public:
    * element with key key existed. Otherwise, a reference to the object value of the existing
    * element whose key is equivalent to key.
    */
-  reference       operator[](const object_t::key_type& key) noexcept(false);
-  reference       operator[](object_t::key_type&& key) noexcept(false);
-  const_reference operator[](const object_t::key_type& key) const noexcept(false);
-  const_reference operator[](object_t::key_type&& key) const noexcept(false);
+  reference       operator[](std::string_view key) noexcept(false);
+  reference       operator[](typename object_t::key_type&& key) noexcept(false);
+  const_reference operator[](std::string_view key) const noexcept(false);
+  const_reference operator[](typename object_t::key_type&& key) const noexcept(false);
 
-  template <
-      typename T,
-      typename std::enable_if<std::is_constructible<object_t::key_type, T>::value, int>::type = 0>
+  template <typename T,
+            typename std::enable_if<std::is_convertible<const T&, std::string_view>::value,
+                                    int>::type = 0>
   reference operator[](const T& key) noexcept(false)
   {
-    return this->operator[](object_t::key_type(key));
+    return this->operator[](std::string_view(key));
   }
 
-  template <
-      typename T,
-      typename std::enable_if<std::is_constructible<object_t::key_type, T>::value, int>::type = 0>
+  template <typename T,
+            typename std::enable_if<std::is_convertible<const T&, std::string_view>::value,
+                                    int>::type = 0>
   const_reference operator[](const T& key) const noexcept(false)
   {
-    return this->at(object_t::key_type(key));
+    return this->at(std::string_view(key));
   }
 
   /*
@@ -504,8 +628,8 @@ public:
     return at((size_type)pos);
   }
 
-  bool operator==(const value& other) const noexcept;
-  bool operator!=(const value& other) const noexcept;
+  bool operator==(const basic_value& other) const noexcept;
+  bool operator!=(const basic_value& other) const noexcept;
 
 public:  // Modifier
   /*
@@ -542,7 +666,7 @@ public:  // Modifier
    * @param: none.
    * @return: none.
    */
-  void swap(value& other) noexcept;
+  void swap(basic_value& other) noexcept;
 
   // json-object modifier
   /*
@@ -562,7 +686,7 @@ public:  // Modifier
     set_type_if_none(json::kind::object);
     if (is_object())
     {
-      auto ret = data_.v_object_.emplace(std::forward<Args&&>(args)...);
+      auto ret = data_.v_object_->emplace(std::forward<Args&&>(args)...);
       return std::pair<iterator, bool>{iterator(this, ret.first), ret.second};
     }
 
@@ -577,8 +701,8 @@ public:  // Modifier
    *
    * @return: none
    */
-  void erase(const object_t::key_type& key) noexcept;
-  void erase(object_t::key_type&& key) noexcept;
+  void erase(const typename object_t::key_type& key) noexcept;
+  void erase(typename object_t::key_type&& key) noexcept;
 
   /*
    * @brief: Attempts to extract ("splice") each element in other and insert it into this.
@@ -591,8 +715,8 @@ public:  // Modifier
    *
    * @return: none
    */
-  void merge(value& other) noexcept(false);
-  void merge(value&& other) noexcept(false);
+  void merge(basic_value& other) noexcept(false);
+  void merge(basic_value&& other) noexcept(false);
 
   // json-array modifier
   /*
@@ -633,8 +757,8 @@ public:  // Modifier
    *
    * @return: none.
    */
-  void push_back(const value& other) noexcept(false);
-  void push_back(value&& other) noexcept(false);
+  void push_back(const basic_value& other) noexcept(false);
+  void push_back(basic_value&& other) noexcept(false);
 
   /*
    * @brief:Inserts elements at the specified location in this.
@@ -655,9 +779,9 @@ public:  // Modifier
    *   4) Iterator pointing to the first element inserted, or pos if first == last.
    *   5) Iterator pointing to the first element inserted, or pos if ilist is empty.
    */
-  iterator insert(const_iterator pos, const value& val) noexcept(false);
-  iterator insert(const_iterator pos, value&& val) noexcept(false);
-  iterator insert(const_iterator pos, size_type cnt, const value& val) noexcept(false);
+  iterator insert(const_iterator pos, const basic_value& val) noexcept(false);
+  iterator insert(const_iterator pos, basic_value&& val) noexcept(false);
+  iterator insert(const_iterator pos, size_type cnt, const basic_value& val) noexcept(false);
   iterator insert(const_iterator pos, const_iterator first, const_iterator last) noexcept(false);
   iterator insert(const_iterator pos, initializer_list_t ilist) noexcept(false);
 
@@ -675,7 +799,7 @@ public:  // Modifier
   {
     set_type_if_none(json::kind::array);
 
-    if (is_array()) { return data_.v_array_.emplace_back(std::forward<Args&&>(args)...); }
+    if (is_array()) { return data_.v_array_->emplace_back(std::forward<Args&&>(args)...); }
 
     FORMATS_THROW(type_except::create("can't use emplace_back with type", type_name()));
   }
@@ -708,10 +832,12 @@ public:
    *
    * @return: stream.
    */
-  friend std::ostream& operator<<(std::ostream& os, const value&) noexcept;
+  template <typename Alloc>
+  friend std::ostream& operator<<(std::ostream& os, const basic_value<Alloc>&) noexcept;
 
 private:
   void destory() noexcept;
+  void release_containers() noexcept;
   void set_type_if_none(json::kind) noexcept;
 
   template <typename... Args>
@@ -723,10 +849,10 @@ private:
     if (is_array())
     {
       auto insert_pos = pos.array_iter();
-      auto insert_ret = data_.v_array_.insert(insert_pos, std::forward<Args&&>(args)...);
+      auto insert_ret = data_.v_array_->insert(insert_pos, std::forward<Args&&>(args)...);
 
-      return insert_ret != data_.v_array_.end()
-                 ? iterator(this, std::distance(data_.v_array_.begin(), insert_ret))
+      return insert_ret != data_.v_array_->end()
+                 ? iterator(this, std::distance(data_.v_array_->begin(), insert_ret))
                  : end();
     }
 
@@ -734,14 +860,56 @@ private:
   }
 
 private:
-  string_t type_name() const noexcept;
+  std::string type_name() const noexcept;
+
+  /* @brief: allocate and construct a string, array or object with the allocator of the value */
+  template <typename T, typename... Args>
+  T* create(Args&&... args)
+  {
+    rebind_alloc<T> alloc(this->allocator());
+    T*              p = std::allocator_traits<rebind_alloc<T>>::allocate(alloc, 1);
+    return new (p) T(std::forward<Args>(args)...);
+  }
+
+  /*
+   * @brief: own a copy of the characters of a string_view, as a string. a copy of a value outlives
+   * the text its view is in, such as the one of a document.
+   */
+  void copy_view(std::string_view view, const allocator_type& alloc)
+  {
+    kind_           = json::kind::string;
+    data_.v_string_ = create<string_t>(view.data(), view.size(), alloc);
+  }
+
+  std::string_view view() const noexcept { return std::string_view(data_.v_view_, view_size_); }
+
+  /* @brief: destroy and deallocate what create() returned */
+  template <typename T>
+  void release(T* p) noexcept
+  {
+    rebind_alloc<T> alloc(this->allocator());
+    p->~T();
+    std::allocator_traits<rebind_alloc<T>>::deallocate(alloc, p, 1);
+  }
 
 private:
   json::kind kind_ = json::kind::null;
 
+  // the size of a string_view, whose characters are data_.v_view_. it is in the padding after
+  // kind_, so that a view allocates nothing and the value stays no larger than a kind and a pointer
+  std::uint32_t view_size_ = 0;
+
 protected:
+  /*
+   * the scalars are stored in place, the strings, arrays and objects behind a pointer, so that a
+   * value is no larger than a kind and a pointer. the containers are allocated by the allocator of
+   * the value, rebound to them. a string_view points to characters it does not own.
+   */
   union json_data {
-    json_data(){};
+    // zero for the kinds with no data, null and error, which are still copied by swap
+    json_data()
+        : v_uint_(0)
+    {}
 
     json_data(boolean_t val)
         : v_bool_(val)
@@ -755,20 +923,15 @@ protected:
     json_data(number_float_t val)
         : v_double_(val)
     {}
-    json_data(string_t val)
-        : v_string_(val)
-    {}
-
-    ~json_data(){};
 
     boolean_t      v_bool_;
     number_int_t   v_int_;
     number_uint_t  v_uint_;
     number_float_t v_double_;
-    string_t       v_string_;
-    array_t        v_array_;
-    object_t       v_object_;
-    error          v_error_;
+    string_t*         v_string_;
+    array_t*          v_array_;
+    object_t*         v_object_;
+    const char*       v_view_;
   } data_;
 
 private:
@@ -777,4 +940,15 @@ private:
 
 using array_t = value::array_t;
 
+// a kind and a pointer or a scalar, an empty allocator takes no storage
+static_assert(sizeof(value) == 16, "json::value is expected to be 16 bytes");
+
+#ifdef FORMATS_HAS_MEMORY_RESOURCE
+namespace pmr
+{
+/* a json value on a std::pmr::memory_resource */
+using value = basic_value<std::pmr::polymorphic_allocator<char>>;
+}  // namespace pmr
+#endif  // FORMATS_HAS_MEMORY_RESOURCE
+
 FORMATS_JSON_NAMESPACE_END
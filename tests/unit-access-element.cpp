@@ -76,6 +76,15 @@ TEST(JsonValueAccessObjectoperator)
     CHECK(jv["NotExisted"].is_null());
   }
 
+  {
+    // a member copied to a new one, as the object grows
+    json::value jv =
+        json::parse(R"({"a":"a string long enough to be allocated","b":2,"c":3,"d":4})");
+    jv["copy"] = jv["a"];
+    CHECK(jv["copy"] == jv["a"]);
+    CHECK_EQ(jv["copy"].to_string().c_str(), "a string long enough to be allocated");
+  }
+
   {
     json::value const jv(*legend_obj);
 
@@ -182,6 +191,32 @@ TEST(JsonValueAccessObjectIfContains)
   }
 }
 
+TEST(JsonValueAccessObjectStringView)
+{
+  // more keys than ordered_map::index_threshold, so that they are found by the index
+  json::value jv(json::kind::object);
+  for (int i = 0; i < 32; ++i) jv["key number " + std::to_string(i)] = i;
+
+  std::string_view key = "key number 17";
+  const auto&      cjv = jv;
+
+  CHECK(jv.contains(key));
+  CHECK(*jv.find(key) == 17);
+  CHECK(cjv.find(key) != cjv.end());
+  CHECK(jv.if_contains(key)->as_int64() == 17);
+  CHECK(jv.at(key) == 17 && cjv.at(key) == 17);
+  CHECK(jv[key] == 17 && cjv[key] == 17);
+  CHECK(cjv.get(key, 0) == 17);
+  CHECK(cjv.get(key.substr(0, 5), -1) == -1);
+  CHECK(cjv.get(key, std::string()) == "17" && cjv.get(key, false));
+  CHECK(!jv.contains(key.substr(0, 5)));
+
+  // a missing key is inserted from the string_view
+  jv[key.substr(4)] = "inserted";
+  CHECK(jv.size() == 33);
+  CHECK(jv["number 17"] == "inserted");
+}
+
 TEST(JsonValueAccessArrayElement)
 {
   auto legend_obj1 = legend(0);
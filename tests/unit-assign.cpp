@@ -5,6 +5,7 @@
 #include <set>
 #include <unordered_set>
 #include <forward_list>
+#include <list>
 // #include <string_view>
 #include <map>
 #include <iostream>
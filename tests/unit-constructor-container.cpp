@@ -5,8 +5,10 @@
 #include <set>
 #include <unordered_set>
 #include <forward_list>
+#include <list>
 // #include <string_view>
 #include <map>
+#include <unordered_map>
 #include <iostream>
 
 #include "json_test.h"
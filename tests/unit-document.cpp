@@ -0,0 +1,291 @@
+#include <sstream>
+
+#include "json_test.h"
+
+using namespace formats;
+
+#ifdef FORMATS_HAS_MEMORY_RESOURCE
+
+namespace
+{
+/* counts the blocks the arena takes from it */
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+  size_t allocated   = 0;
+  size_t deallocated = 0;
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override
+  {
+    ++allocated;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override
+  {
+    ++deallocated;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+/* an array of count objects, with a string long enough to be allocated in each */
+std::string many_objects(size_t count)
+{
+  std::string text = "[";
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (i) text += ",";
+    text += "{\"id\": " + std::to_string(i) + ", \"name\": \"a name too long for the sso " +
+            std::to_string(i) + "\", \"tags\": [1, 2.5, true, null]}";
+  }
+
+  return text + "]";
+}
+}  // namespace
+
+TEST(JsonDocumentParse)
+{
+  json::document doc;
+  CHECK(doc.root().is_null());
+
+  CHECK(doc.parse("{\"a\": [1, -2, 3.5, \"text\"], \"b\": {\"c\": true, \"d\": null}}"));
+  CHECK(doc.root()["a"].size() == 4);
+  CHECK(doc.root()["a"][1].as_int64() == -2);
+  CHECK(doc.root()["a"][3].as_string() == "text");
+  CHECK(doc.root()["b"]["c"].as_bool());
+  CHECK(doc.root()["b"]["d"].is_null());
+  CHECK(doc.root().dump() == json::parse(doc.root().dump().c_str()).dump().c_str());
+
+  // the values of the document are on its arena, down to the keys and the strings
+  const auto& object = doc.root()["b"].as_object();
+  CHECK(doc.root().get_allocator().resource() == doc.resource());
+  CHECK(doc.root()["a"].get_allocator().resource() == doc.resource());
+  CHECK(doc.root()["a"][3].as_string().get_allocator().resource() == doc.resource());
+  CHECK(object.begin()->first.get_allocator().resource() == doc.resource());
+
+  // a malformed text, the root is the error
+  CHECK(!doc.parse("{\"a\": [1, 2}"));
+  CHECK(doc.root().is_error());
+  CHECK(doc.error().code() == json::error_code::missing_end_array);
+
+  // a parse clears the error of the previous one
+  CHECK(doc.parse(std::string("[\"x\"]")));
+  CHECK(doc.error().code() == json::error_code::none);
+  CHECK(doc.root()[0] == "x");
+
+  std::istringstream is("{\"stream\": [true]}");
+  CHECK(doc.parse(is, json::parse_flag::strict));
+  CHECK(doc.root()["stream"][0] == true);
+
+  // the json5 grammar
+  CHECK(doc.parse("{unquoted: 'single', trailing: [1, 2,],}", json::parse_flag::JSON5));
+  CHECK(doc.root()["unquoted"] == "single");
+  CHECK(doc.root()["trailing"].size() == 2);
+
+  doc.clear();
+  CHECK(doc.root().is_null());
+}
+
+TEST(JsonDocumentArena)
+{
+  counting_resource upstream;
+
+  {
+    json::document doc(1024, &upstream);
+
+    // the whole value comes from a few blocks of growing size, the empty root takes none
+    auto text   = many_objects(2000);
+    auto blocks = upstream.allocated;
+    CHECK(blocks == 0);
+    CHECK(doc.parse(text));
+    CHECK(doc.root().size() == 2000);
+    CHECK(doc.root()[1999]["id"] == 1999);
+    CHECK(doc.root()[1999]["tags"][1] == 2.5);
+    CHECK(upstream.allocated - blocks < 64);
+    CHECK(upstream.deallocated == blocks);
+
+    // a new parse releases all the blocks of the previous one at once
+    blocks = upstream.allocated;
+    CHECK(doc.parse("[1, 2, 3]"));
+    CHECK(upstream.deallocated == blocks);
+    CHECK(doc.root().size() == 3);
+
+    // a value copied out of the document goes to its own allocator, the default resource when
+    // none is given
+    json::pmr::value copy(doc.root(), std::pmr::new_delete_resource());
+    CHECK(copy.get_allocator().resource() == std::pmr::new_delete_resource());
+    CHECK(copy == doc.root());
+
+    json::pmr::value default_copy = doc.root();
+    CHECK(default_copy.get_allocator().resource() == std::pmr::get_default_resource());
+
+    json::pmr::value arena_copy(doc.root(), doc.resource());
+    CHECK(arena_copy.get_allocator().resource() == doc.resource());
+
+    // a copy of an element inside the document stays on the arena
+    doc.root().push_back(doc.root()[0]);
+    CHECK(doc.root().size() == 4 && doc.root()[3] == 1);
+    doc.root()[3] = "a string long enough to be allocated on the arena";
+    CHECK(doc.root()[3].as_string().get_allocator().resource() == doc.resource());
+  }
+
+  // all the blocks are released with the document
+  CHECK(upstream.allocated == upstream.deallocated);
+}
+
+TEST(JsonPmrValue)
+{
+  std::pmr::monotonic_buffer_resource arena;
+
+  json::pmr::value v(json::kind::object, &arena);
+  v["key"]  = "a value long enough to be allocated on the arena";
+  v["list"] = json::pmr::value({1, 2, 3}, &arena);
+  v["list"].push_back("one more string long enough to be allocated");
+
+  CHECK(v["key"].as_string().get_allocator().resource() == &arena);
+  CHECK(v["list"][3].as_string().get_allocator().resource() == &arena);
+  CHECK(v.dump() == json::pmr::value::string_t(
+                        "{\n    \"key\": \"a value long enough to be allocated on the arena\",\n"
+                        "    \"list\": [\n        1,\n        2,\n        3,\n"
+                        "        \"one more string long enough to be allocated\"\n    ]\n}"));
+
+  // a value moved to another resource is copied, the source is left null
+  json::pmr::value other(std::move(v), std::pmr::new_delete_resource());
+  CHECK(other.get_allocator().resource() == std::pmr::new_delete_resource());
+  CHECK(other["key"].as_string().get_allocator().resource() == std::pmr::new_delete_resource());
+  CHECK(other["list"].size() == 4);
+
+  // swap with different resources exchanges the contents, each value keeps its resource
+  json::pmr::value small("small", &arena);
+  small.swap(other);
+  CHECK(small.is_object() && small.get_allocator().resource() == &arena);
+  CHECK(small["list"].size() == 4);
+  CHECK(other == "small");
+  CHECK(other.get_allocator().resource() == std::pmr::new_delete_resource());
+
+  // a parse keeps the allocator of the value
+  json::pmr::value parsed(&arena);
+  CHECK(json::parse(parsed, "{\"list\": [\"a string long enough to be allocated\", 2]}"));
+  CHECK(parsed.get_allocator().resource() == &arena);
+  CHECK(parsed["list"][0].as_string().get_allocator().resource() == &arena);
+  CHECK(!json::parse(parsed, "[1, 2"));
+  CHECK(parsed.is_error() && parsed.get_allocator().resource() == &arena);
+
+  std::istringstream is("[true, {\"k\": \"v\"}]");
+  CHECK(json::parse(parsed, is));
+  CHECK(parsed[1]["k"] == "v");
+}
+
+TEST(JsonPmrKeyLookup)
+{
+  std::pmr::monotonic_buffer_resource arena;
+
+  json::pmr::value v(json::kind::object, &arena);
+  v["a key too long for the short string buffer"] = 1;
+  for (int i = 0; i < 32; ++i) v["another key too long for the sso " + std::to_string(i)] = i;
+
+  // a lookup by a literal or a string_view allocates no key, from no resource
+  counting_resource counting;
+  auto*             previous = std::pmr::set_default_resource(&counting);
+
+  const auto& cv = v;
+  CHECK(v["a key too long for the short string buffer"] == 1);
+  CHECK(cv["another key too long for the sso 31"] == 31);
+  CHECK(v.at("another key too long for the sso 7") == 7);
+  CHECK(v.contains(std::string_view("another key too long for the sso 20")));
+  CHECK(!v.if_contains("a key too long for the short string buffer, and missing"));
+  CHECK(cv.get("another key too long for the sso 3", 0) == 3);
+
+  std::pmr::set_default_resource(previous);
+  CHECK(counting.allocated == 0);
+}
+
+TEST(JsonDocumentMaxDepth)
+{
+  std::string deep(1000000, '[');
+  deep += "1";
+  deep.append(1000000, ']');
+
+  json::document doc;
+  CHECK(doc.max_depth() == JSON_MAX_DEPTH);
+  CHECK(!doc.parse(deep));
+  CHECK(doc.error().code() == json::error_code::too_deep);
+
+  // the containers are not nested on the call stack, nor destroyed one by one
+  doc.max_depth(deep.size());
+  CHECK(doc.parse(deep));
+
+  const json::pmr::value* inner = &doc.root();
+  while (inner->is_array()) inner = &(*inner)[0];
+  CHECK(*inner == 1);
+
+  doc.max_depth(2);
+  CHECK(doc.parse("[[1]]"));
+  CHECK(!doc.parse("[[[1]]]"));
+  CHECK(doc.error().code() == json::error_code::too_deep);
+}
+
+TEST(JsonDocumentInsitu)
+{
+  std::string text = R"({"name": "a name too long for the sso", "tags": ["x", "a\nb", "\u0041\x41z"],
+                        "id": 7})";
+
+  json::document doc;
+  CHECK(doc.parse_insitu(&text[0], text.size(), json::parse_flag::escaped_hex));
+
+  // the strings are views of the text, the escapes kept raw are in place
+  const auto& name = doc.root()["name"];
+  CHECK(name.is_string_view());
+  CHECK(name.as_string_view() == "a name too long for the sso");
+  CHECK(name.as_string_view().data() >= text.data());
+  CHECK(name.as_string_view().data() < text.data() + text.size());
+  CHECK(doc.root()["tags"][1].as_string_view() == "a\\nb");
+  CHECK(doc.root()["id"] == 7);
+
+  // an escape which changes the string is unescaped into the text
+  const auto unescaped = doc.root()["tags"][2].as_string_view();
+  CHECK(unescaped == "A65z");
+  CHECK(unescaped.data() >= text.data() && unescaped.data() < text.data() + text.size());
+
+  // a view equals a string of the same text. a copy owns its strings, even on the arena
+  CHECK(doc.root()["tags"][0] == json::pmr::value("x", doc.resource()));
+  json::value copy(doc.root());
+  CHECK(copy["tags"][0].is_string() && copy["tags"][2].as_string_view() == unescaped);
+  CHECK(copy["tags"][2].as_string_view().data() != unescaped.data());
+  CHECK(copy["name"].to_string() == "a name too long for the sso");
+  CHECK(json::stringify(copy["tags"]).find("A65z") != std::string::npos);
+
+  {
+    json::pmr::value arena_copy(doc.root()["tags"], doc.resource());
+    CHECK(arena_copy[1].is_string() && arena_copy == doc.root()["tags"]);
+    arena_copy = doc.root()["name"];
+    CHECK(arena_copy.is_string() && arena_copy == name);
+
+    // a move with the same allocator keeps the view
+    json::pmr::value moved(std::move(doc.root()["tags"][1]));
+    CHECK(moved.is_string_view() && moved.as_string_view() == "a\\nb");
+  }
+
+  // a copy outlives the document and the text it was given
+  json::value kept;
+  {
+    json::document scoped;
+    CHECK(scoped.parse_insitu(std::string(R"({"name": "a name too long for the sso"})")));
+    kept = json::value(scoped.root());
+  }
+  CHECK(kept["name"].as_string() == "a name too long for the sso");
+
+  // the document keeps a text given to it
+  CHECK(doc.parse_insitu(std::string("[\"short\"]")));
+  CHECK(doc.root()[0].as_string_view() == "short");
+  CHECK(!doc.parse_insitu(std::string("[\"open]")));
+  CHECK(doc.root().is_error() && *doc.error().what());
+}
+
+#endif  // FORMATS_HAS_MEMORY_RESOURCE
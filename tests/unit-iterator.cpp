@@ -199,3 +199,23 @@ TEST(JsonValueIteratorDec)
     CHECK(iter2 == jv.begin());
   }
 }
+
+TEST(JsonValueIteratorConvert)
+{
+  json::value jv({{"Name", "Alice"}, {"Score", 96}});
+
+  // an iterator is a plain value, its copies and conversions keep the position
+  json::value::iterator       iter = ++jv.begin();
+  json::value::const_iterator c_iter(iter);
+  json::value::iterator       copy(c_iter);
+
+  CHECK(c_iter == iter);
+  CHECK(copy == iter);
+  CHECK(copy.key() == "Score");
+  CHECK(&*copy == &jv["Score"]);
+  CHECK(++copy == jv.end());
+
+  json::value::iterator none;
+  CHECK(none == json::value::iterator());
+  CHECK(none != iter);
+}
@@ -409,3 +409,32 @@ TEST(JsonValueSwap)
     CHECK(jv2 == "i love coffee");
   }
 }
+
+TEST(JsonValueMoveStorage)
+{
+  CHECK(sizeof(json::value) == 16);
+
+  // a move takes over the storage of the container, the source is left null
+  json::value jv1     = {1, "two", {{"three", 3}}};
+  const auto* storage = &jv1.as_array();
+
+  json::value jv2(std::move(jv1));
+  CHECK(jv1.is_null());
+  CHECK(&jv2.as_array() == storage);
+
+  json::value jv3 = "a string";
+  jv3             = std::move(jv2);
+  CHECK(jv2.is_null());
+  CHECK(&jv3.as_array() == storage);
+
+  jv1 = {{"key", "value"}};
+  jv1.swap(jv3);
+  CHECK(&jv1.as_array() == storage);
+  CHECK(jv3 == json::value({{"key", "value"}}));
+
+  // an element moved to its own container
+  jv1 = std::move(jv1[2]);
+  CHECK(jv1 == json::value({{"three", 3}}));
+  jv1 = std::move(jv1["three"]);
+  CHECK(jv1 == 3);
+}
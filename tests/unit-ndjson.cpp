@@ -0,0 +1,128 @@
+#include <sstream>
+
+#include "json_test.h"
+
+using namespace formats;
+
+namespace
+{
+/* the records of many batches, an id per line and a blank line every 100 */
+std::string many_records(size_t count)
+{
+  std::string text;
+  for (size_t i = 0; i < count; ++i)
+  {
+    text += "{\"id\": " + std::to_string(i) + ", \"name\": \"record " + std::to_string(i) + "\"}\n";
+    if (i % 100 == 99) text += "  \r\n";
+  }
+
+  return text;
+}
+}  // namespace
+
+TEST(JsonNdjsonReader)
+{
+  // the roots may be scalars, the last line needs no line feed
+  {
+    json::ndjson_reader reader(json::parse_flag::strict, 1);
+
+    std::vector<json::ndjson_reader::record> records;
+    CHECK(reader.read(std::string("{\"a\": 1}\r\n[1, 2]\n\n\"text\"\n-12.5\ntrue\n7"), records));
+    CHECK(records.size() == 6);
+    CHECK(records[0].value["a"] == 1);
+    CHECK(records[1].value.size() == 2);
+    CHECK(records[2].line == 4 && records[2].value == "text");
+    CHECK(records[3].value == -12.5);
+    CHECK(records[4].value == true);
+    CHECK(records[5].line == 7 && records[5].value == 7);
+  }
+
+  // a malformed record is delivered with its error, the next ones are read
+  {
+    json::ndjson_reader reader(json::parse_flag::strict, 1);
+
+    std::vector<json::ndjson_reader::record> records;
+    CHECK(!reader.read(std::string("{\"a\": 1}\n{\"a\": }\n{\"a\": \"b\nc\"}\n[3]\n"), records));
+    CHECK(records.size() == 5);
+    CHECK(!records[0].value.is_error());
+    CHECK(records[1].value.is_error() && records[1].error.code() != json::error_code::none);
+    CHECK(records[2].value.is_error() && records[3].value.is_error());
+    CHECK(records[4].line == 5 && records[4].value[0] == 3);
+
+    // the errors of a record are its own, lines are counted from its first one
+    CHECK(!reader.read(std::string("{\"a\" 1}\n[1]\n[\n}\n"), records));
+    CHECK(records.size() == 9);
+    CHECK(records[6].value.is_array());
+    CHECK(records[7].error.code() == json::error_code::missing_end_array);
+    CHECK(strstr(records[8].error.what(), "Line[1]"));
+  }
+
+  // a line holds one value, anything but white space and comments after it is an error
+  {
+    json::ndjson_reader reader(json::parse_flag::strict, 1);
+
+    std::vector<json::ndjson_reader::record> records;
+    CHECK(!reader.read(std::string("{\"a\":1} {\"b\":2}\n[1] \t\n2 3\n\"x\"y\n12"), records));
+    CHECK(records.size() == 5);
+    CHECK(records[0].value.is_error());
+    CHECK(records[0].error.code() == json::error_code::illeagl_character);
+    CHECK(records[1].value[0] == 1);
+    CHECK(records[2].value.is_error() && records[3].value.is_error());
+    CHECK(records[4].value == 12);
+
+    json::ndjson_reader json5(json::parse_flag::JSON5, 1);
+    CHECK(json5.read(std::string("[1] // one\n[2] /* two */\n"), records));
+    CHECK(records.size() == 7 && records[6].value[0] == 2);
+
+    // a number ends the input, no byte follows it
+    std::vector<char> text = {'[', '1', ']', '\n', '-', '1', '2', '.', '5'};
+    records.clear();
+    CHECK(reader.read(text.data(), text.data() + text.size(), records));
+    CHECK(records.size() == 2 && records[1].value == -12.5);
+  }
+
+  // a record spans lines when strings may hold line breaks or comments are permitted
+  {
+    json::ndjson_reader reader(json::parse_flag::JSON5, 1);
+
+    std::vector<json::ndjson_reader::record> records;
+    CHECK(reader.read(std::string("{a: 'x\\\ny', b: \"}\\n{\"}\n/* one\ntwo */ [1]\n{c: 2}\n"),
+                      records));
+    CHECK(records.size() == 3);
+    CHECK(records[0].value["b"] == "}\\n{");
+    CHECK(records[1].line == 3 && records[1].value[0] == 1);
+    CHECK(records[2].line == 5 && records[2].value["c"] == 2);
+  }
+
+  // the order of the input is kept across the batches of the threads
+  std::string text = many_records(60000);
+  CHECK(text.size() > 4 * json::ndjson_reader::batch_bytes);
+
+  for (size_t threads : {1, 4})
+  {
+    json::ndjson_reader reader(json::parse_flag::strict, threads);
+    CHECK(reader.threads() == threads);
+
+    size_t count = 0;
+    CHECK(reader.read(text, [&count](json::ndjson_reader::record& rec) {
+      CHECK(rec.value["id"] == (long long)count);
+      CHECK(rec.line == count + 1 + count / 100);
+      return ++count, true;
+    }));
+    CHECK(count == 60000);
+
+    // a stream is read by blocks, a record may be cut by the end of a block
+    std::istringstream is(text);
+    count = 0;
+    CHECK(reader.read(is, [&count](json::ndjson_reader::record& rec) {
+      CHECK(rec.value["id"] == (long long)count);
+      return ++count, true;
+    }));
+    CHECK(count == 60000);
+
+    // the reading stops when the callback returns false
+    count = 0;
+    CHECK(reader.read(text, [&count](json::ndjson_reader::record&) { return ++count < 10; }));
+    CHECK(count == 10);
+  }
+}
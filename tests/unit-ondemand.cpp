@@ -0,0 +1,96 @@
+#include "json_test.h"
+
+using namespace formats;
+
+TEST(JsonOnDemand)
+{
+  {
+    std::string s = "{\"list\": [{\"id\": 7}, [1, [2]]], \"user\": {\"name\": \"jo\", \"id\": 42, "
+                    "\"tags\": [\"a\", \"b\"], \"score\": -1.5, \"admin\": false, \"none\": null}}";
+
+    json::ondemand::document doc(s);
+    CHECK(doc["user"]["id"].get_int64() == 42);
+    CHECK(doc["user"]["id"].get_uint64() == 42);
+    CHECK(doc["user"]["name"].get_string() == "jo");
+    CHECK(doc["user"]["tags"][1].get_string() == "b");
+    CHECK(doc["user"]["score"].get_double() == -1.5);
+    CHECK(doc["user"]["admin"].get_bool() == false);
+    CHECK(doc["user"]["none"].is_null());
+    CHECK(doc["list"][0]["id"].get_int64() == 7);
+    CHECK(doc["list"][1][1][0].get_int64() == 2);
+
+    CHECK(doc.root().size() == 2);
+    CHECK(doc["user"].size() == 6);
+    CHECK(doc["list"].size() == 2);
+    CHECK(doc["user"]["tags"].size() == 2);
+
+    CHECK(doc["user"].kind() == json::kind::object);
+    CHECK(doc["user"]["score"].kind() == json::kind::number_float);
+    CHECK(doc["user"]["id"].kind() == json::kind::number_uint);
+
+    // missing keys and indexes, chained lookups stay safe
+    CHECK(doc["nobody"].is_error());
+    CHECK(doc["nobody"]["id"].is_error());
+    CHECK(doc["list"][5].is_error());
+    CHECK(doc["user"]["name"]["id"].is_error());
+    CHECK(doc[0].is_error());
+
+    json::value user = doc["user"].get_value();
+    CHECK(user.is_object());
+    CHECK(user["tags"].size() == 2);
+
+    bool thrown = false;
+    try
+    {
+      doc["user"]["name"].get_int64();
+    }
+    catch (const type_except&)
+    {
+      thrown = true;
+    }
+    CHECK(thrown);
+  }
+
+  {
+    // keys with escapes are compared decoded
+    std::string s = "[{\"a\\u0062\": 1, \"q\\\"\": 2, \"\": 3}]";
+
+    json::ondemand::document doc(s);
+    CHECK(doc[0]["ab"].get_int64() == 1);
+    CHECK(doc[0]["q\\\""].get_int64() == 2);
+    CHECK(doc[0][""].get_int64() == 3);
+    CHECK(doc[0]["q"].is_error());
+  }
+
+  {
+    // the visited values are validated, the skipped ones are not
+    std::string s = "{\"bad\": 12x, \"good\": 1}";
+
+    json::ondemand::document doc(s);
+    CHECK(doc["good"].get_int64() == 1);
+    CHECK(doc["bad"].kind() == json::kind::error);
+    CHECK(doc.last_error().code() == json::error_code::illeagl_character);
+
+    bool thrown = false;
+    try
+    {
+      doc["bad"].get_int64();
+    }
+    catch (const type_except&)
+    {
+      thrown = true;
+    }
+    CHECK(thrown);
+  }
+
+  {
+    const char* illegal[] = {"", "1", "  \"str\"", "{\"a\" 1}", "{\"b\": 1", "{\"b\": [}"};
+
+    for (auto text : illegal)
+    {
+      json::ondemand::document doc(text, strlen(text));
+      CHECK(doc["a"].is_error());
+      CHECK(doc.last_error().code() != json::error_code::none);
+    }
+  }
+}
@@ -0,0 +1,89 @@
+#include <string>
+
+#include "json_test.h"
+
+using namespace formats;
+
+namespace
+{
+using map_t = ordered_map<std::string, int>;
+
+bool in_order(const map_t& map, int first, int last)
+{
+  if (map.size() != size_t(last - first)) return false;
+
+  for (const auto& entry : map)
+    if (entry.first != "key" + std::to_string(first) || entry.second != first++) return false;
+
+  return true;
+}
+}  // namespace
+
+TEST(OrderedMapSmall)
+{
+  map_t map;
+  CHECK(map.emplace("b", 2).second);
+  CHECK(map.emplace("a", 1).second);
+  CHECK(!map.emplace("b", 3).second);
+  CHECK(map["b"] == 2);
+  CHECK(map.begin()->first == "b");
+
+  // an entry before another one
+  auto iter = map.insert(map.begin() + 1, {"c", 3});
+  CHECK(iter->first == "c" && iter == map.begin() + 1);
+  CHECK(map.rbegin()->first == "a");
+
+  CHECK(map.erase("c") == 1);
+  CHECK(map.erase("c") == 0);
+  CHECK(map == map_t({{"b", 2}, {"a", 1}}));
+  CHECK(!map.contains("c"));
+}
+
+TEST(OrderedMapIndexed)
+{
+  // past index_threshold, the keys are found by the index
+  map_t map;
+  for (int i = 0; i < 1000; ++i) map["key" + std::to_string(i)] = i;
+
+  CHECK(in_order(map, 0, 1000));
+  for (int i = 0; i < 1000; ++i) CHECK(map.find("key" + std::to_string(i))->second == i);
+  CHECK(map.find("key1000") == map.end());
+
+  // the index follows the entries moved by an erasure
+  for (int i = 0; i < 990; ++i) CHECK(map.erase("key" + std::to_string(i)) == 1);
+  CHECK(in_order(map, 990, 1000));
+  CHECK(map.contains("key995") && !map.contains("key5"));
+
+  map_t copy(map);
+  CHECK(copy == map && copy.find("key999")->second == 999);
+
+  map_t other;
+  for (int i = 0; i < 995; ++i) other["key" + std::to_string(i)] = i;
+  other.merge(map);
+  CHECK(in_order(other, 0, 1000));
+  CHECK(in_order(map, 990, 995));
+}
+
+TEST(OrderedMapInsertExisting)
+{
+  using text_map_t = ordered_map<std::string, std::string>;
+  const std::string text(64, 'x');
+
+  // the map is full, a copy of an entry is inserted as the storage grows
+  text_map_t map;
+  map.reserve(4);
+  for (int i = 0; i < 4; ++i) map.emplace("key" + std::to_string(i), text);
+
+  auto& first = *map.begin();
+  CHECK(map.emplace("copy", first.second).second);
+  CHECK(!map.insert(first).second);
+  CHECK(map.emplace(std::piecewise_construct,
+                    std::forward_as_tuple("piece"),
+                    std::forward_as_tuple(first.second))
+            .second);
+  map["assign"] = map["key1"];
+
+  CHECK(map.size() == 7);
+  CHECK(&first == &*map.begin());
+  for (auto& entry : map) CHECK(entry.second == text);
+}
@@ -1,9 +1,14 @@
+#include <cmath>
 #include <fstream>
 #include <filesystem>
+#include <sstream>
 
 #include "json_test.h"
 #include "custom_type.hpp"
 
+#include <formats/common/number.hpp>
+#include <formats/common/simd/simd.hpp>
+
 using namespace formats;
 
 TEST(JsonValueParseFromString)
@@ -55,6 +60,63 @@ TEST(JsonValueParseFromString)
   }
 }
 
+TEST(JsonValueParseFromStream)
+{
+  // tokens longer than the stream window, and more windows than the storage holds
+  {
+    std::string long_string(20000, 'x');
+
+    std::string s = "[";
+    for (int i = 0; i < 2000; ++i)
+      s += "{\"key\": \"value\", \"num\": " + std::to_string(i) + "}, ";
+    s += "\"" + long_string + "\"]";
+
+    std::istringstream is(s);
+    auto               jv = json::parse(is);
+
+    CHECK(jv.size() == 2001);
+    CHECK(jv[1999]["num"] == 1999);
+    CHECK(jv[2000] == long_string);
+    CHECK(jv == json::parse(s.data(), s.size()));
+  }
+
+  // a NUL byte is data, it does not end the input
+  {
+    const char  text[] = "[\"a\0b\", 1]";
+    std::string s(text, sizeof(text) - 1);
+
+    std::istringstream is(s);
+    auto               jv = json::parse(is);
+
+    CHECK(jv.size() == 2);
+    CHECK(jv[0].as_string() == std::string("a\0b", 3));
+  }
+
+  // long runs of white space and comments are dropped as they are read, the window keeps its size
+  {
+    const std::string run(1 << 20, ' ');
+    const std::string texts[] = {
+        "[1," + run + "2]",
+        "[1, //" + run + "\n 2]",
+        "[1, /*" + run + "*/ 2]",
+        "[1," + run + "/*" + run + "*/" + run + "2]",
+    };
+
+    for (auto& text : texts)
+    {
+      json::detail::parser parser;
+      json::error          error;
+      json::value          jv;
+
+      std::istringstream is(text);
+      parser.parse(is, jv, error, json::parse_flag::JSON5);
+
+      CHECK(jv == json::parse("[1, 2]"));
+      CHECK(parser.window().capacity() == json::detail::stream_window::default_capacity);
+    }
+  }
+}
+
 TEST(JsonValueParseFromFile)
 {
   std::string filepath = "";
@@ -70,6 +132,41 @@ TEST(JsonValueParseFromFile)
   json::dump(destfile, jv, json::stringify_style::pretty);
 }
 
+TEST(JsonValueParseFromMappedFile)
+{
+  auto filepath = (std::filesystem::temp_directory_path() / "formats-unit-load.json").string();
+
+  // a page sized file ends at a page boundary, a read past the mapping faults
+  std::string text = "[";
+  while (text.size() < 4096 - 8) text += "1,";
+  text += "12345]";
+  text.resize(4096, ' ');
+  {
+    std::ofstream os(filepath, std::ios::binary);
+    os << text;
+  }
+
+  json::value jv;
+  CHECK(json::load(filepath, jv));
+  CHECK(jv == json::parse(text.data(), text.size()));
+
+  // a truncated number is followed by the end of the mapping only
+  {
+    std::ofstream os(filepath, std::ios::binary);
+    os << "[0,\n" << std::string(4096 - 5, ' ') << "7";
+  }
+  CHECK(!json::load(filepath, jv));
+
+  // an empty file is read as a stream, which has no root
+  {
+    std::ofstream os(filepath, std::ios::binary);
+  }
+  CHECK(!json::load(filepath, jv));
+
+  std::filesystem::remove(filepath);
+  CHECK(!json::load(filepath, jv));
+}
+
 TEST(JsonValueParseFromJson5File)
 {
   std::string filepath = "";
@@ -83,4 +180,427 @@ TEST(JsonValueParseFromJson5File)
   }
 
   json::dump(destfile, jv, json::stringify_style::pretty);
-}
\ No newline at end of file
+}
+TEST(JsonValueParseWhiteSpace)
+{
+  const simd::isa sets[] = {simd::isa::scalar, simd::isa::sse2, simd::isa::avx2};
+
+  auto previous = simd::selected();
+
+  for (auto set : sets)
+  {
+    simd::select(set);
+
+    {
+      std::string s = "{\r\n  \"one\" : 1,\r\n\t\"two\":\n\n [1,   2]\f,\r\r "
+                      "\"three\": {\"four\" : 4}"
+                      "                                                                  }\r\n";
+
+      auto jv = json::parse(s.c_str(), s.size());
+
+      CHECK(jv.is_object());
+      CHECK(jv.size() == 3);
+      CHECK(jv["two"][1] == 2);
+      CHECK(jv["three"]["four"] == 4);
+    }
+
+    {
+      std::string s = "{\r\n  \"one\" : 1,\r\n\t\"two\":\n\n [1,   2]\r\r, x}";
+
+      json::error error;
+      json::parse(s.c_str(), s.size(), error);
+
+      CHECK(error.code() == json::error_code::missing_quotation_mark);
+      CHECK(std::string(error.what()).find("Line[7]") == 0);
+    }
+
+    // line counting must agree with a byte-at-a-time count, whatever the block boundaries are
+    unsigned int seed = 7;
+    for (int round = 0; round < 200; ++round)
+    {
+      const char spaces[] = {' ', '\t', '\n', '\r', '\f'};
+
+      std::string s;
+      int         lines = 1;
+
+      seed = seed * 1103515245 + 12345;
+      for (unsigned int i = 0, length = (seed >> 16) % 100; i < length; ++i)
+      {
+        seed = seed * 1103515245 + 12345;
+        s.push_back(spaces[(seed >> 16) % 5]);
+      }
+
+      for (size_t i = 0; i < s.size(); ++i)
+      {
+        if (s[i] == '\n' || (s[i] == '\r' && (i + 1 == s.size() || s[i + 1] != '\n'))) ++lines;
+      }
+
+      s.push_back('x');
+
+      json::error error;
+      json::parse(s.c_str(), s.size(), error);
+
+      CHECK(error.code() == json::error_code::missing_begin_object_array);
+      CHECK(std::string(error.what()).find("Line[" + std::to_string(lines) + "]") == 0);
+    }
+  }
+
+  simd::select(previous);
+}
+
+TEST(JsonValueParseTruncated)
+{
+  const char* docs[] = {"[1", "[1,", "{\"one\": 1", "{\"one\":", "\"one", "[\"one", "[1   \r"};
+
+  for (auto doc : docs)
+  {
+    json::error error;
+    auto        jv = json::parse(doc, error, json::parse_flag::JSON5);
+
+    CHECK(jv.is_error());
+    CHECK(error.code() != json::error_code::none);
+  }
+}
+
+TEST(JsonValueParseDepth)
+{
+  auto nested = [](size_t depth, const char* open, const char* close) {
+    std::string text;
+    for (size_t i = 0; i < depth; ++i) text += open;
+    text += "1";
+    for (size_t i = 0; i < depth; ++i) text += close;
+    return text;
+  };
+
+  // JSON_MAX_DEPTH containers, objects and arrays alike, one more is too deep
+  for (auto brackets : {std::make_pair("[", "]"), std::make_pair("{\"a\": ", "}")})
+  {
+    auto deepest = nested(JSON_MAX_DEPTH, brackets.first, brackets.second);
+    auto deeper  = nested(JSON_MAX_DEPTH + 1, brackets.first, brackets.second);
+
+    json::error error;
+    CHECK(!json::parse(deepest.data(), deepest.size(), error).is_error());
+    CHECK(!json::fast_parse(deepest.data(), deepest.size(), error).is_error());
+
+    CHECK(json::parse(deeper.data(), deeper.size(), error).is_error());
+    CHECK(error.code() == json::error_code::too_deep);
+    CHECK(json::fast_parse(deeper.data(), deeper.size(), error).is_error());
+    CHECK(error.code() == json::error_code::too_deep);
+  }
+}
+
+TEST(JsonValueParseFlagKernels)
+{
+  // strict and JSON5 have kernels of their own, the other flags the generic one
+  auto with = [](json::parse_flag flag, json::parse_flag other) {
+    return json::parse_flag((unsigned)flag | (unsigned)other);
+  };
+
+  const char* json5 = R"({
+    // comment
+    unquoted: 'single', trailing: [.5, 5., 0x1F, +Infinity, -Infinity,], "\x41": "\x41",
+  })";
+
+  auto jv = json::parse(json5, json::parse_flag::JSON5);
+  CHECK(jv.is_object() && jv.size() == 3);
+  CHECK(jv == json::parse(json5, with(json::parse_flag::JSON5, json::parse_flag::illegal_utf8)));
+
+  const char* strict = R"({"one": [1, -2.5e3, "two", true, false, null], "three": {}})";
+
+  jv = json::parse(strict, json::parse_flag::strict);
+  CHECK(jv.is_object() && jv.size() == 2);
+  CHECK(jv == json::parse(strict, json::parse_flag::JSON5));
+  CHECK(jv == json::parse(strict, with(json::parse_flag::strict, json::parse_flag::comments)));
+
+  // the generic kernel only takes the flags it is given
+  json::error error;
+  CHECK(json::parse("[1,]", json::parse_flag::array_trailing_comma).size() == 1);
+  CHECK(json::parse("[1,]", error, json::parse_flag::object_trailing_comma).is_error());
+  CHECK(json::parse("[1,]", error, json::parse_flag::strict).is_error());
+  CHECK(json::parse("[1,]", error, json::parse_flag::JSON5).size() == 1);
+}
+
+TEST(JsonValueParseString)
+{
+  const simd::isa sets[] = {simd::isa::scalar, simd::isa::sse2, simd::isa::avx2};
+
+  auto previous = simd::selected();
+
+  for (auto set : sets)
+  {
+    simd::select(set);
+
+    {
+      std::string url = "https://example.com/formats/json/parse/string/with/a/rather/long/path";
+      std::string s   = "[\"" + url + "\", \"" + url + "\\\"" + url + "\", ";
+      s.append("\"\xE4\xB8\xAD" + url + "\"]");
+
+      auto jv = json::parse(s.c_str(), s.size());
+
+      CHECK(jv.size() == 3);
+      CHECK(jv[0] == url);
+      CHECK(jv[1] == url + "\\\"" + url);
+      CHECK(jv[2] == "\xE4\xB8\xAD" + url);
+    }
+
+    {
+      std::string s = "['single quoted \"string\" with a long enough body']";
+
+      auto jv = json::parse(s.c_str(), s.size(), json::parse_flag::JSON5);
+      CHECK(jv[0] == "single quoted \"string\" with a long enough body");
+    }
+
+    {
+      const char* illegal[] = {"[\"a long string with an illegal byte \xFF in the middle\"]",
+                               "[\"a long string with a horizontal tab \t in the middle\"]",
+                               "[\"a long string with a line feed \n in the middle\"]",
+                               "[\"a long string which is never closed, the end is missing",
+                               "[\"an overlong solidus \xC0\xAF inside a long string body\"]",
+                               "[\"a surrogate \xED\xA0\x80 inside a long string body\"]",
+                               "[\"a truncated sequence \xE4\xB8\"]"};
+
+      for (auto doc : illegal)
+      {
+        CHECK(json::parse(doc).is_error());
+      }
+    }
+
+    {
+      std::string s = "[\"illegal utf8 \xFF\xFE is kept when the flag is set\"]";
+
+      auto jv = json::parse(s.c_str(), s.size(), json::parse_flag::illegal_utf8);
+      CHECK(jv[0] == "illegal utf8 \xFF\xFE is kept when the flag is set");
+    }
+  }
+
+  simd::select(previous);
+}
+
+TEST(JsonValueParseInteger)
+{
+  // runs of digits across the eight digits blocks and the overflow bounds
+  const char* uints[] = {"0",        "7",         "12345678",  "123456789",
+                         "99999999", "100000000", "1700000000123",
+                         "1234567890123456",      "9223372036854775807",
+                         "9223372036854775808",   "18446744073709551615"};
+
+  for (auto text : uints)
+  {
+    std::string doc = std::string("[") + text + ", -" + text + "]";
+    auto        jv  = json::parse(doc.c_str());
+
+    unsigned long long expected = std::stoull(text);
+    CHECK(jv[0].is_uint64() && jv[0].as_uint64() == expected);
+
+    if (expected <= 9223372036854775808ULL)
+      CHECK(jv[1].is_int64() && jv[1].as_int64() == (long long)(~expected + 1));
+    else
+      CHECK(jv[1].is_double() && jv[1].as_double() == -(double)expected);
+
+    formats::number num;
+    CHECK(num.parse(text, text + strlen(text)) && !num.is_fraction && num.integer == expected);
+  }
+
+  // past the bounds, a float
+  auto jv = json::parse("[18446744073709551616, -9223372036854775809, 123456789012345678901234]");
+  CHECK(jv[0].is_double() && jv[0].as_double() == 18446744073709551616.0);
+  CHECK(jv[1].is_double() && jv[1].as_double() == -9223372036854775809.0);
+  CHECK(jv[2].is_double() && jv[2].as_double() == 123456789012345678901234.0);
+
+  // a digit block ends at the first byte which is not a digit
+  jv = json::parse("[12345678.5, 1234567x, 123456781234567e2]", json::parse_flag::strict);
+  CHECK(jv.is_error());
+  jv = json::parse("[12345678.5, 123456781234567e2]");
+  CHECK(jv[0] == 12345678.5 && jv[1] == 12345678123456700.0);
+
+  // a digit block ends the text, no byte is read past it
+  for (std::string text : {"[12345678", "[-12345678", "[1234567812345678", "12345678",
+                           "-1234567812345678"})
+  {
+    std::unique_ptr<char[]> exact(new char[text.size()]);
+    memcpy(exact.get(), text.data(), text.size());
+
+    const char* begin = exact.get();
+    const char* end   = begin + text.size();
+
+    jv = json::parse(begin, end, json::parse_flag::root_lenient);
+    if (text[0] == '[')
+    {
+      CHECK(jv.is_error());
+      CHECK(json::fast_parse(begin, end).is_error());
+    }
+    else
+      CHECK(jv == std::stoll(text));
+  }
+}
+
+TEST(JsonValueParseFloat)
+{
+  // the nearest double, ties to even, as the literals of the compiler
+  const std::pair<const char*, double> floats[] = {
+    {"0.1", 0.1},
+    {"0.3", 0.3},
+    {"1e23", 1e23},
+    {"-0.0", -0.0},
+    {"9007199254740993.0", 9007199254740992.0},
+    {"9007199254740995.0", 9007199254740996.0},
+    {"7.2057594037927933e16", 7.2057594037927933e16},
+    {"2.2250738585072011e-308", 2.2250738585072011e-308},
+    {"2.2250738585072012e-308", 2.2250738585072012e-308},
+    {"4.9406564584124654e-324", 4.9406564584124654e-324},
+    {"2.4703282292062327e-324", 0.0},
+    {"2.4703282292062328e-324", 4.9406564584124654e-324},
+    {"1.7976931348623157e308", 1.7976931348623157e308},
+    {"1.7976931348623158e308", 1.7976931348623157e308},
+    {"1e-400", 0.0},
+    {"1e400", std::numeric_limits<double>::infinity()},
+    {"0.000000000000000000000000000000000000000000001e45", 1.0},
+    // more than 19 digits, the halfway between two doubles is decided by the dropped digits
+    {"9007199254740993.00000000000000000001", 9007199254740994.0},
+    {"9007199254740992.99999999999999999999", 9007199254740992.0},
+    {"2.225073858507201136057409796709131975934819546351645648e-308", 2.2250738585072011e-308},
+  };
+
+  for (auto& f : floats)
+  {
+    std::string doc = std::string("[") + f.first + "]";
+    auto        jv  = json::parse(doc.c_str());
+    CHECK(jv[0].is_double() && jv[0].as_double() == f.second);
+    CHECK(std::signbit(jv[0].as_double()) == std::signbit(f.second));
+
+    std::istringstream is(doc);
+    jv = json::parse(is);
+    CHECK(jv[0].is_double() && jv[0].as_double() == f.second);
+
+    formats::number num;
+    CHECK(num.parse(f.first, f.first + strlen(f.first)) && num.is_fraction);
+    CHECK((num.negative ? -num.fraction : num.fraction) == f.second);
+  }
+}
+
+TEST(JsonValueFastParse)
+{
+  const simd::isa sets[] = {simd::isa::scalar, simd::isa::sse2, simd::isa::avx2};
+
+  auto previous = simd::selected();
+
+  for (auto set : sets)
+  {
+    simd::select(set);
+
+    {
+      const char* docs[] = {
+          "{}",
+          "[]",
+          "\xEF\xBB\xBF[1, -2, 3.5, true, false, null]",
+          "{\"one\": 1, \"two\": [1, 2, {\"three\": \"four\"}], \"five\": {}}\r\n",
+          "[\"escaped \\\" quote\", \"back slashes \\\\\", \"\\\\\\\"\", \"\\u0041\\u4e2d\"]",
+          "{\"\xE4\xB8\xAD\xE6\x96\x87\": \"a string with {[:,]} inside\", \"n\": 18446744073709551615}",
+      };
+
+      for (auto doc : docs)
+      {
+        auto jv = json::fast_parse(doc);
+
+        CHECK(!jv.is_error());
+        CHECK(jv == json::parse(doc));
+      }
+    }
+
+    // runs of back slashes ending at every position of a block
+    for (size_t offset = 0; offset < 70; ++offset)
+    {
+      for (size_t slashes = 1; slashes < 5; ++slashes)
+      {
+        std::string body = std::string(offset, 'a') + std::string(slashes * 2, '\\');
+        std::string doc  = "[\"" + body + "\", \"" + body + "\\\"{\"]";
+
+        auto jv = json::fast_parse(doc.c_str(), doc.size());
+
+        CHECK(jv.size() == 2);
+        CHECK(jv[0] == body);
+        CHECK(jv[1] == body + "\\\"{");
+      }
+    }
+
+    {
+      const char* illegal[] = {" ",          "1",        "\"string\"",       "{} []",
+                               "[1 2]",      "[1,]",     "{\"a\":1,}",       "{\"a\" 1}",
+                               "{\"a\":}",     "{1: 2}",   "[truex]",          "[1.5.3]",
+                               "[\"a\"b]",     "[nul]",    "[\"never closed]", "{\"a\": [}",
+                               "[[]",        "[\"\\u00\"]", "[\"tab\tin\"]"};
+
+      for (auto doc : illegal)
+      {
+        CHECK(json::fast_parse(doc).is_error());
+      }
+    }
+
+    {
+      std::string s = "{\r\n  \"one\" : 1,\r\n\t\"two\":\n\n [1,   2]\r\r, x}";
+
+      json::error error;
+      json::fast_parse(s.c_str(), s.size(), error);
+
+      CHECK(error.code() == json::error_code::missing_quotation_mark);
+      CHECK(std::string(error.what()).find("Line[7]") == 0);
+    }
+  }
+
+  simd::select(previous);
+}
+
+TEST(JsonValueParallelParse)
+{
+  // elements of every kind, with separators and brackets inside strings
+  std::string doc = "\xEF\xBB\xBF [\n";
+  for (size_t i = 0; doc.size() < 3 * 1024 * 1024; ++i)
+  {
+    doc += "{\"id\": " + std::to_string(i) + ", \"text\": \"a, b ] } \\\" [ c\\\\\", ";
+    doc += "\"list\": [1.5, -2, true, null, [\"x\"]], \"empty\": {}},\n";
+    doc += "\"" + std::string(i % 70, '\\') + std::string(i % 2, '\\');
+    doc += "\", 18446744073709551615,\n";
+  }
+  doc += "[]]  ";
+
+  auto serial = json::parse(doc.data(), doc.size());
+  CHECK(serial.is_array());
+
+  for (size_t threads : {1, 2, 4})
+  {
+    json::error err;
+    auto        jv = json::parallel_parse(doc.data(), doc.size(), err, threads);
+
+    CHECK(jv == serial);
+    CHECK(err.code() == json::error_code::none);
+  }
+
+  // the error, with its line, is the one of parse()
+  const char* errors[] = {"{\"id\": 7 7}", "[}", "\"open", "1 2", ",", "01", "[[[", "]"};
+
+  for (auto bad : errors)
+  {
+    std::string broken = doc;
+    broken.replace(broken.size() / 2 + broken.substr(broken.size() / 2).find("[\"x\"]"), 5, bad);
+
+    json::error expected;
+    json::parse(broken.data(), broken.size(), expected);
+
+    json::error err;
+    CHECK(json::parallel_parse(broken.data(), broken.size(), err, 4).is_error());
+    CHECK(err.code() == expected.code() && err.code() != json::error_code::none);
+    CHECK(std::string(err.what()) == expected.what());
+  }
+
+  // a truncated root, an object root
+  {
+    json::error expected, err;
+    json::parse(doc.data(), doc.size() - 4, expected);
+
+    CHECK(json::parallel_parse(doc.data(), doc.size() - 4, err, 4).is_error());
+    CHECK(std::string(err.what()) == expected.what());
+
+    std::string object = "{\"root\": " + doc.substr(3) + "}";
+    CHECK(json::parallel_parse(object.data(), object.size(), 4)["root"] == serial);
+  }
+}
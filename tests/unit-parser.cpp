@@ -0,0 +1,106 @@
+#include <sstream>
+
+#include "json_test.h"
+
+using namespace formats;
+
+TEST(JsonParserReuse)
+{
+  json::parser parser;
+  json::value  jv;
+
+  CHECK(parser.parse(R"({"id": 1, "name": "a name too long for the sso", "tags": [1, 2, 3]})", jv));
+  CHECK(jv["name"] == "a name too long for the sso");
+
+  // a message of the same shape is parsed over the last one, in place
+  const auto* tags = &jv["tags"][0];
+  const auto* name = jv["name"].as_string().data();
+
+  CHECK(parser.parse(R"({"id": 2, "name": "another name, not longer", "tags": [4, 5]})", jv));
+  CHECK(jv == json::parse(R"({"id": 2, "name": "another name, not longer", "tags": [4, 5]})"));
+  CHECK(&jv["tags"][0] == tags);
+  CHECK(jv["name"].as_string().data() == name);
+
+  // the members and elements past the ones of the document are dropped, the kinds may change
+  CHECK(parser.parse(R"({"id": "three", "tags": {"a": [true]}, "more": null})", jv));
+  CHECK(jv == json::parse(R"({"id": "three", "tags": {"a": [true]}, "more": null})"));
+
+  CHECK(parser.parse("[1, [2], {}]", jv));
+  CHECK(jv == json::parse("[1, [2], {}]"));
+  CHECK(parser.parse("[]", jv));
+  CHECK(jv.is_array() && jv.empty());
+
+  // a duplicate key takes the last value
+  CHECK(parser.parse(R"({"a": [1], "a": "x"})", jv));
+  CHECK(jv.size() == 1 && jv["a"] == "x");
+  CHECK(parser.parse(R"({"a": [1], "a": "x"})", jv));
+  CHECK(jv.size() == 1 && jv["a"] == "x");
+
+  // an error leaves the error value, the next document is parsed again
+  CHECK(!parser.parse("[1, 2", jv));
+  CHECK(jv.is_error());
+  CHECK(parser.error().code() != json::error_code::none);
+  CHECK(parser.parse("[1, 2]", jv));
+  CHECK(parser.error().code() == json::error_code::none);
+  CHECK(jv.size() == 2);
+}
+
+TEST(JsonParserOptions)
+{
+  json::parser parser;
+  CHECK(parser.flag() == json::parse_flag::strict);
+  CHECK(parser.max_depth() == JSON_MAX_DEPTH);
+
+  CHECK(parser.parse("[1,]").is_error());
+
+  parser.flag(json::parse_flag::JSON5);
+  auto jv = parser.parse("{a: 'one', b: [0x10,],}");
+  CHECK(jv["a"] == "one" && jv["b"][0] == 16);
+
+  parser.max_depth(2);
+  CHECK(!parser.parse("[[1]]").is_error());
+  CHECK(parser.parse("[[[1]]]").is_error());
+  CHECK(parser.error().code() == json::error_code::too_deep);
+
+  // the window of a stream is kept for the next one
+  for (int i = 0; i < 3; ++i)
+  {
+    std::stringstream ss("{\"n\": " + std::to_string(i) + "}");
+
+    json::value v;
+    CHECK(parser.parse(ss, v));
+    CHECK(v["n"] == i);
+  }
+
+  std::string text = "[\"text\"]";
+  CHECK(parser.parse(text) == parser.parse(text.data(), text.size()));
+}
+
+TEST(JsonParserDeepValue)
+{
+  // a value is released in a loop, deeper than JSON_MAX_DEPTH needs no larger call stack
+  const std::size_t depth = 100000;
+
+  json::parser parser;
+  parser.max_depth(depth + 10);
+
+  {
+    json::value jv;
+    CHECK(parser.parse(std::string(depth, '[') + std::string(depth, ']'), jv));
+    CHECK(jv.is_array() && jv.size() == 1);
+
+    // parsed over a deep value, the containers past the document are dropped
+    CHECK(parser.parse("[[1, {\"a\": [2]}]]", jv));
+    CHECK(jv == json::parse("[[1, {\"a\": [2]}]]"));
+  }
+
+  std::string text;
+  for (std::size_t i = 0; i < depth / 2; ++i) text += "{\"a\": [";
+  text += "null";
+  for (std::size_t i = 0; i < depth / 2; ++i) text += "]}";
+
+  json::value jv = parser.parse(text);
+  CHECK(jv.is_object() && jv["a"].is_array());
+  jv = nullptr;
+  CHECK(jv.is_null());
+}
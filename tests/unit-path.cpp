@@ -0,0 +1,152 @@
+#include "json_test.h"
+
+using namespace formats;
+
+namespace
+{
+const char* store = R"({"store": {
+  "book": [
+    {"category": "reference", "author": "Nigel Rees", "title": "Sayings of the Century",
+     "price": 8.95},
+    {"category": "fiction", "author": "Evelyn Waugh", "title": "Sword of Honour",
+     "price": 12.99},
+    {"category": "fiction", "author": "Herman Melville", "title": "Moby Dick",
+     "isbn": "0-553-21311-3", "price": 8.99},
+    {"category": "fiction", "author": "J. R. R. Tolkien", "title": "The Lord of the Rings",
+     "isbn": "0-395-19395-8", "price": 22.99}
+  ],
+  "bicycle": {"color": "red", "price": 399}
+}})";
+
+/* @ret: the values selected by the query in jv, as an array */
+json::value query(const char* text, json::value& jv)
+{
+  json::value result(json::kind::array);
+  for (auto v : json::path::compile(text).select(jv)) result.push_back(*v);
+
+  return result;
+}
+
+/* @ret: an array of the value, json::value({v}) would be v itself */
+json::value one(json::value v)
+{
+  json::value result(json::kind::array);
+  result.push_back(std::move(v));
+
+  return result;
+}
+
+/* @ret: true if the text is not a jsonpath query */
+bool malformed(const char* text)
+{
+  try
+  {
+    json::path::compile(text);
+  }
+  catch (const formats::exception&)
+  {
+    return true;
+  }
+
+  return false;
+}
+}  // namespace
+
+TEST(JsonPathSelectors)
+{
+  auto jv = json::parse(store);
+
+  CHECK(query("$", jv).size() == 1);
+  CHECK(query("$.store.bicycle.color", jv) == one("red"));
+  CHECK(query("$['store']['bicycle']['price']", jv) == one(399));
+  CHECK(query("$.store.book[0].author", jv) == one("Nigel Rees"));
+  CHECK(query("$.store.book[-1].author", jv) == one("J. R. R. Tolkien"));
+  CHECK(query("$.store.book[4]", jv).empty());
+  CHECK(query("$.store.none", jv).empty());
+
+  CHECK(query("$.store.book[*].price", jv) == json::value({8.95, 12.99, 8.99, 22.99}));
+  CHECK(query("$.store.*", jv).size() == 2);
+  CHECK(query("$.store.book[0,2].price", jv) == json::value({8.95, 8.99}));
+  CHECK(query("$.store.book[0]['title','price']", jv) ==
+        json::value({"Sayings of the Century", 8.95}));
+
+  // slices
+  CHECK(query("$.store.book[1:3].price", jv) == json::value({12.99, 8.99}));
+  CHECK(query("$.store.book[:2].price", jv) == json::value({8.95, 12.99}));
+  CHECK(query("$.store.book[-2:].price", jv) == json::value({8.99, 22.99}));
+  CHECK(query("$.store.book[::2].price", jv) == json::value({8.95, 8.99}));
+  CHECK(query("$.store.book[::-1].price", jv) == json::value({22.99, 8.99, 12.99, 8.95}));
+  CHECK(query("$.store.book[5:0:-2].price", jv) == json::value({22.99, 12.99}));
+  CHECK(query("$.store.book[::0]", jv).empty());
+
+  // descendants
+  CHECK(query("$..author", jv).size() == 4);
+  CHECK(query("$.store..price", jv) == json::value({8.95, 12.99, 8.99, 22.99, 399}));
+  CHECK(query("$..book[2].author", jv) == one("Herman Melville"));
+  CHECK(query("$..*", jv).size() == 27);
+}
+
+TEST(JsonPathFilters)
+{
+  auto jv = json::parse(store);
+
+  CHECK(query("$..book[?(@.isbn)].title", jv) ==
+        json::value({"Moby Dick", "The Lord of the Rings"}));
+  CHECK(query("$..book[?(!@.isbn)].price", jv) == json::value({8.95, 12.99}));
+  CHECK(query("$..book[?(@.price < 10)].price", jv) == json::value({8.95, 8.99}));
+  CHECK(query("$..book[?@.price >= 12.99].price", jv) == json::value({12.99, 22.99}));
+  CHECK(query("$..book[?(@.category == 'reference')].author", jv) ==
+        one("Nigel Rees"));
+  CHECK(query("$..book[?(@.category != \"fiction\")].author", jv) ==
+        one("Nigel Rees"));
+  CHECK(query("$..book[?(@.price > 10 && @.price < 20)].price", jv) == one(12.99));
+  CHECK(query("$..book[?(@.price < 9 || !(@.category == 'fiction'))].price", jv) ==
+        json::value({8.95, 8.99}));
+  CHECK(query("$..book[?(@.price < $.store.bicycle.price)]", jv).size() == 4);
+  CHECK(query("$..book[?(@['author'] == $.store.book[1].author)].price", jv) ==
+        one(12.99));
+  CHECK(query("$.store[?(@.color)].price", jv) == one(399));
+
+  auto values = json::parse(R"([1, "1", true, null, [1], {"a": 1}])");
+  CHECK(query("$[?(@ == 1)]", values) == one(1));
+  CHECK(query("$[?(@ == '1')]", values) == one("1"));
+  CHECK(query("$[?(@ == true)]", values) == one(true));
+  CHECK(query("$[?(@ == null)]", values).size() == 1);
+  CHECK(query("$[?(@ > 0)]", values) == one(1));
+  CHECK(query("$[?(@[0] == 1)]", values).size() == 1);
+  CHECK(query("$[?(@.a)]", values).size() == 1);
+}
+
+TEST(JsonPathSelect)
+{
+  auto items = json::path::compile("$.items[?(@.price > 10)].id");
+  auto jv    = json::parse(R"({"items": [{"id": 1, "price": 5}, {"id": 2, "price": 15},
+                                       {"id": 3, "price": 25}]})");
+
+  // the values are in jv, not copies
+  auto selected = items.select(jv);
+  CHECK(selected.size() == 2);
+  CHECK(selected[0] == &jv["items"][1]["id"]);
+  CHECK(selected[1] == &jv["items"][2]["id"]);
+
+  *selected[0] = 20;
+  CHECK(jv["items"][1]["id"] == 20);
+
+  // a const value gives const pointers, and the values are appended
+  const json::value&             cjv = jv;
+  std::vector<const json::value*> result;
+  items.select(cjv, result);
+  items.select(cjv, result);
+  CHECK(result.size() == 4);
+  CHECK(*result[3] == 3);
+
+  CHECK(malformed(""));
+  CHECK(malformed("items"));
+  CHECK(malformed("$."));
+  CHECK(malformed("$.items["));
+  CHECK(malformed("$.items[a]"));
+  CHECK(malformed("$.items['id"));
+  CHECK(malformed("$.items[?(@.price > )]"));
+  CHECK(malformed("$.items[?(@.price > 10]"));
+  CHECK(malformed("$.items[?(10)]"));
+}
@@ -0,0 +1,82 @@
+#include "json_test.h"
+
+using namespace formats;
+
+namespace
+{
+/* @ret: true if the text is not a json pointer, or there is no value at it in jv */
+bool throws(const char* text, json::value& jv)
+{
+  try
+  {
+    json::pointer(text).at(jv);
+  }
+  catch (const formats::exception&)
+  {
+    return true;
+  }
+
+  return false;
+}
+}  // namespace
+
+TEST(JsonPointerRfc6901)
+{
+  // the example of rfc 6901, section 5, but for the keys with json escapes
+  auto jv = json::parse(R"({"foo": ["bar", "baz"], "": 0, "a/b": 1, "c%d": 2, "e^f": 3,
+                            "g|h": 4, " ": 7, "m~n": 8})");
+
+  CHECK(&json::pointer("").at(jv) == &jv);
+  CHECK(json::pointer("/foo").at(jv) == json::value({"bar", "baz"}));
+  CHECK(json::pointer("/foo/0").at(jv) == "bar");
+  CHECK(json::pointer("/").at(jv) == 0);
+  CHECK(json::pointer("/a~1b").at(jv) == 1);
+  CHECK(json::pointer("/c%d").at(jv) == 2);
+  CHECK(json::pointer("/e^f").at(jv) == 3);
+  CHECK(json::pointer("/g|h").at(jv) == 4);
+  CHECK(json::pointer("/ ").at(jv) == 7);
+  CHECK(json::pointer("/m~0n").at(jv) == 8);
+
+  CHECK(json::pointer("/a~1b/m~0n").to_string() == "/a~1b/m~0n");
+  CHECK(json::pointer("/foo/0").size() == 2);
+}
+
+TEST(JsonPointerFind)
+{
+  json::value jv = {{"items", {{{"id", 1}, {"tags", {"a", "b"}}}, {{"id", 2}}}}};
+  for (int i = 0; i < 20; ++i) jv["key" + std::to_string(i)] = i;
+
+  const json::pointer id("/items/1/id");
+  const json::pointer tag("/items/0/tags/1");
+  const json::pointer indexed("/key17");
+
+  CHECK(id.find(jv)->as_int64() == 2);
+  CHECK(tag.find(jv)->as_string() == "b");
+  CHECK(indexed.find(jv)->as_int64() == 17);
+
+  // a const value gives a const value
+  const auto& cjv = jv;
+  const auto* v   = id.find(cjv);
+  CHECK(v && *v == 2);
+
+  // the value is found through the pointer and changed
+  id.at(jv) = 3;
+  CHECK(jv["items"][1]["id"] == 3);
+
+  // no such value
+  CHECK(!json::pointer("/items/2").find(jv));
+  CHECK(!json::pointer("/items/-").find(jv));
+  CHECK(!json::pointer("/items/01").find(jv));
+  CHECK(!json::pointer("/items/0/id/x").find(jv));
+  CHECK(!json::pointer("/missing").find(jv));
+  CHECK(throws("/missing", jv));
+
+  // a number is a key in an object
+  jv["0"] = "zero";
+  CHECK(json::pointer("/0").at(jv) == "zero");
+
+  // malformed
+  CHECK(throws("items", jv));
+  CHECK(throws("/a~2", jv));
+  CHECK(throws("/a~", jv));
+}
@@ -0,0 +1,157 @@
+#include "json_test.h"
+
+using namespace formats;
+
+namespace
+{
+/* feeds the document in chunks of the given size */
+json::push_parser::status feed_by(json::push_parser& parser, const std::string& s, size_t chunk)
+{
+  auto status = json::push_parser::status::need_more;
+
+  for (size_t pos = 0; pos < s.size() && status == json::push_parser::status::need_more;
+       pos += chunk)
+    status = parser.feed(s.data() + pos, std::min(chunk, s.size() - pos));
+
+  return status;
+}
+
+/* counts the events */
+struct counter
+{
+  bool null() { return ++scalars, true; }
+  bool boolean(bool) { return ++scalars, true; }
+  bool number_int(long long) { return ++scalars, true; }
+  bool number_uint(unsigned long long) { return ++scalars, true; }
+  bool number_float(double) { return ++scalars, true; }
+  bool string(std::string&) { return ++scalars, true; }
+
+  bool start_object() { return ++containers, true; }
+  bool key(std::string&) { return ++keys, true; }
+  bool end_object() { return true; }
+  bool start_array() { return ++containers, true; }
+  bool end_array() { return true; }
+
+  int scalars    = 0;
+  int keys       = 0;
+  int containers = 0;
+};
+}  // namespace
+
+TEST(JsonPushParser)
+{
+  std::string s = "\xEF\xBB\xBF {\"name\": \"caf\xC3\xA9 \\\"\\u0041\\ud83d\\ude00\", \"list\": "
+                  "[1, -2, 3.25e2, 18446744073709551615, true, false, null, []],\r\n \"obj\": "
+                  "{\"k\\n\": {}}} \n";
+
+  json::value expected = json::parse(s.data(), s.data() + s.size());
+  CHECK(expected.is_object());
+
+  // every chunking gives the same value, tokens are cut anywhere
+  for (size_t chunk = 1; chunk <= s.size(); ++chunk)
+  {
+    json::push_parser parser;
+    CHECK(feed_by(parser, s, chunk) == json::push_parser::status::done);
+    CHECK(parser.finish() == json::push_parser::status::done);
+    CHECK(parser.result() == expected);
+  }
+
+  {
+    json::push_parser parser;
+    CHECK(parser.feed("[1, 2") == json::push_parser::status::need_more);
+    CHECK(parser.feed("3, \"ab") == json::push_parser::status::need_more);
+    CHECK(parser.feed("c\"]") == json::push_parser::status::done);
+    CHECK(parser.result()[1].as_uint64() == 23);
+    CHECK(parser.result()[2].as_string() == "abc");
+
+    // only white space after the root
+    CHECK(parser.feed("  \n") == json::push_parser::status::done);
+    CHECK(parser.feed(" 1") == json::push_parser::status::error);
+    CHECK(parser.last_error().code() == json::error_code::illeagl_character);
+
+    // the buffers are kept for the next document
+    parser.reset();
+    CHECK(parser.feed("{\"a\":null}") == json::push_parser::status::done);
+    CHECK(parser.result()["a"].is_null());
+  }
+
+  {
+    counter           handler;
+    json::push_parser parser(handler);
+
+    CHECK(feed_by(parser, s, 3) == json::push_parser::status::done);
+    CHECK(handler.scalars == 8);
+    CHECK(handler.keys == 4);
+    CHECK(handler.containers == 5);
+  }
+
+  {
+    struct illegal
+    {
+      const char*      text;
+      json::error_code code;
+    };
+
+    illegal docs[] = {
+        {"  1", json::error_code::missing_begin_object_array},
+        {"[1 2]", json::error_code::missing_end_array},
+        {"{\"a\" 1}", json::error_code::missing_name_separator},
+        {"[1,]", json::error_code::surplus_trailing_comma},
+        {"[tru]", json::error_code::expect_true},
+        {"[01]", json::error_code::leading_number_zero},
+        {"[\"\\q\"]", json::error_code::illeagl_escaped},
+        {"[\"\\u12x4\"]", json::error_code::illegal_unicode},
+        {"[\"\\ud83d\\u0041\"]", json::error_code::illegal_unicode},
+        {"[\"\xC3\"]", json::error_code::illegal_unicode},
+        {"[\"a\tb\"]", json::error_code::tab_in_string},
+    };
+
+    for (auto& doc : docs)
+    {
+      for (size_t chunk : {1, 2, 64})
+      {
+        json::push_parser parser;
+        CHECK(feed_by(parser, doc.text, chunk) == json::push_parser::status::error);
+        CHECK(parser.last_error().code() == doc.code);
+
+        json::error dom_error;
+        json::parse(doc.text, dom_error);
+        CHECK(dom_error.code() == doc.code);
+      }
+    }
+  }
+
+  {
+    // a truncated document fails at the end of input
+    const char* truncated[] = {"", "[", "{\"a\"", "[\"ab", "[12", "[nu", "[\"\\u00"};
+
+    for (auto doc : truncated)
+    {
+      json::push_parser parser;
+      CHECK(parser.feed(doc, strlen(doc)) == json::push_parser::status::need_more);
+      CHECK(parser.finish() == json::push_parser::status::error);
+      CHECK(parser.last_error().code() != json::error_code::none);
+    }
+  }
+
+  {
+    // the depth limit is kept by reset()
+    json::push_parser parser;
+    CHECK(parser.max_depth() == JSON_MAX_DEPTH);
+
+    parser.max_depth(2);
+    CHECK(parser.feed("[[1]]") == json::push_parser::status::done);
+
+    parser.reset();
+    CHECK(parser.feed("[[[1]]]") == json::push_parser::status::error);
+    CHECK(parser.last_error().code() == json::error_code::too_deep);
+
+    const std::size_t depth = 1000;
+    std::string       deep  = std::string(depth, '[') + std::string(depth, ']');
+
+    parser.reset();
+    parser.max_depth(depth);
+    CHECK(parser.feed(deep) == json::push_parser::status::done);
+    CHECK(parser.result().is_array());
+  }
+}
@@ -0,0 +1,132 @@
+#include "json_test.h"
+
+#include <vector>
+
+using namespace formats;
+
+namespace
+{
+/* records the events as text */
+class recorder : public json::sax
+{
+public:
+  bool null() override { return add("null"); }
+  bool boolean(bool val) override { return add(val ? "true" : "false"); }
+  bool number_int(long long val) override { return add("i" + std::to_string(val)); }
+  bool number_uint(unsigned long long val) override { return add("u" + std::to_string(val)); }
+  bool number_float(double val) override { return add("f" + std::to_string(val)); }
+  bool string(std::string& val) override { return add("s:" + val); }
+
+  bool start_object() override { return add("{"); }
+  bool key(std::string& val) override { return add("k:" + val); }
+  bool end_object() override { return add("}"); }
+  bool start_array() override { return add("["); }
+  bool end_array() override { return add("]"); }
+
+  bool add(const std::string& event)
+  {
+    events.push_back(event);
+    return events.size() < limit;
+  }
+
+  std::vector<std::string> events;
+  size_t                   limit = (size_t)-1;
+};
+
+/* picks the value of one key, without deriving from json::sax */
+struct picker
+{
+  bool null() { return true; }
+  bool boolean(bool) { return true; }
+  bool number_int(long long) { return true; }
+  bool number_uint(unsigned long long val)
+  {
+    if (depth == 1 && last_key == "id") id = val;
+    return true;
+  }
+  bool number_float(double) { return true; }
+  bool string(std::string&) { return true; }
+
+  bool start_object() { return ++depth, true; }
+  bool key(std::string& val) { return last_key = val, true; }
+  bool end_object() { return --depth, true; }
+  bool start_array() { return ++depth, true; }
+  bool end_array() { return --depth, true; }
+
+  int                depth = 0;
+  std::string        last_key;
+  unsigned long long id = 0;
+};
+}  // namespace
+
+TEST(JsonSaxParse)
+{
+  {
+    std::string s = "{\"a\": [1, -2, 3.5, true, false, null, \"str\"], \"b\": {}, \"c\": []}";
+
+    recorder handler;
+    CHECK(json::sax_parse(s.data(), s.data() + s.size(), handler));
+
+    std::vector<std::string> expected = {"{",  "k:a",   "[",    "u1", "i-2", "f3.500000",
+                                         "true", "false", "null", "s:str", "]", "k:b",
+                                         "{",  "}",     "k:c",  "[",  "]",   "}"};
+    CHECK(handler.events == expected);
+  }
+
+  {
+    std::string s = "{\"list\": [{\"id\": 7}], \"id\": 42, \"tail\": \"long string body\"}";
+
+    picker handler;
+    CHECK(json::sax_parse(s.data(), s.data() + s.size(), handler));
+    CHECK(handler.id == 42);
+    CHECK(handler.depth == 0);
+  }
+
+  {
+    // same grammar as parse, flags included
+    std::string s = "// comment\n{unquoted: 'single', trailing: [0x10, Infinity, NaN,],}";
+
+    recorder handler;
+    CHECK(json::sax_parse(s.data(), s.data() + s.size(), handler, json::parse_flag::JSON5));
+    CHECK(handler.events.size() == 10);
+    CHECK(handler.events[1] == "k:unquoted");
+    CHECK(handler.events[2] == "s:single");
+    CHECK(handler.events[5] == "u16");
+
+    json::error error;
+    CHECK(!json::sax_parse(s.data(), s.data() + s.size(), handler, error));
+    CHECK(error.code() != json::error_code::none);
+  }
+
+  {
+    const char* illegal[] = {"", "[1 2]", "{\"a\" 1}", "[1,]", "{\"a\": tru}", "[\"open"};
+
+    for (auto doc : illegal)
+    {
+      recorder    handler;
+      json::error error;
+
+      CHECK(!json::sax_parse(doc, doc + strlen(doc), handler, error));
+      CHECK(error.code() != json::error_code::none);
+
+      if (*doc)
+      {
+        json::error dom_error;
+        json::parse(doc, dom_error);
+        CHECK(error.code() == dom_error.code());
+      }
+    }
+  }
+
+  {
+    std::string s = "[1, 2, 3, 4]";
+
+    recorder handler;
+    handler.limit = 3;
+
+    json::error error;
+    CHECK(!json::sax_parse(s.data(), s.data() + s.size(), handler, error));
+    CHECK(error.code() == json::error_code::aborted);
+    CHECK(handler.events.size() == 3);
+  }
+}
@@ -4,8 +4,10 @@
 #include <set>
 #include <unordered_set>
 #include <forward_list>
+#include <list>
 // #include <string_view>
 #include <map>
+#include <unordered_map>
 
 #include "json_test.h"
 
@@ -389,3 +391,57 @@ TEST(JsonStaticReflection)
     CHECK(jv["age"] == 13);
   }
 }
+
+#ifdef FORMATS_HAS_MEMORY_RESOURCE
+TEST(JsonPmrConversion)
+{
+  std::pmr::monotonic_buffer_resource pool;
+
+  // the containers and the strings are converted on the resource
+  {
+    std::map<std::string, std::vector<std::string>> container = {
+        {"fruits", {"a string long enough to be allocated", "pear"}}, {"empty", {}}};
+
+    auto jv = json::to_json<json::pmr::value>(container, &pool);
+    CHECK(jv.get_allocator().resource() == &pool);
+    CHECK(jv["fruits"][0].as_string().get_allocator().resource() == &pool);
+    CHECK(jv["fruits"][1] == "pear");
+    CHECK(jv["empty"].is_array() && jv["empty"].empty());
+
+    std::map<std::string, std::vector<std::string>> result;
+    json::from_json(jv, result);
+    CHECK(result == container);
+
+    std::pmr::map<std::pmr::string, std::pmr::vector<std::pmr::string>> pmr_result(&pool);
+    json::from_json(jv, pmr_result);
+    CHECK(pmr_result.size() == 2 && pmr_result["fruits"][1] == "pear");
+    CHECK(json::to_json<json::pmr::value>(pmr_result, &pool) == jv);
+  }
+
+  // a custom type converts through a json::value
+  {
+    Student student;
+    student.age = 14;
+
+    auto jv = json::to_json<json::pmr::value>(student, &pool);
+    CHECK(jv["age"] == 14 && jv["height"] == 163.5);
+
+    Student copy;
+    jv["age"] = 15;
+    json::from_json(jv, copy);
+    CHECK(copy.age == 15);
+  }
+
+  // a value converts to and from another allocator
+  {
+    json::value jv = {{"name", "a string long enough to be allocated"}, {"list", {1, -2, 3.5}}};
+
+    json::pmr::value pv(jv, &pool);
+    CHECK(pv.get_allocator().resource() == &pool);
+    CHECK(pv["name"].as_string() == "a string long enough to be allocated");
+    CHECK(pv["list"][1] == -2 && pv["list"][2] == 3.5);
+    CHECK(json::value(pv) == jv);
+    CHECK(pv.dump().c_str() == jv.dump());
+  }
+}
+#endif  // FORMATS_HAS_MEMORY_RESOURCE
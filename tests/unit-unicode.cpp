@@ -0,0 +1,123 @@
+#include "json_test.h"
+
+#include <formats/common/simd/simd.hpp>
+#include <formats/common/unicode/unicode.hpp>
+
+using namespace formats;
+
+namespace
+{
+void append_code_point(std::string& s, uint32_t cp)
+{
+  if (cp < 0x80)
+  {
+    s.push_back((char)cp);
+  }
+  else if (cp < 0x800)
+  {
+    s.push_back((char)(0xC0 | (cp >> 6)));
+    s.push_back((char)(0x80 | (cp & 0x3F)));
+  }
+  else if (cp < 0x10000)
+  {
+    s.push_back((char)(0xE0 | (cp >> 12)));
+    s.push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+    s.push_back((char)(0x80 | (cp & 0x3F)));
+  }
+  else
+  {
+    s.push_back((char)(0xF0 | (cp >> 18)));
+    s.push_back((char)(0x80 | ((cp >> 12) & 0x3F)));
+    s.push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+    s.push_back((char)(0x80 | (cp & 0x3F)));
+  }
+}
+}  // namespace
+
+TEST(UnicodeValidateUtf8)
+{
+  const simd::isa sets[] = {simd::isa::scalar, simd::isa::sse2, simd::isa::avx2};
+
+  auto previous = simd::selected();
+
+  for (auto set : sets)
+  {
+    simd::select(set);
+
+    {
+      const char* legal[] = {"",
+                             "plain ascii",
+                             "\xC2\x80 \xDF\xBF \xE0\xA0\x80 \xEF\xBF\xBF",
+                             "\xED\x9F\xBF \xEE\x80\x80 \xF0\x90\x80\x80 \xF4\x8F\xBF\xBF",
+                             "\xE4\xB8\xAD\xE6\x96\x87 and ascii after"};
+
+      for (auto s : legal)
+      {
+        CHECK(unicode::validate_utf8(s, s + strlen(s)));
+      }
+    }
+
+    {
+      // stray continuations, overlong forms, surrogates, above U+10FFFF and truncated sequences
+      const char* illegal[] = {"\x80",         "\xBF",         "\xC0\x80",     "\xC1\xBF",
+                               "\xE0\x80\x80", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF",
+                               "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80",
+                               "\xF8\x88\x80\x80\x80", "\xFF", "\xC2", "\xE4\xB8", "\xF0\x90\x80",
+                               "\xC2\x41", "\xE4\x41\x80"};
+
+      // at every position of a block, and across the block boundaries
+      for (auto s : illegal)
+      {
+        for (size_t offset = 0; offset < 70; ++offset)
+        {
+          std::string head(offset, 'a');
+
+          std::string text = head + s + "tail";
+          CHECK(!unicode::validate_utf8(text));
+
+          text = head + s;
+          CHECK(!unicode::validate_utf8(text));
+        }
+      }
+    }
+
+    {
+      const uint32_t code_points[] = {0x24, 0xA2, 0x7FF, 0x800, 0x20AC, 0xD7FF, 0xE000, 0xFFFD,
+                                      0xFFFF, 0x10000, 0x1F600, 0x10FFFF};
+
+      for (size_t offset = 0; offset < 70; ++offset)
+      {
+        std::string text(offset, 'a');
+
+        for (auto cp : code_points)
+          append_code_point(text, cp);
+
+        CHECK(unicode::validate_utf8(text));
+
+        // dropping the last byte truncates the final four bytes sequence
+        text.pop_back();
+        CHECK(!unicode::validate_utf8(text));
+      }
+    }
+
+    {
+      // long mixed text. flipping a continuation byte into ascii must be caught anywhere
+      std::string text;
+      for (uint32_t cp = 0x20; cp < 0x3000; cp += 37)
+        append_code_point(text, cp);
+
+      CHECK(unicode::validate_utf8(text));
+
+      for (size_t i = 0; i < text.size(); ++i)
+      {
+        if (((unsigned char)text[i] & 0xC0) != 0x80) continue;
+
+        std::string broken = text;
+        broken[i]          = 'x';
+        CHECK(!unicode::validate_utf8(broken));
+      }
+    }
+  }
+
+  simd::select(previous);
+}